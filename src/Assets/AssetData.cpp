@@ -0,0 +1,77 @@
+// Generated by tools/gen_assets.py. Do not edit.
+#include "AssetData.h"
+
+const uint8_t ASSET_LOGO_RUNS[556] = {
+    0x00, 0x14, 0x99, 0x00, 0x6F, 0x90, 0x03, 0x00, 0x66, 0x90, 0x0B, 0x00, 0x60, 0x90, 0x0F, 0x00,
+    0x5C, 0x90, 0x13, 0x00, 0x58, 0x90, 0x17, 0x00, 0x54, 0x90, 0x1B, 0x00, 0x51, 0x90, 0x1D, 0x00,
+    0x4E, 0x90, 0x21, 0x00, 0x4B, 0x90, 0x23, 0x00, 0x49, 0x90, 0x25, 0x00, 0x39, 0xC1, 0x0D, 0x90,
+    0x27, 0x00, 0x38, 0xC1, 0x0C, 0x90, 0x29, 0x00, 0x36, 0xC2, 0x0B, 0x90, 0x2B, 0x00, 0x34, 0xC3,
+    0x0A, 0x90, 0x2D, 0x00, 0x33, 0xC3, 0x09, 0x90, 0x2F, 0x00, 0x31, 0xC4, 0x08, 0x90, 0x31, 0x00,
+    0x2F, 0xC5, 0x08, 0x90, 0x31, 0x00, 0x2F, 0xC5, 0x07, 0x90, 0x33, 0x00, 0x2D, 0xC6, 0x06, 0x90,
+    0x35, 0x00, 0x2B, 0xC7, 0x06, 0x90, 0x35, 0x00, 0x13, 0xA1, 0x00, 0x07, 0xC7, 0x05, 0x90, 0x37,
+    0x00, 0x11, 0xA2, 0x00, 0x06, 0xC8, 0x05, 0x90, 0x37, 0x00, 0x10, 0xA3, 0x00, 0x05, 0xC9, 0x04,
+    0x90, 0x39, 0x00, 0x0E, 0xA4, 0x00, 0x05, 0xC9, 0x04, 0x90, 0x39, 0x00, 0x0D, 0xA5, 0x00, 0x04,
+    0xCA, 0x03, 0x90, 0x3B, 0x00, 0x0B, 0xA6, 0x00, 0x03, 0xCB, 0x03, 0x90, 0x3B, 0x00, 0x0A, 0xA7,
+    0x00, 0x03, 0xCB, 0x02, 0x90, 0x3D, 0x00, 0x08, 0xA8, 0x00, 0x02, 0xCC, 0x02, 0x90, 0x3D, 0x00,
+    0x07, 0xA9, 0x00, 0x01, 0xCD, 0x02, 0x90, 0x3D, 0x00, 0x06, 0xAA, 0x00, 0x01, 0xCD, 0x02, 0x90,
+    0x3D, 0x00, 0x05, 0xAB, 0x00, 0x00, 0xCE, 0x01, 0x90, 0x3F, 0x00, 0x03, 0xAC, 0x0F, 0xCF, 0x01,
+    0x90, 0x3F, 0x00, 0x02, 0xAD, 0x0F, 0xCF, 0x01, 0x90, 0x3F, 0x00, 0x01, 0xAE, 0x0E, 0xC0, 0x00,
+    0x01, 0x90, 0x3F, 0x00, 0x00, 0xAF, 0x0D, 0xC0, 0x01, 0x01, 0x90, 0x3F, 0x0F, 0xA0, 0x00, 0x0D,
+    0xC0, 0x01, 0x90, 0x41, 0x0D, 0xA0, 0x01, 0x0C, 0xC0, 0x02, 0x90, 0x41, 0x0C, 0xA0, 0x02, 0x0B,
+    0xC0, 0x03, 0x90, 0x41, 0x0B, 0xA0, 0x03, 0x0B, 0xC0, 0x03, 0x90, 0x41, 0x0A, 0xA0, 0x04, 0x0A,
+    0xC0, 0x04, 0x90, 0x41, 0x09, 0xA0, 0x05, 0x09, 0xC0, 0x05, 0x90, 0x41, 0x0A, 0xA0, 0x04, 0x09,
+    0xC0, 0x05, 0x90, 0x41, 0x0B, 0xA0, 0x03, 0x0A, 0xC0, 0x04, 0x90, 0x41, 0x0C, 0xA0, 0x02, 0x0B,
+    0xC0, 0x03, 0x90, 0x41, 0x0D, 0xA0, 0x01, 0x0B, 0xC0, 0x03, 0x01, 0x90, 0x3F, 0x0F, 0xA0, 0x00,
+    0x0C, 0xC0, 0x02, 0x01, 0x90, 0x3F, 0x00, 0x00, 0xAF, 0x0D, 0xC0, 0x01, 0x01, 0x90, 0x3F, 0x00,
+    0x01, 0xAE, 0x0D, 0xC0, 0x01, 0x01, 0x90, 0x3F, 0x00, 0x02, 0xAD, 0x0E, 0xC0, 0x00, 0x01, 0x90,
+    0x3F, 0x00, 0x03, 0xAC, 0x0F, 0xCF, 0x02, 0x90, 0x3D, 0x00, 0x05, 0xAB, 0x0F, 0xCF, 0x02, 0x90,
+    0x3D, 0x00, 0x06, 0xAA, 0x00, 0x00, 0xCE, 0x02, 0x90, 0x3D, 0x00, 0x07, 0xA9, 0x00, 0x01, 0xCD,
+    0x02, 0x90, 0x3D, 0x00, 0x08, 0xA8, 0x00, 0x01, 0xCD, 0x03, 0x90, 0x3B, 0x00, 0x0A, 0xA7, 0x00,
+    0x02, 0xCC, 0x03, 0x90, 0x3B, 0x00, 0x0B, 0xA6, 0x00, 0x03, 0xCB, 0x04, 0x90, 0x39, 0x00, 0x0D,
+    0xA5, 0x00, 0x03, 0xCB, 0x04, 0x90, 0x39, 0x00, 0x0E, 0xA4, 0x00, 0x04, 0xCA, 0x05, 0x90, 0x37,
+    0x00, 0x10, 0xA3, 0x00, 0x05, 0xC9, 0x05, 0x90, 0x37, 0x00, 0x11, 0xA2, 0x00, 0x05, 0xC9, 0x06,
+    0x90, 0x35, 0x00, 0x13, 0xA1, 0x00, 0x06, 0xC8, 0x06, 0x90, 0x35, 0x00, 0x2B, 0xC7, 0x07, 0x90,
+    0x33, 0x00, 0x2C, 0xC7, 0x08, 0x90, 0x31, 0x00, 0x2E, 0xC6, 0x08, 0x90, 0x31, 0x00, 0x2F, 0xC5,
+    0x09, 0x90, 0x2F, 0x00, 0x30, 0xC5, 0x0A, 0x90, 0x2D, 0x00, 0x32, 0xC4, 0x0B, 0x90, 0x2B, 0x00,
+    0x34, 0xC3, 0x0C, 0x90, 0x29, 0x00, 0x35, 0xC3, 0x0D, 0x90, 0x27, 0x00, 0x37, 0xC2, 0x0E, 0x90,
+    0x25, 0x00, 0x39, 0xC1, 0x0F, 0x90, 0x23, 0x00, 0x4B, 0x90, 0x21, 0x00, 0x4E, 0x90, 0x1D, 0x00,
+    0x51, 0x90, 0x1B, 0x00, 0x54, 0x90, 0x17, 0x00, 0x58, 0x90, 0x13, 0x00, 0x5C, 0x90, 0x0F, 0x00,
+    0x60, 0x90, 0x0B, 0x00, 0x66, 0x90, 0x03, 0x00, 0x6F, 0x99, 0x00, 0x50,
+};
+
+const uint8_t ASSET_MENU_BUTTON_RUNS[66] = {
+    0x04, 0x70, 0xD8, 0x07, 0x70, 0xDA, 0x05, 0x70, 0xDC, 0x03, 0x70, 0xDE, 0x01, 0x70, 0xFF, 0x70,
+    0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70,
+    0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70, 0xFF, 0x70,
+    0xFF, 0x70, 0xFF, 0x70, 0x73, 0x01, 0x70, 0xDE, 0x03, 0x70, 0xDC, 0x05, 0x70, 0xDA, 0x07, 0x70,
+    0xD8, 0x04,
+};
+
+const uint8_t ASSET_SETTINGS_BUTTON_RUNS[66] = {
+    0x04, 0x50, 0xD8, 0x07, 0x50, 0xDA, 0x05, 0x50, 0xDC, 0x03, 0x50, 0xDE, 0x01, 0x50, 0xFF, 0x50,
+    0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50,
+    0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50, 0xFF, 0x50,
+    0xFF, 0x50, 0xFF, 0x50, 0x73, 0x01, 0x50, 0xDE, 0x03, 0x50, 0xDC, 0x05, 0x50, 0xDA, 0x07, 0x50,
+    0xD8, 0x04,
+};
+
+const uint8_t ASSET_KEY_LEFT_RUNS[103] = {
+    0x04, 0x50, 0x79, 0x07, 0x50, 0x7B, 0x05, 0x5A, 0xA0, 0x0A, 0x50, 0x59, 0x03, 0x5A, 0xA0, 0x0C,
+    0x50, 0x59, 0x01, 0x5A, 0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63,
+    0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63,
+    0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63,
+    0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63, 0xA0, 0x0E, 0x50, 0x63,
+    0xA0, 0x0E, 0x50, 0x59, 0x01, 0x5A, 0xA0, 0x0C, 0x50, 0x59, 0x03, 0x5A, 0xA0, 0x0A, 0x50, 0x59,
+    0x05, 0x50, 0x7B, 0x07, 0x50, 0x79, 0x04,
+};
+
+const uint8_t ASSET_KEY_RIGHT_RUNS[125] = {
+    0x09, 0x50, 0x6F, 0x00, 0x00, 0x50, 0x73, 0x0C, 0x5C, 0xB0, 0x0A, 0x50, 0x51, 0x09, 0x5B, 0xB0,
+    0x0E, 0x50, 0x50, 0x07, 0x5B, 0xB0, 0x10, 0x50, 0x50, 0x05, 0x5B, 0xB0, 0x12, 0x50, 0x50, 0x04,
+    0x5A, 0xB0, 0x14, 0x50, 0x4F, 0x03, 0x5A, 0xB0, 0x16, 0x50, 0x4F, 0x02, 0x5A, 0xB0, 0x16, 0x50,
+    0x4F, 0x01, 0x5A, 0xB0, 0x18, 0x50, 0x59, 0xB0, 0x18, 0x50, 0x59, 0xB0, 0x18, 0x50, 0x59, 0xB0,
+    0x18, 0x50, 0x59, 0xB0, 0x18, 0x50, 0x59, 0xB0, 0x18, 0x50, 0x4F, 0x01, 0x5A, 0xB0, 0x16, 0x50,
+    0x4F, 0x02, 0x5A, 0xB0, 0x16, 0x50, 0x4F, 0x03, 0x5A, 0xB0, 0x14, 0x50, 0x4F, 0x04, 0x5B, 0xB0,
+    0x12, 0x50, 0x50, 0x05, 0x5B, 0xB0, 0x10, 0x50, 0x50, 0x07, 0x5B, 0xB0, 0x0E, 0x50, 0x50, 0x09,
+    0x5C, 0xB0, 0x0A, 0x50, 0x51, 0x0C, 0x50, 0x73, 0x00, 0x00, 0x50, 0x6F, 0x09,
+};
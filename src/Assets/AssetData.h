@@ -0,0 +1,28 @@
+// Generated by tools/gen_assets.py from the shapes listed there. Do not edit.
+#pragma once
+#ifndef ASSET_DATA_H
+#define ASSET_DATA_H
+
+#include "../Theme/PaletteSprite.h"
+
+// 141x81, 556 bytes (5711 at 4 bpp)
+extern const uint8_t ASSET_LOGO_RUNS[556];
+constexpr PaletteImage ASSET_LOGO = { 141, 81, ASSET_LOGO_RUNS, 556 };
+
+// 240x30, 66 bytes (3600 at 4 bpp)
+extern const uint8_t ASSET_MENU_BUTTON_RUNS[66];
+constexpr PaletteImage ASSET_MENU_BUTTON = { 240, 30, ASSET_MENU_BUTTON_RUNS, 66 };
+
+// 240x30, 66 bytes (3600 at 4 bpp)
+extern const uint8_t ASSET_SETTINGS_BUTTON_RUNS[66];
+constexpr PaletteImage ASSET_SETTINGS_BUTTON = { 240, 30, ASSET_SETTINGS_BUTTON_RUNS, 66 };
+
+// 145x24, 103 bytes (1740 at 4 bpp)
+extern const uint8_t ASSET_KEY_LEFT_RUNS[103];
+constexpr PaletteImage ASSET_KEY_LEFT = { 145, 24, ASSET_KEY_LEFT_RUNS, 103 };
+
+// 145x24, 125 bytes (1740 at 4 bpp)
+extern const uint8_t ASSET_KEY_RIGHT_RUNS[125];
+constexpr PaletteImage ASSET_KEY_RIGHT = { 145, 24, ASSET_KEY_RIGHT_RUNS, 125 };
+
+#endif // ASSET_DATA_H
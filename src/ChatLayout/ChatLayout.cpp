@@ -0,0 +1,115 @@
+#include "ChatLayout.h"
+#include "../TextCodec/TextCodec.h"
+#include "../SmoothFont/SmoothFont.h"
+
+TFT_eSPI* ChatLayout::tft = nullptr;
+uint8_t ChatLayout::advances[ChatLayout::MAX_FONTS][95] = {{0}};
+uint8_t ChatLayout::fallback[ChatLayout::MAX_FONTS] = {0};
+
+void ChatLayout::begin(TFT_eSPI* _tft) {
+    tft = _tft;
+    memset(advances, 0, sizeof(advances));
+    memset(fallback, 0, sizeof(fallback));
+}
+
+// ================== GLYPH ADVANCES ==================
+uint8_t ChatLayout::advance(uint32_t codepoint, byte font) {
+    if (font == FONT_SMOOTH) return SmoothFont::advance(codepoint);  // Read from the font itself
+    if (font >= MAX_FONTS || !tft) return 0;
+
+    if (codepoint >= 32 && codepoint <= 126) {
+        uint8_t& a = advances[font][codepoint - 32];
+        if (a == 0) {
+            char glyph[2] = { (char) codepoint, 0 };
+            a = (uint8_t) tft->textWidth(glyph, font);
+            if (a == 0) a = 1;  // Keep 0 meaning "not measured"
+        }
+        return a;
+    }
+
+    // Built-in fonts carry ASCII only: assume the width of '?' so we never overflow
+    if (fallback[font] == 0) fallback[font] = advance('?', font);
+    return fallback[font];
+}
+
+byte ChatLayout::decodeUtf8(const char* text, size_t len, size_t i, uint32_t& codepoint) {
+    uint8_t c = (uint8_t) text[i];
+    byte n = 1;
+    if (c >= 0xF0)      { n = 4; codepoint = c & 0x07; }
+    else if (c >= 0xE0) { n = 3; codepoint = c & 0x0F; }
+    else if (c >= 0xC0) { n = 2; codepoint = c & 0x1F; }
+    else                { codepoint = c; return 1; }
+
+    // Truncated or malformed sequence: treat the lead byte on its own
+    if (i + n > len) { codepoint = c; return 1; }
+    for (byte k = 1; k < n; ++k) {
+        uint8_t cc = (uint8_t) text[i + k];
+        if ((cc & 0xC0) != 0x80) { codepoint = c; return 1; }
+        codepoint = (codepoint << 6) | (cc & 0x3F);
+    }
+    return n;
+}
+
+int ChatLayout::textWidth(const char* text, size_t len, byte font) {
+    int w = 0;
+    uint32_t cp;
+    for (size_t i = 0; i < len; ) {
+        i += decodeUtf8(text, len, i, cp);
+        w += advance(cp, font);
+    }
+    return w;
+}
+
+// ================== WRAPPING ==================
+void ChatLayout::wrap(const char* text, size_t len, byte font, int width, int indent,
+                      std::vector<uint16_t>& line_breaks) {
+    line_breaks.clear();
+
+    size_t line_start = 0;
+    int available = width - indent;
+    int line_width = 0;
+    size_t last_break = 0;      // Offset just after the last space on this line
+    int width_at_break = 0;     // line_width up to last_break
+
+    uint32_t cp;
+    for (size_t i = 0; i < len; ) {
+        byte n = decodeUtf8(text, len, i, cp);
+        int a = advance(cp, font);
+
+        // Trailing spaces may hang past the edge; anything else wraps
+        while (cp != ' ' && line_width + a > available && i > line_start) {
+            if (last_break > line_start) {
+                // Break after the last space; carry the partial word over
+                line_start = last_break;
+                line_width -= width_at_break;
+            } else {
+                // Single token longer than the line: split before this glyph
+                line_start = i;
+                line_width = 0;
+            }
+            line_breaks.push_back((uint16_t) line_start);
+            last_break = line_start;
+            width_at_break = 0;
+            available = width;
+        }
+
+        line_width += a;
+        i += n;
+        if (cp == ' ') {
+            last_break = i;
+            width_at_break = line_width;
+        }
+    }
+}
+
+byte ChatLayout::layoutMessage(Message* msg, byte font, int width, int indent) {
+    if (msg->layout_font != font || msg->layout_width != width || msg->layout_indent != indent) {
+        size_t len;
+        const char* text = TextCodec::view(msg->message, len);
+        wrap(text, len, font, width, indent, msg->line_breaks);
+        msg->layout_font = font;
+        msg->layout_width = (uint16_t) width;
+        msg->layout_indent = (uint16_t) indent;
+    }
+    return (byte) min<size_t>(msg->line_breaks.size() + 1, 255);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef CHAT_LAYOUT_H
+#define CHAT_LAYOUT_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <vector>
+#include "../global_objects.h"
+
+// ================== ChatLayout ===================
+// Word-wrapping layout for chat message bodies.
+// Glyph advances are measured once per font with textWidth() and cached, so
+// wrapping a body costs one table lookup per glyph. Line breaks are stored on
+// the Message and only recomputed when the font, width or first-line indent
+// (sender prefix) changes.
+class ChatLayout {
+public:
+    static const byte MAX_FONTS = 9;          // TFT_eSPI built-in font numbers 0..8 (FONT_SMOOTH = 9)
+
+    // Set the TFT used to measure glyphs (call once after tft.init())
+    static void begin(TFT_eSPI* tft);
+
+    // Pixel advance of one code point in a built-in font
+    static uint8_t advance(uint32_t codepoint, byte font);
+
+    // Pixel width of a UTF-8 string using the cached advances
+    static int textWidth(const char* text, size_t len, byte font);
+
+    // Word-wrap text into 'width' pixels; the first line starts after 'indent'
+    // pixels. Fills byte offsets of every line after the first.
+    // Breaks after spaces; tokens longer than a line are split between code
+    // points. Multi-byte UTF-8 sequences are never split.
+    static void wrap(const char* text, size_t len, byte font, int width, int indent,
+                     std::vector<uint16_t>& line_breaks);
+
+    // Make sure msg's cached layout matches font/width/indent; returns line count
+    static byte layoutMessage(Message* msg, byte font, int width, int indent);
+
+    // Decode one UTF-8 code point at text[i]; returns its byte length (>= 1)
+    static byte decodeUtf8(const char* text, size_t len, size_t i, uint32_t& codepoint);
+
+private:
+    static TFT_eSPI* tft;
+    static uint8_t advances[MAX_FONTS][95];  // ASCII 32..126, 0 = not yet measured
+    static uint8_t fallback[MAX_FONTS];      // Advance used for non-ASCII code points
+};
+
+#endif // CHAT_LAYOUT_H
@@ -3,6 +3,10 @@
 #define DEBUG_MACROS_H
 
 #include <Arduino.h>
+#include "SerialTxHandler/SerialTxHandler.h"
+
+// Log lines share the TX ring with packets to the LoRa MCU, so they are only
+// ever sent whole and never split a queued packet line
 
 // Debug level configuration
 // Uncomment to disable specific debug levels
@@ -14,25 +18,25 @@
 #ifdef DISABLE_DBG
   #define DBG(x)
 #else
-  #define DBG(x)   Serial.println("[DBG]  " + String(x))
+  #define DBG(x)   SerialTxHandler::enqueueLine("[DBG]  " + String(x))
 #endif
 
 #ifdef DISABLE_INFO
   #define INFO(x)
 #else
-  #define INFO(x)  Serial.println("[INFO] " + String(x))
+  #define INFO(x)  SerialTxHandler::enqueueLine("[INFO] " + String(x))
 #endif
 
 #ifdef DISABLE_WARN
   #define WARN(x)
 #else
-  #define WARN(x)  Serial.println("[WARN] " + String(x))
+  #define WARN(x)  SerialTxHandler::enqueueLine("[WARN] " + String(x))
 #endif
 
 #ifdef DISABLE_ERR
   #define ERR(x)
 #else
-  #define ERR(x)   Serial.println("[ERR]  " + String(x))
+  #define ERR(x)   SerialTxHandler::enqueueLine("[ERR]  " + String(x))
 #endif
 
 #endif // DEBUG_MACROS_H
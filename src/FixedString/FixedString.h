@@ -0,0 +1,91 @@
+#pragma once
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <Arduino.h>
+#include <string.h>
+
+// ================== FixedString ===================
+// Inline, fixed-capacity string for IDs and names: N bytes of storage
+// (N - 1 characters), no heap, and an FNV-1a hash computed once on
+// assignment so equality checks reject on the hash before touching bytes.
+// Overlong input is truncated on a UTF-8 character boundary.
+//
+// Converts implicitly from const char* / String (parse and input
+// boundaries); converting back to String is explicit via toString().
+template <uint8_t N>
+class FixedString {
+public:
+    static const uint8_t CAPACITY = N - 1;
+
+    FixedString() : len(0), hashv(EMPTY_HASH) { buf[0] = 0; }
+    FixedString(const char* s) { assign(s, s ? strlen(s) : 0); }
+    FixedString(const String& s) { assign(s.c_str(), s.length()); }
+
+    template <uint8_t M>
+    FixedString(const FixedString<M>& other) {
+        if (M <= N) {
+            // Fits as-is: reuse the source hash
+            memcpy(buf, other.c_str(), other.length() + 1);
+            len = other.length();
+            hashv = other.hash();
+        } else {
+            assign(other.c_str(), other.length());
+        }
+    }
+
+    FixedString& operator=(const char* s) { assign(s, s ? strlen(s) : 0); return *this; }
+    FixedString& operator=(const String& s) { assign(s.c_str(), s.length()); return *this; }
+
+    void assign(const char* s, size_t n) {
+        if (n > CAPACITY) {
+            n = CAPACITY;
+            // Don't leave half a UTF-8 sequence at the end
+            while (n > 0 && ((uint8_t) s[n] & 0xC0) == 0x80) n--;
+        }
+        if (n) memcpy(buf, s, n);
+        buf[n] = 0;
+        len = n;
+        hashv = hashOf(buf, n);
+    }
+
+    const char* c_str() const { return buf; }
+    uint8_t length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    uint32_t hash() const { return hashv; }
+    char operator[](size_t i) const { return i < len ? buf[i] : 0; }
+
+    // Allocates; only for display / serial formatting
+    String toString() const { return String(buf); }
+
+    // Hash first, then length, then bytes
+    template <uint8_t M>
+    bool operator==(const FixedString<M>& o) const {
+        return hashv == o.hash() && len == o.length() && memcmp(buf, o.c_str(), len) == 0;
+    }
+    template <uint8_t M>
+    bool operator!=(const FixedString<M>& o) const { return !(*this == o); }
+
+    bool equals(const char* s, size_t n) const {
+        return n == len && memcmp(buf, s, n) == 0;
+    }
+
+    // FNV-1a 32-bit, same function used for file names and telemetry tags
+    static uint32_t hashOf(const char* s, size_t n) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < n; ++i) h = (h ^ (uint8_t) s[i]) * 16777619u;
+        return h;
+    }
+
+private:
+    static const uint32_t EMPTY_HASH = 2166136261u;
+
+    char buf[N];
+    uint8_t len;
+    uint32_t hashv;
+};
+
+typedef FixedString<24> IdString;    // User, channel and message IDs
+typedef FixedString<32> NameString;  // Usernames and channel names
+
+#endif // FIXED_STRING_H
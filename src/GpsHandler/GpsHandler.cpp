@@ -0,0 +1,114 @@
+#include "GpsHandler.h"
+#include "../global_objects.h"
+#include "../MessageId/MessageId.h"
+#include "../DebugMacros.h"
+
+NmeaParser GpsHandler::parser;
+unsigned long GpsHandler::fix_ms = 0;
+unsigned long GpsHandler::sync_count = 0;
+unsigned long GpsHandler::last_sync_ms = 0;
+int32_t GpsHandler::last_step = 0;
+
+volatile uint32_t GpsHandler::pps_count = 0;
+volatile unsigned long GpsHandler::pps_us = 0;
+volatile unsigned long GpsHandler::pps_ms = 0;
+
+bool GpsHandler::armed = false;
+uint32_t GpsHandler::armed_epoch = 0;
+uint32_t GpsHandler::armed_count = 0;
+
+bool GpsHandler::hasFix() {
+    return fix_ms && parser.fix().valid && millis() - fix_ms < FIX_TIMEOUT_MS;
+}
+
+bool GpsHandler::ppsActive() {
+    return pps_count && millis() - pps_ms < 2000;
+}
+
+#ifdef GPS_RX
+
+// ================== SETUP ==================
+void GpsHandler::begin() {
+    Serial2.setRxBufferSize(512);
+    Serial2.begin(BAUD, SERIAL_8N1, GPS_RX, -1);  // Receive only
+#ifdef GPS_PPS
+    pinMode(GPS_PPS, INPUT);
+    attachInterrupt(digitalPinToInterrupt(GPS_PPS), onPps, RISING);
+#endif
+}
+
+void IRAM_ATTR GpsHandler::onPps() {
+    pps_us = micros();
+    pps_ms = millis();
+    pps_count++;
+}
+
+// ================== INGEST ==================
+void GpsHandler::update() {
+    servicePps();
+
+    int available = Serial2.available();
+    if (available <= 0) return;
+
+    uint8_t buf[CHUNK];
+    size_t n = Serial2.readBytes(buf, min((size_t) available, CHUNK));
+    for (size_t i = 0; i < n; ++i) {
+        if (parser.feed(buf[i]) == NMEA_RMC) onRmc();
+    }
+}
+
+void GpsHandler::onRmc() {
+    const GpsFix& f = parser.fix();
+    if (!f.valid || !f.epoch) return;
+    fix_ms = millis();
+
+    if (ppsActive()) {
+        // f.epoch began at the last edge; write epoch + 1 on the next one
+        if (armed || !syncDue(PPS_SYNC_MS)) return;
+        if (millis() - pps_ms >= 1000) return;  // Edge missing for this second
+        armed = true;
+        armed_epoch = f.epoch + 1;
+        armed_count = pps_count;
+        return;
+    }
+
+    if (!syncDue(CHECK_MS)) return;
+    last_sync_ms = millis();
+    int32_t step = (int32_t) (f.epoch - rtc.now().unixtime());
+    if (step != 0) setRtc(f.epoch);
+}
+
+void GpsHandler::servicePps() {
+    if (!armed || pps_count == armed_count) return;
+    armed = false;
+
+    // Only the first edge after arming, and only while it is fresh
+    noInterrupts();
+    uint32_t count = pps_count;
+    unsigned long edge_us = pps_us;
+    interrupts();
+    if (count != armed_count + 1 || micros() - edge_us > PPS_LATE_US) return;
+
+    setRtc(armed_epoch);
+}
+
+// ================== RTC ==================
+bool GpsHandler::syncDue(unsigned long interval) {
+    return last_sync_ms == 0 || millis() - last_sync_ms >= interval;
+}
+
+void GpsHandler::setRtc(uint32_t epoch) {
+    last_step = (int32_t) (epoch - rtc.now().unixtime());
+    rtc.adjust(DateTime(epoch));
+    MessageId::begin(epoch);
+    last_sync_ms = millis();
+    sync_count++;
+    if (last_step != 0) INFO("RTC stepped " + String(last_step) + " s to GPS time");
+}
+
+#else  // No GPS wired
+
+void GpsHandler::begin() {}
+void GpsHandler::update() {}
+
+#endif // GPS_RX
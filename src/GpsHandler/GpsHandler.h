@@ -0,0 +1,72 @@
+#pragma once
+#ifndef GPS_HANDLER_H
+#define GPS_HANDLER_H
+
+#include <Arduino.h>
+#include "Nmea.h"
+
+// ================== GpsHandler ===================
+// NEO-6M on Serial2 (GPS_RX, optional GPS_PPS). Without GPS_RX the module
+// compiles to no-ops.
+//
+// update() drains the UART in CHUNK-byte reads straight into NmeaParser;
+// RMC/GGA fill the fix record, everything else is skipped at its tag.
+//
+// Time discipline: a valid RMC carries the UTC second that started at the
+// last PPS edge. With PPS, the RTC is written at the *next* edge with that
+// second + 1, which also restarts the DS3231's internal second, so the RTC
+// lands within a few ms of GPS time; this repeats every PPS_SYNC_MS. Without
+// PPS the RTC is compared with RMC time every CHECK_MS and stepped when the
+// whole seconds differ (sentence latency leaves it up to ~0.5 s behind).
+// MessageId is re-anchored after every write.
+class GpsHandler {
+public:
+    static constexpr unsigned long BAUD = 9600;               // NEO-6M default
+    static constexpr size_t CHUNK = 64;                       // Bytes per read
+    static constexpr unsigned long CHECK_MS = 60000;          // No PPS: compare interval
+    static constexpr unsigned long PPS_SYNC_MS = 600000;      // PPS: re-align interval
+    static constexpr unsigned long PPS_LATE_US = 20000;       // Edge too old to write on
+    static constexpr unsigned long FIX_TIMEOUT_MS = 5000;     // Fix older than this is stale
+
+    static void begin();
+
+    // Parse pending bytes; write the RTC when due (call in loop)
+    static void update();
+
+    static const GpsFix& fix() { return parser.fix(); }
+    // Valid RMC fix received within FIX_TIMEOUT_MS
+    static bool hasFix();
+    // PPS edge seen within the last two seconds
+    static bool ppsActive();
+
+    // RTC writes since boot, and the step (seconds) of the last one
+    static unsigned long syncs() { return sync_count; }
+    static int32_t lastStep() { return last_step; }
+
+    static const NmeaParser& nmea() { return parser; }
+
+private:
+    static NmeaParser parser;
+    static unsigned long fix_ms;            // millis() of the last valid RMC
+    static unsigned long sync_count;
+    static unsigned long last_sync_ms;      // Last RTC write or check (0 = none yet)
+    static int32_t last_step;
+
+    // PPS edge bookkeeping (ISR)
+    static volatile uint32_t pps_count;
+    static volatile unsigned long pps_us;
+    static volatile unsigned long pps_ms;
+
+    // Epoch to write at the edge after pps_count == armed_count
+    static bool armed;
+    static uint32_t armed_epoch;
+    static uint32_t armed_count;
+
+    static void IRAM_ATTR onPps();
+    static void onRmc();
+    static void servicePps();
+    static bool syncDue(unsigned long interval);
+    static void setRtc(uint32_t epoch);
+};
+
+#endif // GPS_HANDLER_H
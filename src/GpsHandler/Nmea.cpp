@@ -0,0 +1,211 @@
+#include "Nmea.h"
+
+static const uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+static const uint8_t MAX_FRAC = 7;      // Enough for 1e-7 degree minutes
+static const uint8_t NO_COORD = 0xFF;
+
+static int8_t hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+NmeaParser::NmeaParser()
+    : current(), staged(), state(IDLE), type(NMEA_NONE), field(0), length(0),
+      sum(0), given(0), tag(), tag_len(0), mantissa(0), frac_digits(0),
+      in_frac(false), negative(false), empty(true), first(0), coord(0),
+      coord_field(NO_COORD), rmc_time(UINT32_MAX), rmc_date(0),
+      accepted(0), bad_checksum(0), malformed(0) {}
+
+// ================== BYTE STREAM ==================
+uint8_t NmeaParser::feed(char c) {
+    switch (state) {
+        case IDLE:
+            if (c == '$') begin();
+            return NMEA_NONE;
+
+        case BODY:
+            if (c == '$' || c == '\r' || c == '\n' || ++length > MAX_LINE) {
+                // Cut short, no checksum, or runaway line
+                malformed++;
+                state = IDLE;
+                if (c == '$') begin();
+                return NMEA_NONE;
+            }
+            if (c == '*') {
+                endField();
+                if (state == BODY) state = SUM_HI;
+                return NMEA_NONE;
+            }
+            sum ^= (uint8_t) c;
+            if (c == ',') {
+                endField();
+                if (state == IDLE) return NMEA_NONE;  // Tag we don't parse
+                field++;
+                startField();
+                return NMEA_NONE;
+            }
+
+            if (field == 0) {
+                tag[0] = tag[1];
+                tag[1] = tag[2];
+                tag[2] = c;
+                tag_len++;
+                return NMEA_NONE;
+            }
+
+            if (empty) {
+                empty = false;
+                first = c;
+            }
+            if (c >= '0' && c <= '9') {
+                if (!in_frac) {
+                    mantissa = mantissa * 10 + (c - '0');
+                } else if (frac_digits < MAX_FRAC) {
+                    mantissa = mantissa * 10 + (c - '0');
+                    frac_digits++;
+                }
+            } else if (c == '.') {
+                in_frac = true;
+            } else if (c == '-') {
+                negative = true;
+            }
+            return NMEA_NONE;
+
+        case SUM_HI: {
+            int8_t v = hexValue(c);
+            if (v < 0) break;
+            given = v << 4;
+            state = SUM_LO;
+            return NMEA_NONE;
+        }
+
+        case SUM_LO: {
+            int8_t v = hexValue(c);
+            if (v < 0) break;
+            state = IDLE;
+            if ((given | v) != sum) {
+                bad_checksum++;
+                return NMEA_NONE;
+            }
+            finish();
+            return type;
+        }
+    }
+
+    malformed++;
+    state = IDLE;
+    return NMEA_NONE;
+}
+
+void NmeaParser::begin() {
+    staged = current;
+    state = BODY;
+    type = NMEA_NONE;
+    field = 0;
+    length = 1;
+    sum = 0;
+    tag_len = 0;
+    coord_field = NO_COORD;
+    rmc_time = UINT32_MAX;
+    rmc_date = 0;
+    startField();
+}
+
+void NmeaParser::startField() {
+    mantissa = 0;
+    frac_digits = 0;
+    in_frac = false;
+    negative = false;
+    empty = true;
+    first = 0;
+}
+
+// ================== FIELDS ==================
+void NmeaParser::endField() {
+    if (field == 0) {
+        if (tag_len >= 3 && tag[0] == 'R' && tag[1] == 'M' && tag[2] == 'C') {
+            // Status and time come from this sentence alone: an empty status
+            // or an unparseable date must not inherit the last fix's
+            type = NMEA_RMC;
+            staged.valid = false;
+            staged.epoch = 0;
+        } else if (tag_len >= 3 && tag[0] == 'G' && tag[1] == 'G' && tag[2] == 'A') type = NMEA_GGA;
+        else state = IDLE;  // Skip the rest of the sentence
+        return;
+    }
+
+    // Field numbers of latitude / longitude and what follows them
+    uint8_t lat = type == NMEA_RMC ? 3 : 2;
+    uint8_t lon = lat + 2;
+
+    if (field == lat || field == lon) {
+        coord_field = empty ? NO_COORD : field;
+        if (!empty) coord = coordinate();
+        return;
+    }
+    if (field == lat + 1 || field == lon + 1) {
+        // Hemisphere: applies only if the value before it was present
+        if (coord_field != field - 1) return;
+        int32_t v = (first == 'S' || first == 'W') ? -coord : coord;
+        if (field == lat + 1) staged.lat_e7 = v;
+        else                  staged.lon_e7 = v;
+        return;
+    }
+    if (empty) return;
+
+    if (type == NMEA_RMC) {
+        switch (field) {
+            case 1: rmc_time = fixed(0); break;
+            case 2: staged.valid = first == 'A'; break;
+            // Knots * 100 to cm/s
+            case 7: staged.speed_cms = (uint32_t) fixed(2) * 5144 / 10000; break;
+            case 8: staged.course_cdeg = fixed(2); break;
+            case 9: rmc_date = fixed(0); break;
+        }
+    } else {
+        switch (field) {
+            case 6: staged.quality = fixed(0); break;
+            case 7: staged.satellites = fixed(0); break;
+            case 8: staged.hdop_x10 = fixed(1); break;
+            case 9: staged.alt_dm = fixed(1); break;
+        }
+    }
+}
+
+void NmeaParser::finish() {
+    if (type == NMEA_RMC && staged.valid && rmc_date && rmc_time != UINT32_MAX) {
+        uint32_t d = rmc_date / 10000, m = rmc_date / 100 % 100, y = rmc_date % 100;
+        uint32_t hh = rmc_time / 10000, mm = rmc_time / 100 % 100, ss = rmc_time % 100;
+        if (d >= 1 && d <= 31 && m >= 1 && m <= 12 && hh < 24 && mm < 60 && ss < 61) {
+            staged.epoch = (uint32_t) daysFromCivil(2000 + y, m, d) * 86400 + hh * 3600 + mm * 60 + ss;
+        }
+    }
+    current = staged;
+    accepted++;
+}
+
+int32_t NmeaParser::fixed(uint8_t decimals) const {
+    uint64_t v = mantissa;
+    if (frac_digits > decimals) v /= POW10[frac_digits - decimals];
+    else                        v *= POW10[decimals - frac_digits];
+    return negative ? -(int32_t) v : (int32_t) v;
+}
+
+int32_t NmeaParser::coordinate() const {
+    uint64_t scale = POW10[frac_digits];
+    uint64_t degrees = mantissa / scale / 100;
+    uint64_t minutes = mantissa - degrees * 100 * scale;  // Minutes * scale
+    return (int32_t) (degrees * 10000000 + minutes * 10000000 / (60 * scale));
+}
+
+// ================== CALENDAR ==================
+int32_t NmeaParser::daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+    y -= m <= 2;
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yoe = (uint32_t) (y - era * 400);
+    uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t) doe - 719468;
+}
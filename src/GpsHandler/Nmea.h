@@ -0,0 +1,105 @@
+#pragma once
+#ifndef NMEA_H
+#define NMEA_H
+
+#include <stdint.h>
+
+// Plain C++ (no Arduino dependencies), so recorded NMEA logs can be pushed
+// through NmeaParser on the host.
+
+// ----- GpsFix -----
+// Latest position and time, as reported by the receiver. Fields an update
+// leaves empty keep their previous value.
+struct GpsFix {
+    int32_t lat_e7;        // Degrees * 1e7, north positive
+    int32_t lon_e7;        // Degrees * 1e7, east positive
+    int32_t alt_dm;        // Metres * 10 above mean sea level (GGA)
+    uint16_t speed_cms;    // Ground speed, cm/s (RMC)
+    uint16_t course_cdeg;  // Track, degrees * 100 (RMC)
+    uint16_t hdop_x10;     // (GGA)
+    uint8_t quality;       // GGA fix quality, 0 = no fix
+    uint8_t satellites;    // (GGA)
+    bool valid;            // RMC status 'A'
+    uint32_t epoch;        // UTC of the last RMC if valid (Unix seconds), 0 = none
+};
+
+// ================== SENTENCES ==================
+const uint8_t NMEA_NONE = 0;
+const uint8_t NMEA_RMC  = 1;
+const uint8_t NMEA_GGA  = 2;
+
+// ================== NmeaParser ===================
+// Byte-at-a-time NMEA 0183 reader for RMC and GGA from any talker (GP, GN,
+// ...). Nothing is buffered: each field is folded into an integer
+// accumulator as its digits arrive and stored into a staging copy of the fix
+// at the comma, while the XOR checksum runs alongside. The staging copy
+// replaces the fix only when the checksum matches, so a corrupted sentence
+// never leaves half its fields behind. Other sentences are skipped at the
+// tag, and lines longer than the NMEA limit are dropped.
+class NmeaParser {
+public:
+    static const uint8_t MAX_LINE = 82;   // NMEA 0183 limit, '$' to '\n'
+
+    NmeaParser();
+
+    // Feed one byte; returns NMEA_RMC / NMEA_GGA when such a sentence
+    // completed with a valid checksum, else NMEA_NONE
+    uint8_t feed(char c);
+
+    const GpsFix& fix() const { return current; }
+
+    // Counters since construction
+    uint32_t sentences() const { return accepted; }
+    uint32_t checksumErrors() const { return bad_checksum; }
+    uint32_t dropped() const { return malformed; }
+
+    // Days since 1970-01-01 of a civil date (proleptic Gregorian)
+    static int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d);
+
+private:
+    enum State : uint8_t { IDLE, BODY, SUM_HI, SUM_LO };
+
+    GpsFix current;
+    GpsFix staged;
+
+    State state;
+    uint8_t type;          // Sentence being parsed (NMEA_NONE = skip)
+    uint8_t field;
+    uint8_t length;
+    uint8_t sum;
+    uint8_t given;
+    char tag[3];           // Last three tag characters ("RMC")
+    uint8_t tag_len;
+
+    // Current field
+    uint64_t mantissa;     // All digits, decimal point ignored
+    uint8_t frac_digits;   // Digits after the point (capped)
+    bool in_frac;
+    bool negative;
+    bool empty;
+    char first;            // First character (single-letter fields)
+
+    // Unsigned coordinate waiting for its hemisphere field
+    int32_t coord;
+    uint8_t coord_field;   // Field it came from
+
+    // RMC time of day and date, combined once both are in
+    uint32_t rmc_time;     // hhmmss
+    uint32_t rmc_date;     // ddmmyy
+
+    uint32_t accepted;
+    uint32_t bad_checksum;
+    uint32_t malformed;
+
+    void begin();
+    void startField();
+    void endField();
+    void finish();
+
+    // Field as a fixed-point value with 'decimals' places
+    int32_t fixed(uint8_t decimals) const;
+    // ddmm.mmmm / dddmm.mmmm field as degrees * 1e7
+    int32_t coordinate() const;
+};
+
+#endif // NMEA_H
@@ -0,0 +1,467 @@
+#include "HistoryStore.h"
+#include "../DebugMacros.h"
+#include "../SearchIndex/SearchIndex.h"
+#include "../TextCodec/TextCodec.h"
+#include <LittleFS.h>
+
+static_assert(sizeof(HistoryRecord) == 256, "HistoryRecord must stay 256 bytes");
+static_assert(HistoryStore::MAX_RECORDS <= STORED_KEYS, "every stored record needs a key hash slot");
+
+bool HistoryStore::mounted = false;
+PoolHandle HistoryStore::open_channel;
+HistoryStore::FrontHook HistoryStore::front_hook = nullptr;
+HistoryRecord HistoryStore::page[HistoryStore::PAGE_SIZE];
+PoolHandle HistoryStore::pending_channel;
+bool HistoryStore::pending_front = false;
+unsigned long HistoryStore::pages_loaded = 0;
+bool HistoryStore::batching = false;
+PoolHandle HistoryStore::append_channel;
+
+// Open append handle while batching (kept here so the header needs no FS types)
+static File append_file;
+
+// ================== HELPERS ==================
+static void copyField(char* dst, size_t size, const char* src, size_t len) {
+    size_t n = min(len, size - 1);
+    memcpy(dst, src, n);
+    dst[n] = 0;
+}
+
+String HistoryStore::pathFor(const Channel* channel) {
+    // The ID's hash gives any channel ID a short, valid file name
+    char path[16];
+    snprintf(path, sizeof(path), "/h/%08lx", (unsigned long) channel->ID.hash());
+    return String(path);
+}
+
+Message* HistoryStore::toMessage(const Channel* channel, const HistoryRecord& r) {
+    Message* msg = createMessage(channel->ID, r.message_id, r.sender_id, r.text, r.time_stamp,
+                                 r.rssi, r.snr, r.latency);
+    if (msg) msg->latency_set = r.flags & 0x01;
+    return msg;
+}
+
+void HistoryStore::toRecord(const Message* msg, HistoryRecord& r) {
+    toRecord(msg->message_id, msg->sender_id, msg->message, msg->time_stamp, r);
+    r.rssi = msg->rssi;
+    r.snr = msg->snr;
+    r.latency = msg->latency;
+    r.flags = msg->latency_set ? 0x01 : 0;
+}
+
+void HistoryStore::toRecord(const IdString& msg_id, const IdString& sender, const String& body,
+                            const String& ts, HistoryRecord& r) {
+    memset(&r, 0, sizeof(r));
+    copyField(r.message_id, sizeof(r.message_id), msg_id.c_str(), msg_id.length());
+    copyField(r.sender_id, sizeof(r.sender_id), sender.c_str(), sender.length());
+    copyField(r.time_stamp, sizeof(r.time_stamp), ts.c_str(), ts.length());
+    copyField(r.text, sizeof(r.text), body.c_str(), body.length());
+}
+
+// Read up to count records starting at first into the page buffer
+size_t HistoryStore::readRecords(Channel* channel, uint32_t first, size_t count) {
+    if (!mounted) return 0;
+    closeAppend();
+    File f = LittleFS.open(pathFor(channel), "r");
+    if (!f) return 0;
+    count = min(count, (size_t) PAGE_SIZE);
+    f.seek(first * RECORD_SIZE);
+    size_t got = f.read((uint8_t*) page, count * RECORD_SIZE) / RECORD_SIZE;
+    f.close();
+    return got;
+}
+
+// ================== SETUP ==================
+void HistoryStore::begin() {
+    mounted = LittleFS.begin(true);  // format on first use
+    if (!mounted) {
+        ERR("History storage unavailable, keeping messages in RAM only");
+        return;
+    }
+    if (!LittleFS.exists("/h")) LittleFS.mkdir("/h");
+
+    // loadTail() also rebuilds each channel's key hashes: a backlog replayed
+    // after a reboot repeats messages that are only on flash
+    for (Channel* ch : all_channels) {
+        if (ch) loadTail(ch);
+    }
+}
+
+void HistoryStore::loadTail(Channel* channel) {
+    if (!mounted || !channel) return;
+    closeAppend();
+    compact(channel);
+
+    File f = LittleFS.open(pathFor(channel), "r");
+    channel->history_count = f ? f.size() / RECORD_SIZE : 0;
+    if (f) f.close();
+    if (channel->key_count < min(channel->history_count, (uint32_t) STORED_KEYS)) rebuildKeys(channel);
+
+    clearWindow(channel);
+    uint32_t want = min((uint32_t) RESIDENT, channel->history_count);
+    want = min(want, (uint32_t) message_pool.available());
+    fillWindow(channel, channel->history_count - want, want);
+}
+
+void HistoryStore::loadAround(Channel* channel, uint32_t index) {
+    if (!mounted || !channel || index >= channel->history_count) return;
+
+    clearWindow(channel);
+    uint32_t want = min((uint32_t) RESIDENT, channel->history_count);
+    want = min(want, (uint32_t) message_pool.available());
+    uint32_t first = index > want / 2 ? index - want / 2 : 0;
+    first = min(first, channel->history_count - want);
+    fillWindow(channel, first, want);
+}
+
+// Window = records [first, first + count), in page-sized reads through the shared buffer
+void HistoryStore::fillWindow(Channel* channel, uint32_t first, uint32_t count) {
+    channel->history_first = first;
+    uint32_t next = first;
+    while (next < first + count) {
+        size_t got = readRecords(channel, next, first + count - next);
+        if (got == 0) break;
+        for (size_t i = 0; i < got; ++i) {
+            Message* msg = toMessage(channel, page[i]);
+            channel->addMessage(msg);
+            all_messages.push_back(msg);
+        }
+        next += got;
+    }
+    if (front_hook) front_hook(channel, 0);
+}
+
+bool HistoryStore::readRecord(Channel* channel, uint32_t index, HistoryRecord& r) {
+    if (!channel) return false;
+    const std::vector<Message*>& msgs = channel->channel_messages;
+    if (index >= channel->history_first && index - channel->history_first < msgs.size()) {
+        Message* msg = msgs[index - channel->history_first];
+        if (!msg) return false;
+        toRecord(msg, r);
+        return true;
+    }
+
+    if (!mounted || index >= channel->history_count) return false;
+    closeAppend();
+    File f = LittleFS.open(pathFor(channel), "r");
+    if (!f) return false;
+    f.seek(index * RECORD_SIZE);
+    bool ok = f.read((uint8_t*) &r, sizeof(r)) == sizeof(r);
+    f.close();
+    return ok;
+}
+
+void HistoryStore::scan(Channel* channel, uint32_t first, RecordFn fn, uint32_t end) {
+    end = min(end, channel->history_count);
+    uint32_t next = first;
+    while (next < end) {
+        size_t got = readRecords(channel, next, end - next);
+        if (got == 0) break;
+        for (size_t i = 0; i < got; ++i) fn(channel, next + i, page[i]);
+        next += got;
+    }
+}
+
+// Keep the newest MAX_RECORDS / 2 once a file reaches MAX_RECORDS. Returns
+// how many records were dropped from the front; every index shifts by that.
+uint32_t HistoryStore::compact(Channel* channel) {
+    String path = pathFor(channel);
+    File f = LittleFS.open(path, "r");
+    if (!f) return 0;
+    uint32_t total = f.size() / RECORD_SIZE;
+    if (total < MAX_RECORDS) {
+        f.close();
+        return 0;
+    }
+
+    String tmpPath = path + ".t";
+    File out = LittleFS.open(tmpPath, "w");
+    if (!out) {
+        f.close();
+        return 0;
+    }
+    f.seek((total - MAX_RECORDS / 2) * RECORD_SIZE);
+    size_t got;
+    while ((got = f.read((uint8_t*) page, sizeof(page))) > 0) {
+        out.write((const uint8_t*) page, got);
+    }
+    f.close();
+    out.close();
+
+    LittleFS.remove(path);
+    LittleFS.rename(tmpPath, path);
+    uint32_t dropped = total - MAX_RECORDS / 2;
+    SearchIndex::shift(channel, dropped);
+    channel->key_base += dropped;
+    channel->key_count = min((uint32_t) channel->key_count, total - dropped);
+    INFO("Compacted channel history " + path);
+    return dropped;
+}
+
+// Move the window down after compact() dropped records from the front.
+// Residents older than the new first record go; the rest keep their slots.
+void HistoryStore::shiftWindow(Channel* channel, uint32_t dropped) {
+    if (channel->history_first < dropped) {
+        dropFront(channel, dropped - channel->history_first);
+        if (channel->history_first < dropped) channel->history_first = dropped;
+    }
+    channel->history_first -= dropped;
+    channel->history_count -= min(dropped, channel->history_count);
+}
+
+// ================== DEDUP ==================
+static inline uint16_t keyHash(uint64_t key) {
+    return (uint16_t) (key ^ (key >> 16) ^ (key >> 32) ^ (key >> 48));
+}
+
+void HistoryStore::rememberKey(Channel* channel, uint32_t index, uint64_t key) {
+    channel->key_hashes[(index + channel->key_base) % STORED_KEYS] = keyHash(key);
+    if (channel->key_count < STORED_KEYS) channel->key_count++;
+}
+
+void HistoryStore::onKeyRecord(Channel* channel, uint32_t index, const HistoryRecord& r) {
+    rememberKey(channel, index, MessageId::keyOf(IdString(r.message_id)));
+}
+
+// Every stored record, oldest first, so key_count ends at the newest ones
+void HistoryStore::rebuildKeys(Channel* channel) {
+    channel->key_count = 0;
+    uint32_t first = channel->history_count > STORED_KEYS ? channel->history_count - STORED_KEYS : 0;
+    scan(channel, first, onKeyRecord);
+}
+
+bool HistoryStore::seen(Channel* channel, uint64_t key) {
+    uint16_t h = keyHash(key);
+    for (uint32_t i = 1; i <= channel->key_count && i <= channel->history_count; ++i) {
+        uint32_t index = channel->history_count - i;  // Newest first
+        if (channel->key_hashes[(index + channel->key_base) % STORED_KEYS] != h) continue;
+
+        // About one lookup in 128 meets another key's hash; the record decides.
+        // One that can't be read (RAM only, not resident) counts as new.
+        static HistoryRecord r;
+        if (readRecord(channel, index, r) && MessageId::keyOf(IdString(r.message_id)) == key) return true;
+    }
+    return false;
+}
+
+// ================== LIVE MESSAGES ==================
+bool HistoryStore::append(Channel* channel, const IdString& msg_id, const IdString& sender,
+                          const String& body, const String& ts, Message*& resident) {
+    resident = nullptr;
+
+    // Keep a busy channel's file bounded while the device stays up
+    if (mounted && channel->history_count >= MAX_RECORDS) {
+        closeAppend();
+        shiftWindow(channel, compact(channel));
+    }
+
+    bool atEnd = atTail(channel);
+    uint32_t index = channel->history_count;
+
+    // Flash first: the record survives even if no message slot is left
+    if (mounted) {
+        HistoryRecord r;
+        toRecord(msg_id, sender, body, ts, r);
+        if (writeRecord(channel, r)) {
+            channel->history_count++;
+            rememberKey(channel, index, MessageId::keyOf(msg_id));
+            SearchIndex::add(channel, index, r.text, sender);
+        } else {
+            unmount();
+        }
+    }
+
+    // RAM only: every window ends at its channel's newest message
+    if (mounted && !atEnd) return true;
+
+    Message* msg = createMessage(channel->ID, msg_id, sender, body, ts);
+    if (!msg && reclaim(channel)) msg = createMessage(channel->ID, msg_id, sender, body, ts);
+    if (!msg) {
+        // On flash the window just stops short of the tail; trim() reloads it
+        return mounted;
+    }
+
+    channel->addMessage(msg);
+    all_messages.push_back(msg);
+    if (!mounted) {
+        channel->history_count = channel->history_first + channel->channel_messages.size();
+        rememberKey(channel, index, msg->key);
+        SearchIndex::add(channel, index, msg->message.c_str(), sender);
+    }
+
+    // A busy channel nobody is reading must not fill the pool; the new
+    // message is the newest, so it stays
+    size_t cap = channel_pool.get(open_channel) == channel ? MAX_WINDOW : RESIDENT;
+    size_t n = channel->channel_messages.size();
+    if (n > cap) dropFront(channel, n - cap);
+    resident = msg;
+    return true;
+}
+
+// Shrink every other channel's window to half the at-rest size
+size_t HistoryStore::reclaim(Channel* keep) {
+    size_t freed = 0;
+    for (Channel* ch : all_channels) {
+        if (!ch || ch == keep) continue;
+        size_t n = ch->channel_messages.size();
+        if (n <= RESIDENT / 2) continue;
+        dropFront(ch, n - RESIDENT / 2);
+        freed += n - RESIDENT / 2;
+    }
+    return freed;
+}
+
+// Append one record to the channel's file, through the held handle while batching
+bool HistoryStore::writeRecord(Channel* channel, const HistoryRecord& r) {
+    if (channel_pool.get(append_channel) != channel) {
+        closeAppend();
+        append_file = LittleFS.open(pathFor(channel), "a");
+        if (append_file) append_channel = channel_pool.handleOf(channel);
+    }
+    if (!append_file) return false;
+    bool ok = append_file.write((const uint8_t*) &r, sizeof(r)) == sizeof(r);
+    if (!batching || !ok) closeAppend();
+    return ok;
+}
+
+// A failed append (full or broken filesystem) would leave the window's
+// indices and the file disagreeing from then on, so fall back to RAM only,
+// as if the mount had failed at boot: each window becomes its channel's
+// whole history.
+void HistoryStore::unmount() {
+    ERR("History append failed, keeping messages in RAM only");
+    closeAppend();
+    mounted = false;
+    pending_channel = PoolHandle();
+    for (Channel* ch : all_channels) {
+        if (ch) ch->history_count = ch->history_first + ch->channel_messages.size();
+    }
+}
+
+void HistoryStore::endBatch() {
+    batching = false;
+    closeAppend();
+}
+
+void HistoryStore::closeAppend() {
+    if (append_file) append_file.close();
+    append_file = File();
+    append_channel = PoolHandle();
+}
+
+void HistoryStore::rewrite(Channel* channel, Message* msg) {
+    if (!mounted) return;
+    closeAppend();
+    const std::vector<Message*>& msgs = channel->channel_messages;
+    auto it = std::find(msgs.begin(), msgs.end(), msg);
+    if (it == msgs.end()) return;
+
+    HistoryRecord r;
+    toRecord(msg, r);
+    File f = LittleFS.open(pathFor(channel), "r+");
+    if (!f) return;
+    f.seek((channel->history_first + (it - msgs.begin())) * RECORD_SIZE);
+    f.write((const uint8_t*) &r, sizeof(r));
+    f.close();
+}
+
+// ================== PAGING ==================
+void HistoryStore::prefetch(Channel* channel, int scrollOffset, int contentHeight,
+                            int viewHeight, int prefetchPx) {
+    if (!mounted || !channel || channel_pool.get(pending_channel)) return;
+
+    if (scrollOffset < prefetchPx && channel->history_first > 0) {
+        pending_channel = channel_pool.handleOf(channel);
+        pending_front = true;
+    } else if (contentHeight - scrollOffset - viewHeight < prefetchPx && !atTail(channel)) {
+        pending_channel = channel_pool.handleOf(channel);
+        pending_front = false;
+    }
+}
+
+void HistoryStore::update() {
+    // The handle resolves to nullptr if the channel was destroyed meanwhile
+    Channel* channel = channel_pool.get(pending_channel);
+    pending_channel = PoolHandle();
+    if (!channel) return;
+
+    if (pending_front) loadFront(channel);
+    else               loadBack(channel);
+}
+
+// Older page in front of the window; newest residents go if over the cap
+void HistoryStore::loadFront(Channel* channel) {
+    uint32_t count = min((uint32_t) PAGE_SIZE, channel->history_first);
+    if (count == 0) return;
+    size_t got = readRecords(channel, channel->history_first - count, count);
+    if (got != count) return;
+
+    if (message_pool.available() < got) return;
+
+    std::vector<Message*>& msgs = channel->channel_messages;
+    msgs.insert(msgs.begin(), got, nullptr);
+    for (size_t i = 0; i < got; ++i) {
+        msgs[i] = toMessage(channel, page[i]);
+        all_messages.push_back(msgs[i]);
+    }
+    channel->history_first -= got;
+    channel->_message_count = msgs.size();
+    pages_loaded++;
+    if (front_hook) front_hook(channel, (int) got);
+
+    if (msgs.size() > MAX_WINDOW) dropBack(channel, msgs.size() - MAX_WINDOW);
+}
+
+// Newer page after the window; oldest residents go if over the cap
+void HistoryStore::loadBack(Channel* channel) {
+    uint32_t next = channel->history_first + channel->channel_messages.size();
+    if (next >= channel->history_count) return;
+    size_t got = readRecords(channel, next, channel->history_count - next);
+    if (message_pool.available() < got) return;
+    for (size_t i = 0; i < got; ++i) {
+        Message* msg = toMessage(channel, page[i]);
+        channel->addMessage(msg);
+        all_messages.push_back(msg);
+    }
+    if (got) pages_loaded++;
+
+    if (channel->channel_messages.size() > MAX_WINDOW) {
+        dropFront(channel, channel->channel_messages.size() - MAX_WINDOW);
+    }
+}
+
+void HistoryStore::dropFront(Channel* channel, size_t count) {
+    std::vector<Message*>& msgs = channel->channel_messages;
+    count = min(count, msgs.size());
+    if (front_hook) front_hook(channel, -(int) count);
+    for (size_t i = 0; i < count; ++i) destroyMessage(msgs[i]);
+    msgs.erase(msgs.begin(), msgs.begin() + count);
+    channel->history_first += count;
+    channel->_message_count = msgs.size();
+}
+
+void HistoryStore::dropBack(Channel* channel, size_t count) {
+    std::vector<Message*>& msgs = channel->channel_messages;
+    count = min(count, msgs.size());
+    for (size_t i = msgs.size() - count; i < msgs.size(); ++i) destroyMessage(msgs[i]);
+    msgs.resize(msgs.size() - count);
+    channel->_message_count = msgs.size();
+}
+
+void HistoryStore::clearWindow(Channel* channel) {
+    if (channel_pool.get(pending_channel) == channel) pending_channel = PoolHandle();
+    for (Message* m : channel->channel_messages) destroyMessage(m);
+    channel->channel_messages.clear();
+    channel->_message_count = 0;
+}
+
+void HistoryStore::trim(Channel* channel) {
+    if (!mounted || !channel) return;
+    if (atTail(channel) && channel->channel_messages.size() <= RESIDENT) return;
+
+    if (atTail(channel)) {
+        dropFront(channel, channel->channel_messages.size() - RESIDENT);
+    } else {
+        loadTail(channel);
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <Arduino.h>
+#include "../global_objects.h"
+
+// ================== HistoryRecord ===================
+// One message as stored on flash; fixed size so record i lives at i * 256
+// and latency updates can be rewritten in place. Longer texts are truncated.
+struct HistoryRecord {
+    char message_id[24];
+    char sender_id[24];
+    char time_stamp[20];
+    char text[176];
+    int16_t rssi;
+    int16_t snr;
+    uint32_t latency;
+    uint8_t flags;       // bit 0: latency set
+    uint8_t reserved[3];
+};
+
+// ================== HistoryStore ===================
+// Per-channel message history in LittleFS (/h/<fnv32 of channel ID>), with
+// only a window of it resident in channel_messages.
+//
+// The window is a contiguous run of records [history_first, history_first +
+// size). Live messages are appended to the file and, when the window sits at
+// the tail, to RAM. Scrolling near either edge queues a page request that
+// update() serves from the loop through one reusable page buffer.
+//
+// Pages added to / removed from the front move every message below them, so
+// the front hook lets the view compensate its scroll offset and caches.
+//
+// A file that reaches MAX_RECORDS is cut to its newest half on the next
+// append (and at boot); the window and search postings move down with it.
+//
+// Each channel keeps a 16-bit hash of every stored record's message key
+// (rebuilt from flash when its tail is first loaded), so seen() finds
+// repeats anywhere in the stored history for one flash read per match.
+class HistoryStore {
+public:
+    static constexpr size_t RECORD_SIZE   = sizeof(HistoryRecord);
+    static constexpr size_t RESIDENT      = 20;   // Window kept after leaving a chat
+    static constexpr size_t PAGE_SIZE     = 8;    // Records per page load
+    static constexpr size_t MAX_WINDOW    = 64;   // Window cap while browsing
+    static constexpr uint32_t MAX_RECORDS = 512;  // Per channel; compacted to half on reaching it
+
+    // Called with count > 0 after count messages were inserted at the front,
+    // count < 0 before -count front messages are deleted, 0 when the window
+    // was replaced
+    typedef void (*FrontHook)(Channel* channel, int count);
+
+    // Called by scan() for each stored record
+    typedef void (*RecordFn)(Channel* channel, uint32_t index, const HistoryRecord& r);
+
+    // Mount the filesystem and load each channel's tail into RAM
+    static void begin();
+    static void setFrontHook(FrontHook hook) { front_hook = hook; }
+
+    // Load the last RESIDENT records of a (new) channel
+    static void loadTail(Channel* channel);
+
+    // Replace the window with RESIDENT records around a stored record
+    // (search hits); trim() brings it back to the tail
+    static void loadAround(Channel* channel, uint32_t index);
+
+    // One stored record, from the window if resident, else from flash
+    static bool readRecord(Channel* channel, uint32_t index, HistoryRecord& r);
+
+    // True if one of the channel's newest STORED_KEYS records has this
+    // message key (MessageId::keyOf); exact, from RAM hashes checked on flash
+    static bool seen(Channel* channel, uint64_t key);
+
+    // Visit records [first, min(end, history_count)) through the page buffer
+    static void scan(Channel* channel, uint32_t first, RecordFn fn, uint32_t end = UINT32_MAX);
+
+    // Store a live message. The record goes to flash first, so running out
+    // of message slots never loses history; the message then joins the
+    // window only if the window sits at the tail (other channels' windows
+    // are shrunk when the pool is exhausted). body is the stored form
+    // (TextCodec::pack). resident is the window's new message, or nullptr
+    // if it lives on flash only. Returns false if it was stored nowhere.
+    static bool append(Channel* channel, const IdString& msg_id, const IdString& sender,
+                       const String& body, const String& ts, Message*& resident);
+
+    // The channel shown in the chat screen (nullptr for none). Its window
+    // may grow to MAX_WINDOW; every other window is kept at RESIDENT.
+    static void setOpen(Channel* channel) { open_channel = channel_pool.handleOf(channel); }
+
+    // Between beginBatch() and endBatch(), append() keeps the channel file open
+    // across consecutive appends, so a burst costs one open/close per run of
+    // same-channel messages instead of one per message. Reads and rewrites
+    // close it first, so they always see every appended record.
+    static void beginBatch() { batching = true; }
+    static void endBatch();
+
+    // Rewrite a resident message's record (after a latency update)
+    static void rewrite(Channel* channel, Message* msg);
+
+    // Queue a page load if the view is within prefetchPx of either edge
+    static void prefetch(Channel* channel, int scrollOffset, int contentHeight,
+                         int viewHeight, int prefetchPx);
+
+    // Serve one pending page request (call in loop)
+    static void update();
+
+    // Return the window to the last RESIDENT records (after leaving a chat)
+    static void trim(Channel* channel);
+
+    // True if the window ends at the newest stored record
+    static bool atTail(const Channel* channel) {
+        return channel->history_first + channel->channel_messages.size() >= channel->history_count;
+    }
+
+    // Counters
+    static unsigned long pagesLoaded() { return pages_loaded; }
+
+private:
+    static bool mounted;
+    static PoolHandle open_channel;
+    static FrontHook front_hook;
+    static HistoryRecord page[PAGE_SIZE];  // Reusable page buffer
+
+    static PoolHandle pending_channel;     // Channel with a queued page request
+    static bool pending_front;             // true: older page, false: newer page
+    static unsigned long pages_loaded;
+
+    static bool batching;
+    static PoolHandle append_channel;      // Channel whose file is held open
+
+    static void closeAppend();
+    static bool writeRecord(Channel* channel, const HistoryRecord& r);
+    static void unmount();
+
+    static String pathFor(const Channel* channel);
+    static size_t readRecords(Channel* channel, uint32_t first, size_t count);
+    static Message* toMessage(const Channel* channel, const HistoryRecord& r);
+    static void toRecord(const Message* msg, HistoryRecord& r);
+    static void toRecord(const IdString& msg_id, const IdString& sender, const String& body,
+                         const String& ts, HistoryRecord& r);
+    static void loadFront(Channel* channel);
+    static void loadBack(Channel* channel);
+    static void dropFront(Channel* channel, size_t count);
+    static void dropBack(Channel* channel, size_t count);
+    static void clearWindow(Channel* channel);
+    static void fillWindow(Channel* channel, uint32_t first, uint32_t count);
+    static size_t reclaim(Channel* keep);
+    static uint32_t compact(Channel* channel);
+    static void rememberKey(Channel* channel, uint32_t index, uint64_t key);
+    static void rebuildKeys(Channel* channel);
+    static void onKeyRecord(Channel* channel, uint32_t index, const HistoryRecord& r);
+    static void shiftWindow(Channel* channel, uint32_t dropped);
+};
+
+#endif // HISTORY_STORE_H
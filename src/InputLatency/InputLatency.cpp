@@ -0,0 +1,50 @@
+#include "InputLatency.h"
+
+PerfStat InputLatency::stats[LAT_STAGES];
+unsigned long InputLatency::scan_us = 0;
+unsigned long InputLatency::key_scan_us = 0;
+unsigned long InputLatency::handled_us = 0;
+unsigned long InputLatency::frame_us = 0;
+bool InputLatency::waiting = false;
+
+// ================== SAMPLING ==================
+void InputLatency::handled(bool pending) {
+    if (!pending || waiting) return;
+    key_scan_us = scan_us;
+    handled_us = micros();
+    frame_us = handled_us;
+    waiting = true;
+}
+
+void InputLatency::frameStarted() {
+    if (waiting) frame_us = micros();
+}
+
+// A draft-only frame may precede the one that finishes the key; the queue
+// stage then includes it and the draw stage is the last frame alone
+void InputLatency::frameDone() {
+    if (!waiting) return;
+    waiting = false;
+
+    // micros() differences are wrap-safe
+    unsigned long now = micros();
+    stats[LAT_HANDLE].add(handled_us - key_scan_us);
+    stats[LAT_QUEUE].add(frame_us - handled_us);
+    stats[LAT_DRAW].add(now - frame_us);
+    stats[LAT_TOTAL].add(now - key_scan_us);
+}
+
+const char* InputLatency::stageName(byte stage) {
+    switch (stage) {
+        case LAT_HANDLE: return "handle";
+        case LAT_QUEUE:  return "queue";
+        case LAT_DRAW:   return "draw";
+        case LAT_TOTAL:  return "key_pixel";
+    }
+    return "?";
+}
+
+void InputLatency::reset() {
+    memset(stats, 0, sizeof(stats));
+    waiting = false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#ifndef INPUT_LATENCY_H
+#define INPUT_LATENCY_H
+
+#include <Arduino.h>
+#include "../PerfCounters/PerfCounters.h"
+
+// ================== STAGE IDENTIFIERS ==================
+const byte LAT_HANDLE = 0;  // Keypad scan to event handler return
+const byte LAT_QUEUE  = 1;  // Handler return to start of the frame that shows the key
+const byte LAT_DRAW   = 2;  // That frame, until its last SPI transfer completes
+const byte LAT_TOTAL  = 3;  // Keypad scan to pixels
+const byte LAT_STAGES = 4;
+
+// ================== InputLatency ===================
+// Keypress-to-pixel latency, split into stages. A key is timed from the
+// keypad scan that reported it (or its injection by touch / replay) to the
+// end of the frame that leaves nothing dirty, i.e. until everything it
+// invalidated is on the panel. TFT_eSPI draws are blocking and DMA pushes are
+// waited for, so the end of render() is the end of the SPI traffic.
+//
+// One key is tracked at a time. Keys arriving before the frame coalesce into
+// it and are not sampled separately; keys that invalidate nothing are not
+// sampled. Histograms share PerfStat with PerfCounters (DIAG -> KEYLAT lines).
+class InputLatency {
+public:
+    // A keypad scan (or injected key) is about to be processed
+    static void scanned() { scan_us = micros(); }
+
+    // The key's handler returned; pending if it left regions to repaint
+    static void handled(bool pending);
+
+    // render() is about to draw / has drawn everything that was dirty
+    static void frameStarted();
+    static void frameDone();
+
+    static const PerfStat& stat(byte stage) { return stats[stage]; }
+    static const char* stageName(byte stage);
+
+    static void reset();
+
+private:
+    static PerfStat stats[LAT_STAGES];
+    static unsigned long scan_us;       // Latest scan
+    static unsigned long key_scan_us;   // Scan of the key waiting for its frame
+    static unsigned long handled_us;
+    static unsigned long frame_us;      // Start of the current frame
+    static bool waiting;
+};
+
+#endif // INPUT_LATENCY_H
@@ -1,16 +1,31 @@
 #include "KeypadHandler.h"
 #include "../DebugMacros.h"
-
-#define CHAT_FULL     0
-#define CHAT_MESSAGES 1
-#define CHAT_DRAFT    2
-#define CHAT_CREATE   3
+#include "../SerialTxHandler/SerialTxHandler.h"
+#include "../PerfCounters/PerfCounters.h"
+#include "../LinkStats/LinkStats.h"
+#include "../PowerManager/PowerManager.h"
+#include "../HistoryStore/HistoryStore.h"
+#include "../Subscriptions/Subscriptions.h"
+#include "../SearchIndex/SearchIndex.h"
+#include "../TextCodec/TextCodec.h"
+#include "../TouchHandler/TouchHandler.h"
+#include "../Theme/Theme.h"
+#include "../SmoothFont/SmoothFont.h"
+#include "../InputLatency/InputLatency.h"
 
 KeypadHandler* KeypadHandler::instance = nullptr;
 byte KeypadHandler::keypad_state = 0;
 byte KeypadHandler::press_count  = 0;
 byte KeypadHandler::row_pins[5]  = {25, 26, 27, 18, 19};
 byte KeypadHandler::col_pins[4]  = {4, 16, 17, 32};
+unsigned long KeypadHandler::send_handler_us     = 0;
+unsigned long KeypadHandler::send_handler_max_us = 0;
+#ifdef ENABLE_TEST_HOOKS
+char KeypadHandler::replay_keys[KeypadHandler::REPLAY_MAX];
+byte KeypadHandler::replay_len = 0;
+byte KeypadHandler::replay_pos = 0;
+unsigned long KeypadHandler::last_replay_time = 0;
+#endif
 
 KeypadHandler::KeypadHandler(TFTHandler* tft)
     : numpad(makeKeymap(number_keys), row_pins, col_pins, ROWS, COLS),
@@ -30,9 +45,17 @@ void KeypadHandler::begin() {
 }
 
 void KeypadHandler::update() {
+    // Events fire from inside getKey(); they are timed from this scan
+    InputLatency::scanned();
     if (instance->alpha) instance->ltrpad.getKey();
     else                 instance->numpad.getKey();
 
+#ifdef ENABLE_TEST_HOOKS
+    if (replay_pos < replay_len && millis() - last_replay_time >= REPLAY_GAP_MS) {
+        replayNext();
+    }
+#endif
+
     if (instance->alpha && 
         instance->virt_key != NO_KEY && 
         (millis() - instance->last_press_time > press_time_out)) {
@@ -40,6 +63,42 @@ void KeypadHandler::update() {
     }
 }
 
+void KeypadHandler::injectKey(char key) {
+    if (!instance) return;
+    PERF_SCOPE(PERF_KEY_EVENT);
+    InputLatency::scanned();
+    keypad_state = PRESSED;
+    instance->onState(key);
+    keypad_state = RELEASED;
+    instance->onState(key);
+    InputLatency::handled(instance->MeshCrafted_TFT->renderPending());
+}
+
+#ifdef ENABLE_TEST_HOOKS
+// ================== KEY REPLAY ==================
+void KeypadHandler::replay(const String& keys) {
+    replay_len = min(keys.length(), (unsigned int) REPLAY_MAX);
+    memcpy(replay_keys, keys.c_str(), replay_len);
+    replay_pos = 0;
+    last_replay_time = millis() - REPLAY_GAP_MS;
+}
+
+// One scripted key: pressed then released, as the keypad would report it
+void KeypadHandler::replayNext() {
+    PERF_SCOPE(PERF_KEY_EVENT);
+    char key = replay_keys[replay_pos++];
+    last_replay_time = millis();
+    PowerManager::activity();
+
+    InputLatency::scanned();
+    keypad_state = PRESSED;
+    instance->onState(key);
+    keypad_state = RELEASED;
+    instance->onState(key);
+    InputLatency::handled(instance->MeshCrafted_TFT->renderPending());
+}
+#endif
+
 bool KeypadHandler::isSpecialKey(char key) {
     return ((key >= 'A' && key <= 'H') || key == '#');
 }
@@ -54,25 +113,172 @@ void KeypadHandler::finalizeChar() {
 
 void KeypadHandler::keypadEvent_ltr(KeypadEvent key) {
     if (!instance) return;
+    PERF_SCOPE(PERF_KEY_EVENT);
     keypad_state = instance->ltrpad.getState();
+    if (!PowerManager::activity()) return;  // key only woke the display
     instance->onState(key);
+    InputLatency::handled(instance->MeshCrafted_TFT->renderPending());
 }
 
 void KeypadHandler::keypadEvent_nbr(KeypadEvent key) {
     if (!instance) return;
+    PERF_SCOPE(PERF_KEY_EVENT);
     keypad_state = instance->numpad.getState();
+    if (!PowerManager::activity()) return;  // key only woke the display
     instance->onState(key);
+    InputLatency::handled(instance->MeshCrafted_TFT->renderPending());
+}
+
+// ============================================================
+// SCREEN STATE MACHINE
+// ============================================================
+// (screen, key, event) -> action / transition. Entries are scanned in order;
+// the first matching entry whose action returns true wins. Actions only mark
+// regions dirty; the frame is rendered once per event batch by TFTHandler.
+const KeypadHandler::Transition KeypadHandler::transitions[] = {
+    // screen              key        event     next                action
+    { SCREEN_START,        '1',       RELEASED, SCREEN_MESSAGES,    nullptr },
+    { SCREEN_START,        '2',       RELEASED, SCREEN_SETTINGS,    nullptr },
+
+    { SCREEN_MESSAGES,     'F',       RELEASED, SCREEN_START,       nullptr },
+    { SCREEN_MESSAGES,     'D',       RELEASED, SCREEN_STAY,        act_ScrollChannelsUp },
+    { SCREEN_MESSAGES,     'E',       RELEASED, SCREEN_STAY,        act_ScrollChannelsDown },
+    { SCREEN_MESSAGES,     'A',       RELEASED, SCREEN_CREATE,      nullptr },
+    { SCREEN_MESSAGES,     'G',       RELEASED, SCREEN_DISCOVER,    nullptr },
+    { SCREEN_MESSAGES,     'B',       RELEASED, SCREEN_SEARCH,      nullptr },
+    { SCREEN_MESSAGES,     KEY_DIGIT, RELEASED, SCREEN_CHAT,        act_SelectChannel },
+
+    { SCREEN_SETTINGS,     'F',       RELEASED, SCREEN_START,       nullptr },
+    { SCREEN_SETTINGS,     '1',       RELEASED, SCREEN_EDIT_USER,   nullptr },
+    { SCREEN_SETTINGS,     '2',       RELEASED, SCREEN_STAY,        act_ChangeTheme },
+    { SCREEN_SETTINGS,     '3',       RELEASED, SCREEN_DIAGNOSTICS, nullptr },
+    { SCREEN_SETTINGS,     '4',       RELEASED, SCREEN_STAY,        act_CalibrateTouch },
+
+    { SCREEN_EDIT_USER,    'F',       RELEASED, SCREEN_SETTINGS,    nullptr },
+    { SCREEN_EDIT_USER,    '1',       RELEASED, SCREEN_EDIT_USER,   act_IfNumeric },
+    { SCREEN_EDIT_USER,    'H',       RELEASED, SCREEN_STAY,        act_SaveUsername },
+
+    { SCREEN_CHAT,         'F',       RELEASED, SCREEN_MESSAGES,    nullptr },
+    { SCREEN_CHAT,         'D',       PRESSED,  SCREEN_STAY,        act_ScrollChatUp },
+    { SCREEN_CHAT,         'E',       PRESSED,  SCREEN_STAY,        act_ScrollChatDown },
+    { SCREEN_CHAT,         'H',       PRESSED,  SCREEN_STAY,        act_SendMessage },
+
+    { SCREEN_CREATE,       'F',       RELEASED, SCREEN_MESSAGES,    nullptr },
+    { SCREEN_CREATE,       'H',       EVENT_ANY, SCREEN_MESSAGES,   act_CreateLobby },
+
+    { SCREEN_DIAGNOSTICS,  'F',       RELEASED, SCREEN_SETTINGS,    nullptr },
+    { SCREEN_DIAGNOSTICS,  '1',       RELEASED, SCREEN_LINK_STATS,  nullptr },
+    { SCREEN_DIAGNOSTICS,  '0',       RELEASED, SCREEN_STAY,        act_DumpCounters },
+    { SCREEN_DIAGNOSTICS,  'C',       RELEASED, SCREEN_STAY,        act_ResetCounters },
+
+    { SCREEN_LINK_STATS,   'F',       RELEASED, SCREEN_DIAGNOSTICS, nullptr },
+    { SCREEN_LINK_STATS,   '1',       RELEASED, SCREEN_STAY,        act_LinksByChannel },
+    { SCREEN_LINK_STATS,   '2',       RELEASED, SCREEN_STAY,        act_LinksBySender },
+
+    { SCREEN_DISCOVER,     'F',       RELEASED, SCREEN_MESSAGES,    nullptr },
+    { SCREEN_DISCOVER,     'C',       RELEASED, SCREEN_STAY,        act_ToggleDiscovery },
+    { SCREEN_DISCOVER,     KEY_DIGIT, RELEASED, SCREEN_MESSAGES,    act_JoinDiscovered },
+
+    { SCREEN_SEARCH,       'F',       RELEASED, SCREEN_MESSAGES,    nullptr },
+    { SCREEN_SEARCH,       'H',       PRESSED,  SCREEN_STAY,        act_RunSearch },
+    { SCREEN_SEARCH,       'D',       PRESSED,  SCREEN_STAY,        act_SearchUp },
+    { SCREEN_SEARCH,       'E',       PRESSED,  SCREEN_STAY,        act_SearchDown },
+    { SCREEN_SEARCH,       'B',       RELEASED, SCREEN_CHAT,        act_OpenSearchHit },
+};
+
+// Per-screen hooks: enter/exit run on transitions, input handles keys no
+// transition consumed (text entry screens)
+const KeypadHandler::ScreenHooks KeypadHandler::screen_hooks[] = {
+    // screen              enter                exit              input
+    { SCREEN_START,        nullptr,             nullptr,          nullptr },
+    { SCREEN_MESSAGES,     nullptr,             nullptr,          nullptr },
+    { SCREEN_SETTINGS,     nullptr,             nullptr,          nullptr },
+    { SCREEN_EDIT_USER,    enter_TextEntry,     exit_TextEntry,   input_Text },
+    { SCREEN_CHAT,         enter_Chat,          exit_Chat,        input_Text },
+    { SCREEN_CREATE,       enter_AddLobby,      exit_TextEntry,   input_Text },
+    { SCREEN_DIAGNOSTICS,  nullptr,             nullptr,          nullptr },
+    { SCREEN_LINK_STATS,   nullptr,             nullptr,          nullptr },
+    { SCREEN_DISCOVER,     nullptr,             nullptr,          nullptr },
+    { SCREEN_SEARCH,       enter_Search,        exit_TextEntry,   input_Text },
+};
+
+const KeypadHandler::ScreenHooks* KeypadHandler::hooksFor(byte screen) {
+    for (const ScreenHooks& h : screen_hooks) {
+        if (h.screen == screen) return &h;
+    }
+    return nullptr;
 }
 
 void KeypadHandler::onState(char key) {
-    switch (instance->MeshCrafted_TFT->get_currentScreen()) {
-        case SCREEN_START:     handle_StartScreen(key); break;
-        case SCREEN_SETTINGS:  handle_SettingsScreen(key); break;
-        case SCREEN_MESSAGES:  handle_MessagesScreen(key); break;
-        case SCREEN_CHAT:      handle_ChatScreen(key); break;
-        case SCREEN_EDIT_USER: handle_EditUserScreen(key); break;
-        case SCREEN_CREATE:    handle_AddLobbyScreen(key); break;
+    byte screen = instance->MeshCrafted_TFT->get_currentScreen();
+
+    for (const Transition& t : transitions) {
+        if (t.screen != screen) continue;
+        if (t.key != key && !(t.key == KEY_DIGIT && key >= '1' && key <= '9')) continue;
+        if (t.event != EVENT_ANY && t.event != keypad_state) continue;
+        if (t.action && !t.action(key)) continue;
+
+        if (t.next != SCREEN_STAY) goTo(t.next);
+        return;
     }
+
+    const ScreenHooks* hooks = hooksFor(screen);
+    if (hooks && hooks->input) hooks->input(key);
+}
+
+void KeypadHandler::goTo(byte screen) {
+    const ScreenHooks* from = hooksFor(instance->MeshCrafted_TFT->get_currentScreen());
+    if (from && from->exit) from->exit();
+
+    instance->MeshCrafted_TFT->set_CurrentScreen(screen);
+
+    const ScreenHooks* to = hooksFor(screen);
+    if (to && to->enter) to->enter();
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_SCREEN);
+}
+
+// ------------------ Enter / exit / input hooks ------------------
+void KeypadHandler::enter_TextEntry() {
+    instance->input_mode = true;
+}
+
+void KeypadHandler::exit_TextEntry() {
+    instance->input_mode = false;
+    instance->alpha = false;
+}
+
+void KeypadHandler::enter_Chat() {
+    instance->input_mode = true;
+    instance->alpha = true;
+    text_draft = instance->text_input;
+    instance->MeshCrafted_TFT->chatChannel = instance->target_channel;
+    HistoryStore::setOpen(instance->target_channel);
+}
+
+void KeypadHandler::exit_Chat() {
+    exit_TextEntry();
+    // Give back pages loaded while browsing
+    HistoryStore::setOpen(nullptr);
+    HistoryStore::trim(instance->target_channel);
+    instance->MeshCrafted_TFT->chatChannel = nullptr;
+}
+
+void KeypadHandler::enter_AddLobby() {
+    instance->input_mode = true;
+    instance->alpha = true;
+}
+
+void KeypadHandler::enter_Search() {
+    instance->input_mode = true;
+    instance->alpha = true;
+    instance->text_input = "";
+    text_draft = "";
+    instance->MeshCrafted_TFT->searchSelection = 0;
+}
+
+void KeypadHandler::input_Text(char key) {
+    handleTextInput(key);
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_DRAFT);
 }
 
 // ============================================================
@@ -90,6 +296,7 @@ void KeypadHandler::handleTextInput(char key) {
 
     if (keypad_state == PRESSED && key == 'C' && instance->text_input.length() > 0) {
         instance->text_input.remove(instance->text_input.length() - 1);
+        text_draft = instance->text_input;
         return;
     }
 
@@ -115,6 +322,7 @@ void KeypadHandler::handleTextInput(char key) {
             instance->text_input.concat(key);
         }
         instance->last_press_time = millis();
+        text_draft = instance->text_input;
         return;
     }
 
@@ -133,220 +341,236 @@ void KeypadHandler::handleTextInput(char key) {
 }
 
 // ============================================================
-// SCREEN HANDLERS
+// ACTIONS
 // ============================================================
-void KeypadHandler::handle_StartScreen(char key) {
-    if (keypad_state != RELEASED) return;
-
-    if (key == '1') {
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_MESSAGES);
-        instance->MeshCrafted_TFT->tft.fillScreen(TFT_BLACK);
-        instance->MeshCrafted_TFT->drawMessagesHeader();
-        instance->MeshCrafted_TFT->drawMessagesFooter();
-        instance->MeshCrafted_TFT->draw_MessagesScreen();
-    } else if (key == '2') {
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_SETTINGS);
-        instance->MeshCrafted_TFT->draw_SettingsScreen();
-    }
+// Return false to let the key fall through to later entries / the input hook
+bool KeypadHandler::act_ScrollChannelsUp(char) {
+    instance->MeshCrafted_TFT->scrollMessagesUp();
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
 }
 
-void KeypadHandler::handle_MessagesScreen(char key) {
-    if (keypad_state != RELEASED) return;
+bool KeypadHandler::act_ScrollChannelsDown(char) {
+    instance->MeshCrafted_TFT->scrollMessagesDown();
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
+}
 
-    if (key == 'F') {
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_START);
-        instance->MeshCrafted_TFT->draw_StartScreen();
-        return;
-    }
+bool KeypadHandler::act_SelectChannel(char key) {
+    int index = (key - '1') + instance->MeshCrafted_TFT->getMessagesIncrement();
+    Channel* ch = channelAtActivityIndex(index);
+    if (!ch) return false;
 
-    if (key == 'D') {
-        instance->MeshCrafted_TFT->scrollMessagesUp();
-        instance->MeshCrafted_TFT->draw_MessagesScreen();
-        return;
-    }
+    ch->unread_count = 0;
+    instance->target_channel = ch;
+    instance->MeshCrafted_TFT->sendFailed = false;
+    return true;
+}
 
-    if (key == 'E') {
-        instance->MeshCrafted_TFT->scrollMessagesDown();
-        instance->MeshCrafted_TFT->draw_MessagesScreen();
-        return;
-    }
+bool KeypadHandler::act_IfNumeric(char) {
+    return !instance->alpha;
+}
 
-    if (key == 'A') {
-        instance->alpha = true;
-        instance->input_mode = true;
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_CREATE);
-        instance->MeshCrafted_TFT->tft.fillScreen(TFT_BLACK);
-        instance->MeshCrafted_TFT->drawAddLobbyHeader();
-        instance->MeshCrafted_TFT->draw_AddLobbyScreen(text_draft);
-        instance->MeshCrafted_TFT->drawAddLobbyFooter();
-        return;
+bool KeypadHandler::act_SaveUsername(char) {
+    if (local_user) local_user->username = text_draft;
+    PreferencesHandler::setUsername(text_draft);
+    // Still feed the key to the editor, as before
+    return false;
+}
+
+bool KeypadHandler::act_ScrollChatUp(char) {
+    instance->MeshCrafted_TFT->scrollChatUp();
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_SCROLL);
+    return true;
+}
+
+bool KeypadHandler::act_ScrollChatDown(char) {
+    instance->MeshCrafted_TFT->scrollChatDown(instance->target_channel);
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_SCROLL);
+    return true;
+}
+
+bool KeypadHandler::act_SendMessage(char) {
+    if (instance->text_input.length() == 0 || !instance->target_channel) return false;
+
+    unsigned long send_start = micros();
+    IdString msg_id = generateMessageId();
+    String ts = getTime();
+    Channel* channel = instance->target_channel;
+    TFTHandler* tft = instance->MeshCrafted_TFT;
+    String body = TextCodec::pack(instance->text_input);
+
+    // Queue the packet first: if the ring is full nothing is stored or shown
+    // as sent, and the draft stays for a retry
+    String packet = KeypadHandler::formatOutgoingMessage(channel, msg_id, body, ts);
+    if (!SerialTxHandler::enqueuePacket(packet)) {
+        tft->sendFailed = true;
+        tft->invalidate(TFTHandler::DIRTY_DRAFT);
+        recordSendTime(send_start);
+        return true;
+    }
+    if (tft->sendFailed) {
+        tft->sendFailed = false;
+        tft->invalidate(TFTHandler::DIRTY_DRAFT);
     }
 
-    for (int i = 0; i < all_channels.size(); i++) {
-        if (key == ('1' + i)) {
-            int index = i + instance->MeshCrafted_TFT->getMessagesIncrement();
-            if (index >= all_channels.size()) return;
-
-            Channel* ch = all_channels[index];
-            instance->target_channel = ch;
-            instance->alpha = true;
-            instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_CHAT);
-            instance->MeshCrafted_TFT->draw_ChatScreen(ch->ID, instance->text_input, CHAT_FULL);
-            return;
-        }
+    // Sending always shows the newest messages, so bring the window back to the tail first
+    if (!HistoryStore::atTail(channel)) HistoryStore::trim(channel);
+    Message* newMsg;
+    if (HistoryStore::append(channel, msg_id, local_user->ID, body, ts, newMsg)) {
+        touchChannelActivity(channel);
+        LinkStats::onMessage(channel->ID, local_user->ID);
     }
+
+    instance->text_input = "";
+    text_draft = "";
+
+    tft->scrollToBottom(instance->target_channel);
+    tft->invalidate(TFTHandler::DIRTY_BODY | TFTHandler::DIRTY_DRAFT);
+    recordSendTime(send_start);
+    return true;
 }
 
-void KeypadHandler::handle_SettingsScreen(char key) {
-    if (keypad_state != RELEASED) return;
+void KeypadHandler::recordSendTime(unsigned long start_us) {
+    send_handler_us = micros() - start_us;
+    if (send_handler_us > send_handler_max_us) send_handler_max_us = send_handler_us;
+}
 
-    if (key == 'F') {
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_START);
-        instance->MeshCrafted_TFT->draw_StartScreen();
-    } else if (key == '1') {
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_EDIT_USER);
-        instance->MeshCrafted_TFT->draw_EditUserInfoScreen(true, text_draft);
-    }
+bool KeypadHandler::act_CreateLobby(char) {
+    if (text_draft.isEmpty()) return false;
+
+    Channel* newCh = createChannel(CHAT_GROUP, text_draft, generateMessageId());
+    if (!newCh) return false;
+    registerChannel(newCh);
+
+    instance->text_input = "";
+    text_draft = "";
+    return true;
 }
 
-void KeypadHandler::handle_EditUserScreen(char key) {
-    instance->input_mode = true;
+bool KeypadHandler::act_DumpCounters(char) {
+    PerfCounters::dump();
+    return true;
+}
 
-    if (keypad_state == RELEASED) {
-        if (key == 'F') {
-            instance->alpha = false;
-            instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_SETTINGS);
-            instance->MeshCrafted_TFT->draw_SettingsScreen();
-            instance->input_mode = false;
-            return;
-        }
-        if (!instance->alpha && key == '1') {
-            instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_EDIT_USER);
-            instance->MeshCrafted_TFT->draw_EditUserInfoScreen(true, text_draft);
-            return;
-        }
-        if (key == 'H') {
-            if (local_user) local_user->username = text_draft;
-            PreferencesHandler::setUsername(text_draft);
-        }
-    }
+bool KeypadHandler::act_ResetCounters(char) {
+    PerfCounters::reset();
+    SmoothFont::resetStats();
+    InputLatency::reset();
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
+}
 
-    handleTextInput(key);
-    instance->MeshCrafted_TFT->draw_EditUserInfoScreen(false, text_draft);
+bool KeypadHandler::act_LinksByChannel(char) {
+    instance->MeshCrafted_TFT->linkStatsBySender = false;
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
 }
 
-void KeypadHandler::handle_ChatScreen(char key) {
-    instance->input_mode = true;
+bool KeypadHandler::act_LinksBySender(char) {
+    instance->MeshCrafted_TFT->linkStatsBySender = true;
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
+}
 
-    if (keypad_state == RELEASED && key == 'F') {
-        instance->input_mode = false;
-        instance->alpha = false;
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_MESSAGES);
-        instance->MeshCrafted_TFT->tft.fillScreen(TFT_BLACK);
-        instance->MeshCrafted_TFT->drawMessagesHeader();
-        instance->MeshCrafted_TFT->drawMessagesFooter();
-        instance->MeshCrafted_TFT->draw_MessagesScreen();
-        return;
-    }
+bool KeypadHandler::act_ToggleDiscovery(char) {
+    Subscriptions::setDiscovery(!Subscriptions::discoveryEnabled());
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
+}
 
-    if (keypad_state == PRESSED && key == 'D') {
-        instance->MeshCrafted_TFT->scrollChatUp();
-        instance->MeshCrafted_TFT->drawChatMessages(instance->target_channel);
-        return;
-    }
+bool KeypadHandler::act_JoinDiscovered(char key) {
+    byte index = key - '1';
+    if (key < '1' || index >= Subscriptions::discoveredCount()) return false;
+
+    // No name travels with packets, so the ID doubles as the name
+    IdString id = Subscriptions::discovered(index).id;
+    Channel* ch = createChannel(CHAT_GROUP, id, id);
+    if (!ch) return false;
+    registerChannel(ch);  // also sets the filter bits and leaves the list
+    PreferencesHandler::saveChannels(all_channels);
+    HistoryStore::loadTail(ch);
+    return true;
+}
 
-    if (keypad_state == PRESSED && key == 'E') {
-        instance->MeshCrafted_TFT->scrollChatDown(instance->target_channel);
-        instance->MeshCrafted_TFT->drawChatMessages(instance->target_channel);
-        return;
-    }
+bool KeypadHandler::act_RunSearch(char) {
+    SearchIndex::search(text_draft);
+    instance->MeshCrafted_TFT->searchSelection = 0;
+    instance->MeshCrafted_TFT->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
+}
 
-    if (keypad_state == PRESSED && key == 'H' &&
-        instance->text_input.length() > 0 &&
-        instance->target_channel) {
-
-        String msg_id = generateMessageId();
-        String ts = getTime();
-        Message* newMsg = new Message(
-            instance->target_channel->ID,
-            msg_id,
-            local_user->ID,
-            instance->text_input,
-            ts
-        );
-
-        instance->target_channel->addMessage(newMsg);
-        all_messages.push_back(newMsg);
-
-        // Build outgoing packet
-        String packet = KeypadHandler::formatOutgoingMessage(newMsg);
-        Serial.println(packet);
-
-        instance->text_input = "";
-        text_draft = "";
-
-        instance->MeshCrafted_TFT->scrollToBottom(instance->target_channel);
-        instance->MeshCrafted_TFT->drawChatMessages(instance->target_channel);
-        instance->MeshCrafted_TFT->drawChatDraft(instance->text_input);
-        return;
+bool KeypadHandler::act_SearchUp(char) {
+    TFTHandler* tft = instance->MeshCrafted_TFT;
+    if (tft->searchSelection > 0) tft->searchSelection--;
+    tft->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
+}
+
+bool KeypadHandler::act_SearchDown(char) {
+    TFTHandler* tft = instance->MeshCrafted_TFT;
+    if (tft->searchSelection + 1 < SearchIndex::hitCount()) tft->searchSelection++;
+    tft->invalidate(TFTHandler::DIRTY_BODY);
+    return true;
+}
+
+bool KeypadHandler::act_OpenSearchHit(char) {
+    byte sel = instance->MeshCrafted_TFT->searchSelection;
+    if (sel >= SearchIndex::hitCount()) return false;
+    const SearchHit& hit = SearchIndex::hit(sel);
+    Channel* ch = channel_pool.get(hit.channel);
+    if (!ch) return false;
+
+    // Page the hit in unless it is already resident, then put it at the top
+    uint32_t index = hit.record;
+    if (index < ch->history_first || index - ch->history_first >= ch->channel_messages.size()) {
+        HistoryStore::loadAround(ch, index);
+    }
+    if (index < ch->history_first || index - ch->history_first >= ch->channel_messages.size()) {
+        return false;
     }
 
-    handleTextInput(key);
-    instance->MeshCrafted_TFT->drawChatDraft(instance->text_input);
+    ch->unread_count = 0;
+    instance->text_input = "";
+    text_draft = "";
+    instance->target_channel = ch;
+    instance->MeshCrafted_TFT->sendFailed = false;
+    instance->MeshCrafted_TFT->scrollToMessage(ch, index - ch->history_first);
+    return true;
+}
+
+bool KeypadHandler::act_CalibrateTouch(char) {
+    TouchHandler::calibrate();
+    return true;
+}
+
+bool KeypadHandler::act_ChangeTheme(char) {
+    Theme::next();
+    INFO(String("Theme: ") + Theme::name(Theme::index()));
+    instance->MeshCrafted_TFT->repaintAll();
+    return true;
 }
 
 // ============================================================
 // Format outgoing message — NEW FORMAT (8 fields)
 // channel_id || message_id || sender_id || message || time_stamp
 // ============================================================
-String KeypadHandler::formatOutgoingMessage(Message* msg) {
-    if (!msg || !local_user) return "";
+String KeypadHandler::formatOutgoingMessage(const Channel* channel, const IdString& msg_id,
+                                            const String& body, const String& ts) {
+    if (!channel || !local_user) return "";
     String packet =
-        msg->channel_id + "||" +
-        msg->message_id + "||" +
-        msg->sender_id +  "||" +
-        msg->message + "||" +
-        msg->time_stamp;
+        channel->ID.toString() + "||" +
+        msg_id.c_str() + "||" +
+        local_user->ID.c_str() +  "||" +
+        TextCodec::forWire(channel, body) + "||" +
+        ts;
 
     return packet;
 }
 
 void KeypadHandler::drawModeIndicator() {
     String mode = instance->alpha ? "ALPHA" : "NUMERIC";
-    instance->MeshCrafted_TFT->tft.fillRect(250, 0, 70, 20, TFT_DARKGREY);
-    instance->MeshCrafted_TFT->tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
+    instance->MeshCrafted_TFT->tft.fillRect(250, 0, 70, 20, Theme::color(PAL_PANEL));
+    instance->MeshCrafted_TFT->tft.setTextColor(Theme::color(PAL_PANEL_TEXT), Theme::color(PAL_PANEL));
     instance->MeshCrafted_TFT->tft.drawString(mode, 255, 10, 1);
 }
-
-void KeypadHandler::handle_AddLobbyScreen(char key) {
-    if (keypad_state == RELEASED && key == 'F') {
-        instance->input_mode = false;
-        instance->alpha = false;
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_MESSAGES);
-        instance->MeshCrafted_TFT->tft.fillScreen(TFT_BLACK);
-        instance->MeshCrafted_TFT->drawMessagesHeader();
-        instance->MeshCrafted_TFT->drawMessagesFooter();
-        instance->MeshCrafted_TFT->draw_MessagesScreen();
-        return;
-    }
-
-    if (key == 'H' && !text_draft.isEmpty()) {
-        Channel* newCh = new Channel(CHAT_GROUP, text_draft, generateMessageId());
-        all_channels.push_back(newCh);
-
-        instance->text_input = "";
-        text_draft = "";
-
-        instance->input_mode = false;
-        instance->alpha = false;
-        instance->MeshCrafted_TFT->set_CurrentScreen(SCREEN_MESSAGES);
-        instance->MeshCrafted_TFT->tft.fillScreen(TFT_BLACK);
-        instance->MeshCrafted_TFT->drawMessagesHeader();
-        instance->MeshCrafted_TFT->drawMessagesFooter();
-        instance->MeshCrafted_TFT->draw_MessagesScreen();
-        return;
-    }
-
-    handleTextInput(key);
-    instance->MeshCrafted_TFT->draw_AddLobbyScreen(text_draft);
-}
@@ -6,6 +6,7 @@
 #include "TFTHandler/TFTHandler.h"
 #include "../global_objects.h"
 #include "../PreferencesHandler.h"
+#include "../PerfCounters/PerfCounters.h"
 
 class KeypadHandler {
 public:
@@ -19,6 +20,17 @@ public:
     // Update the keypad state (call in loop)
     void update();
 
+    // Act on a key that did not come from the keypad (touch tap zones);
+    // handled as a press and release, as the keypad would report it
+    static void injectKey(char key);
+
+#ifdef ENABLE_TEST_HOOKS
+    // Queue a scripted key sequence (keypad labels, e.g. "#adg H"), played
+    // one press/release per REPLAY_GAP_MS from update(); latency is recorded
+    // as for physical keys. Replaces any sequence still playing.
+    static void replay(const String& keys);
+#endif
+
     // Keypad row and column pins
     static byte row_pins[5];
     static byte col_pins[4];
@@ -40,7 +52,12 @@ public:
     Channel* target_channel = nullptr;
 
     // Helper to format outgoing message as string including timestamp
-    static String formatOutgoingMessage(Message* msg);
+    static String formatOutgoingMessage(const Channel* channel, const IdString& msg_id,
+                                        const String& body, const String& ts);
+
+    // Duration of the SEND key handler, keypress to return (microseconds)
+    static unsigned long send_handler_us;
+    static unsigned long send_handler_max_us;
 
 private:
     // TFT handler pointer
@@ -53,6 +70,17 @@ private:
     // Time in ms to finalize character after no key press
     static constexpr unsigned long press_time_out = 400;
 
+#ifdef ENABLE_TEST_HOOKS
+    // Scripted key replay (serial KEYS||...)
+    static const byte REPLAY_MAX = 64;
+    static constexpr unsigned long REPLAY_GAP_MS = 60;
+    static char replay_keys[REPLAY_MAX];
+    static byte replay_len;
+    static byte replay_pos;
+    static unsigned long last_replay_time;
+    static void replayNext();
+#endif
+
     // Optional LED pin for feedback
     static const byte led_pin = 2;
 
@@ -102,13 +130,69 @@ private:
     // Push buffer to TFT display
     static void pushTextToTFT();
 
-    // Screen-specific handlers
-    static void handle_StartScreen(char key);      // main menu
-    static void handle_SettingsScreen(char key);   // settings menu
-    static void handle_MessagesScreen(char key);   // channel selection
-    static void handle_EditUserScreen(char key);   // editing username
-    static void handle_ChatScreen(char key);       // chat input and sending
-    static void handle_AddLobbyScreen(char key);
+    // ------------------ Screen state machine ------------------
+    // Wildcards for transition entries
+    static const char KEY_DIGIT = 1;       // matches '1'..'9'
+    static const byte EVENT_ANY = 0xFF;    // matches any key state
+    static const byte SCREEN_STAY = 0xFF;  // no screen change
+
+    // One (screen, key, event) -> next screen entry; action may veto by returning false
+    struct Transition {
+        byte screen;
+        char key;
+        byte event;
+        byte next;
+        bool (*action)(char key);
+    };
+
+    // Per-screen enter/exit hooks and fallback input handler
+    struct ScreenHooks {
+        byte screen;
+        void (*enter)();
+        void (*exit)();
+        void (*input)(char key);
+    };
+
+    static const Transition transitions[];
+    static const ScreenHooks screen_hooks[];
+
+    static const ScreenHooks* hooksFor(byte screen);
+
+    // Leave the current screen and enter another, marking it for repaint
+    static void goTo(byte screen);
+
+    // Hooks
+    static void enter_TextEntry();
+    static void exit_TextEntry();
+    static void enter_Chat();
+    static void exit_Chat();
+    static void enter_AddLobby();
+    static void enter_Search();
+    static void input_Text(char key);
+
+    // Actions
+    static bool act_ScrollChannelsUp(char key);
+    static bool act_ScrollChannelsDown(char key);
+    static bool act_SelectChannel(char key);
+    static bool act_IfNumeric(char key);
+    static bool act_SaveUsername(char key);
+    static bool act_ScrollChatUp(char key);
+    static bool act_ScrollChatDown(char key);
+    static bool act_SendMessage(char key);
+    static void recordSendTime(unsigned long start_us);
+    static bool act_CreateLobby(char key);
+    static bool act_DumpCounters(char key);
+    static bool act_ResetCounters(char key);
+    static bool act_LinksByChannel(char key);
+    static bool act_LinksBySender(char key);
+    static bool act_ToggleDiscovery(char key);
+    static bool act_JoinDiscovered(char key);
+    static bool act_RunSearch(char key);
+    static bool act_SearchUp(char key);
+    static bool act_SearchDown(char key);
+    static bool act_OpenSearchHit(char key);
+    static bool act_CalibrateTouch(char key);
+    static bool act_ChangeTheme(char key);
 };
 
 #endif
@@ -0,0 +1,151 @@
+#include "LinkStats.h"
+
+LinkAggregate LinkStats::senders[LinkStats::MAX_SENDERS];
+LinkAggregate LinkStats::channels[LinkStats::MAX_CHANNELS];
+
+// ================== P2Quantile ==================
+void P2Quantile::init(float quantile) {
+    p = quantile;
+    count = 0;
+    for (byte i = 0; i < 5; ++i) {
+        q[i] = 0;
+        n[i] = i + 1;
+    }
+    np[0] = 1; np[1] = 1 + 2 * p; np[2] = 1 + 4 * p; np[3] = 3 + 2 * p; np[4] = 5;
+    dn[0] = 0; dn[1] = p / 2;     dn[2] = p;         dn[3] = (1 + p) / 2; dn[4] = 1;
+}
+
+void P2Quantile::add(float x) {
+    // Bootstrap: keep the first five samples sorted
+    if (count < 5) {
+        byte i = count++;
+        while (i > 0 && q[i - 1] > x) {
+            q[i] = q[i - 1];
+            i--;
+        }
+        q[i] = x;
+        return;
+    }
+    count++;
+
+    // Find the cell containing x, extending the extremes if needed
+    byte k;
+    if (x < q[0])      { q[0] = x; k = 0; }
+    else if (x < q[1]) k = 0;
+    else if (x < q[2]) k = 1;
+    else if (x < q[3]) k = 2;
+    else if (x <= q[4]) k = 3;
+    else               { q[4] = x; k = 3; }
+
+    for (byte i = k + 1; i < 5; ++i) n[i]++;
+    for (byte i = 0; i < 5; ++i) np[i] += dn[i];
+
+    // Adjust the three middle markers towards their desired positions
+    for (byte i = 1; i < 4; ++i) {
+        float d = np[i] - n[i];
+        if ((d >= 1 && n[i + 1] - n[i] > 1) || (d <= -1 && n[i - 1] - n[i] < -1)) {
+            int ds = d > 0 ? 1 : -1;
+            float parabolic = q[i] + (float) ds / (n[i + 1] - n[i - 1]) *
+                ((n[i] - n[i - 1] + ds) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                 (n[i + 1] - n[i] - ds) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+            if (q[i - 1] < parabolic && parabolic < q[i + 1]) {
+                q[i] = parabolic;
+            } else {
+                q[i] = q[i] + ds * (q[i + ds] - q[i]) / (n[i + ds] - n[i]);
+            }
+            n[i] += ds;
+        }
+    }
+}
+
+float P2Quantile::value() const {
+    if (count == 0) return 0;
+    if (count < 5) {
+        // Samples are kept sorted during bootstrap
+        byte idx = (byte) (p * (count - 1) + 0.5f);
+        return q[idx];
+    }
+    return q[2];
+}
+
+// ================== LinkAggregate ==================
+void LinkAggregate::reset(const IdString& new_id) {
+    memset(this, 0, sizeof(*this));
+    memcpy(id, new_id.c_str(), min((size_t) new_id.length(), (size_t) ID_LEN - 1));
+    id_hash = new_id.hash();
+    min_rssi = INT16_MAX; max_rssi = INT16_MIN;
+    min_snr = INT16_MAX;  max_snr = INT16_MIN;
+    min_latency = UINT32_MAX;
+    latency_p50.init(0.5f);
+    latency_p90.init(0.9f);
+}
+
+void LinkAggregate::addReport(int rssi, int snr, unsigned long latency) {
+    if (reports == 0) {
+        ewma_rssi = rssi;
+        ewma_snr = snr;
+        ewma_latency = latency;
+    } else {
+        const float a = LinkStats::EWMA_ALPHA;
+        ewma_rssi    += a * (rssi - ewma_rssi);
+        ewma_snr     += a * (snr - ewma_snr);
+        ewma_latency += a * ((float) latency - ewma_latency);
+    }
+    reports++;
+
+    if (rssi < min_rssi) min_rssi = rssi;
+    if (rssi > max_rssi) max_rssi = rssi;
+    if (snr < min_snr) min_snr = snr;
+    if (snr > max_snr) max_snr = snr;
+    if (latency < min_latency) min_latency = latency;
+    if (latency > max_latency) max_latency = latency;
+    latency_p50.add(latency);
+    latency_p90.add(latency);
+
+    spark[spark_head] = (int8_t) constrain(rssi, -128, 127);
+    spark_head = (spark_head + 1) % SPARK_LEN;
+}
+
+// ================== LinkStats ==================
+LinkAggregate& LinkStats::lookup(LinkAggregate* table, byte size, const IdString& id) {
+    LinkAggregate* oldest = &table[0];
+    for (byte i = 0; i < size; ++i) {
+        LinkAggregate& e = table[i];
+        if (e.messages == 0 && e.reports == 0) {
+            // Unused slot: claim it
+            e.reset(id);
+            return e;
+        }
+        if (e.id_hash == id.hash() &&
+            strncmp(e.id, id.c_str(), LinkAggregate::ID_LEN - 1) == 0) return e;
+        if (e.last_update < oldest->last_update) oldest = &e;
+    }
+    oldest->reset(id);
+    return *oldest;
+}
+
+void LinkStats::onMessage(const IdString& channel_id, const IdString& sender_id) {
+    uint32_t now = millis();
+    LinkAggregate& s = lookup(senders, MAX_SENDERS, sender_id);
+    s.messages++;
+    s.last_update = now;
+    LinkAggregate& c = lookup(channels, MAX_CHANNELS, channel_id);
+    c.messages++;
+    c.last_update = now;
+}
+
+void LinkStats::onLatencyReport(const IdString& channel_id, const IdString& sender_id,
+                                int rssi, int snr, unsigned long latency) {
+    uint32_t now = millis();
+    LinkAggregate& s = lookup(senders, MAX_SENDERS, sender_id);
+    s.addReport(rssi, snr, latency);
+    s.last_update = now;
+    LinkAggregate& c = lookup(channels, MAX_CHANNELS, channel_id);
+    c.addReport(rssi, snr, latency);
+    c.last_update = now;
+}
+
+void LinkStats::reset() {
+    memset(senders, 0, sizeof(senders));
+    memset(channels, 0, sizeof(channels));
+}
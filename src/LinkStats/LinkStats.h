@@ -0,0 +1,83 @@
+#pragma once
+#ifndef LINK_STATS_H
+#define LINK_STATS_H
+
+#include <Arduino.h>
+#include "../FixedString/FixedString.h"
+
+// ----- P2Quantile -----
+// Streaming quantile estimate (Jain & Chlamtac P-square algorithm):
+// five markers, O(1) update, no sample storage.
+struct P2Quantile {
+    float p;          // Target quantile (0..1)
+    float q[5];       // Marker heights
+    float np[5];      // Desired marker positions
+    float dn[5];      // Desired position increments
+    int32_t n[5];     // Actual marker positions
+    uint32_t count;
+
+    void init(float quantile);
+    void add(float x);
+    float value() const;
+};
+
+// ----- LinkAggregate -----
+// Constant-size link-quality summary for one sender or channel
+struct LinkAggregate {
+    static constexpr byte ID_LEN = 16;
+    static constexpr byte SPARK_LEN = 16;
+
+    char id[ID_LEN];            // Sender or channel ID (truncated, for display)
+    uint32_t id_hash;           // Hash of the full ID (compared first)
+    uint32_t messages;          // Messages seen (denominator of delivery ratio)
+    uint32_t reports;           // LAT reports received
+    uint32_t last_update;       // millis() of last change (for eviction)
+
+    float ewma_rssi;            // Exponentially weighted averages
+    float ewma_snr;
+    float ewma_latency;
+    int16_t min_rssi, max_rssi;
+    int16_t min_snr, max_snr;
+    uint32_t min_latency, max_latency;
+    P2Quantile latency_p50;
+    P2Quantile latency_p90;
+
+    int8_t spark[SPARK_LEN];    // Recent RSSI samples, ring ordered
+    byte spark_head;
+
+    void reset(const IdString& new_id);
+    void addReport(int rssi, int snr, unsigned long latency);
+    // Fraction of messages that got a LAT report (0..1)
+    float deliveryRatio() const { return messages ? (float) reports / messages : 0.0f; }
+};
+
+// ================== LinkStats ===================
+// Incremental per-sender and per-channel link analytics fed by LAT reports.
+// Tables are fixed size; the least recently updated entry is recycled.
+class LinkStats {
+public:
+    static constexpr byte MAX_SENDERS  = 16;
+    static constexpr byte MAX_CHANNELS = 8;
+    static constexpr float EWMA_ALPHA  = 0.2f;
+
+    // A message was stored for this channel/sender (incoming or sent)
+    static void onMessage(const IdString& channel_id, const IdString& sender_id);
+
+    // A LAT report arrived for a message of this channel/sender
+    static void onLatencyReport(const IdString& channel_id, const IdString& sender_id,
+                                int rssi, int snr, unsigned long latency);
+
+    // Table access for rendering (entries with messages == 0 are unused)
+    static const LinkAggregate& sender(byte index)  { return senders[index]; }
+    static const LinkAggregate& channel(byte index) { return channels[index]; }
+
+    static void reset();
+
+private:
+    static LinkAggregate senders[MAX_SENDERS];
+    static LinkAggregate channels[MAX_CHANNELS];
+
+    static LinkAggregate& lookup(LinkAggregate* table, byte size, const IdString& id);
+};
+
+#endif // LINK_STATS_H
@@ -0,0 +1,87 @@
+#include "MessageId.h"
+
+static const char CROCKFORD[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+uint16_t MessageId::node_id = 0;
+uint32_t MessageId::boot_epoch = 0;
+unsigned long MessageId::boot_ms = 0;
+uint32_t MessageId::last_epoch = 0;
+uint16_t MessageId::counter = 0;
+
+// ================== GENERATION ==================
+void MessageId::begin(uint32_t epoch) {
+    // Fold the 48-bit factory MAC into 16 bits
+    uint64_t mac = ESP.getEfuseMac();
+    node_id = (uint16_t) (mac ^ (mac >> 16) ^ (mac >> 32));
+
+    boot_epoch = epoch;
+    boot_ms = millis();
+}
+
+uint64_t MessageId::next() {
+    unsigned long elapsed = millis() - boot_ms;
+    if (elapsed >= 3600000UL) {
+        // Re-anchor hourly so the millis() wrap never shows up here
+        boot_epoch += elapsed / 1000;
+        boot_ms += (elapsed / 1000) * 1000;
+        elapsed %= 1000;
+    }
+    uint32_t now = boot_epoch + elapsed / 1000;
+
+    if (now > last_epoch) {
+        last_epoch = now;
+        counter = 0;
+    } else if (counter == 0xFFFF) {
+        last_epoch++;  // Borrow the next second rather than repeat an ID
+        counter = 0;
+    } else {
+        counter++;
+    }
+    return ((uint64_t) node_id << 48) | ((uint64_t) last_epoch << 16) | counter;
+}
+
+// ================== TEXT FORM ==================
+void MessageId::format(uint64_t id, char* out) {
+    for (int i = TEXT_LEN - 1; i >= 0; --i) {
+        out[i] = CROCKFORD[id & 0x1F];
+        id >>= 5;
+    }
+    out[TEXT_LEN] = 0;
+}
+
+static int8_t crockfordValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+    switch (c) {
+        case 'O': return 0;
+        case 'I':
+        case 'L': return 1;
+        case 'U': return -1;
+    }
+    const char* p = strchr(CROCKFORD + 10, c);
+    return (c && p) ? p - CROCKFORD : -1;
+}
+
+bool MessageId::parse(const char* text, size_t len, uint64_t& id) {
+    if (len != TEXT_LEN) return false;
+    uint64_t v = 0;
+    for (size_t i = 0; i < len; ++i) {
+        int8_t d = crockfordValue(text[i]);
+        if (d < 0 || (i == 0 && d > 0x0F)) return false;  // 65 bits would overflow
+        v = (v << 5) | (uint8_t) d;
+    }
+    id = v;
+    return true;
+}
+
+uint64_t MessageId::keyOf(const IdString& text) {
+    uint64_t id;
+    if (parse(text.c_str(), text.length(), id)) return id;
+
+    // Legacy ID: FNV-1a 64
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < text.length(); ++i) {
+        h = (h ^ (uint8_t) text[i]) * 1099511628211ULL;
+    }
+    return h;
+}
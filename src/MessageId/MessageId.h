@@ -0,0 +1,51 @@
+#pragma once
+#ifndef MESSAGE_ID_H
+#define MESSAGE_ID_H
+
+#include <Arduino.h>
+#include "../FixedString/FixedString.h"
+
+// ================== MessageId ===================
+// 64-bit IDs for messages and new channels:
+//
+//   | node (16) | epoch seconds (32) | counter (16) |
+//
+// node comes from the factory MAC, epoch from the RTC (ticked locally with
+// millis() between reads), and counter separates IDs within one second.
+// Generation never allocates and never goes backwards: if the clock steps
+// back or 65536 IDs are drawn in one second, the epoch field runs ahead.
+//
+// On the wire and on screen an ID is 13 Crockford base32 characters.
+// Anything else (IDs from older firmware) is keyed by a 64-bit FNV-1a hash,
+// so lookups and dedup work on integers either way.
+class MessageId {
+public:
+    static const uint8_t TEXT_LEN = 13;  // ceil(64 / 5)
+
+    // Seed the clock from the RTC; call after RTC_setup() and whenever the RTC
+    // is set (IDs still never go backwards)
+    static void begin(uint32_t epoch);
+
+    static uint64_t next();
+
+    // Writes TEXT_LEN characters plus a terminator
+    static void format(uint64_t id, char* out);
+    // Strict base32 parse (case-insensitive, I/L read as 1, O as 0)
+    static bool parse(const char* text, size_t len, uint64_t& id);
+
+    // Integer key for any ID text: the ID itself, or a hash for legacy IDs
+    static uint64_t keyOf(const IdString& text);
+
+    static uint16_t nodeOf(uint64_t id) { return id >> 48; }
+    static uint32_t epochOf(uint64_t id) { return (uint32_t) (id >> 16); }
+    static uint16_t node() { return node_id; }
+
+private:
+    static uint16_t node_id;
+    static uint32_t boot_epoch;      // RTC time at begin()
+    static unsigned long boot_ms;    // millis() at begin()
+    static uint32_t last_epoch;      // Epoch field of the last ID
+    static uint16_t counter;
+};
+
+#endif // MESSAGE_ID_H
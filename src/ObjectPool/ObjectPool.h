@@ -0,0 +1,124 @@
+#pragma once
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <Arduino.h>
+#include <new>
+#include <utility>
+
+// ================== PoolHandle ===================
+// Slot index plus the slot's generation when it was handed out. Once the
+// object is destroyed (or the slot reused) the handle resolves to nullptr
+// instead of dangling. generation 0 is the null handle.
+struct PoolHandle {
+    uint16_t index;
+    uint16_t generation;
+
+    PoolHandle() : index(0), generation(0) {}
+    PoolHandle(uint16_t i, uint16_t g) : index(i), generation(g) {}
+
+    bool isNull() const { return generation == 0; }
+    bool operator==(const PoolHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const PoolHandle& o) const { return !(*this == o); }
+};
+
+// ================== PoolStats ===================
+struct PoolStats {
+    uint16_t capacity;
+    uint16_t live;       // Objects currently allocated
+    uint16_t peak;       // High watermark of live
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t failures;   // create() calls refused because the pool was full
+    uint32_t bad_frees;  // destroy() of a foreign pointer or a free slot
+};
+
+// ================== ObjectPool ===================
+// Fixed-capacity typed pool on a static arena: N slots of sizeof(T), a LIFO
+// free list and per-slot generations. No heap traffic for the objects
+// themselves, and slots are uniform so the arena cannot fragment.
+template <typename T, uint16_t N>
+class ObjectPool {
+public:
+    ObjectPool() : free_head(0) {
+        for (uint16_t i = 0; i < N; ++i) {
+            next_free[i] = i + 1;
+            generation[i] = 1;
+            used[i] = false;
+        }
+        stat = PoolStats();
+        stat.capacity = N;
+    }
+
+    // Construct a T in a free slot; nullptr when the pool is exhausted
+    template <typename... Args>
+    T* create(Args&&... args) {
+        if (free_head >= N) {
+            stat.failures++;
+            return nullptr;
+        }
+        uint16_t i = free_head;
+        free_head = next_free[i];
+        used[i] = true;
+
+        stat.allocs++;
+        if (++stat.live > stat.peak) stat.peak = stat.live;
+        return new (slot(i)) T(std::forward<Args>(args)...);
+    }
+
+    // Destroy an object and return its slot; foreign pointers and double
+    // frees are counted and ignored
+    void destroy(T* obj) {
+        int i = indexOf(obj);
+        if (i < 0 || !used[i]) {
+            if (obj) stat.bad_frees++;
+            return;
+        }
+        obj->~T();
+        used[i] = false;
+        if (++generation[i] == 0) generation[i] = 1;
+        next_free[i] = free_head;
+        free_head = i;
+
+        stat.frees++;
+        stat.live--;
+    }
+
+    PoolHandle handleOf(const T* obj) const {
+        int i = indexOf(obj);
+        if (i < 0 || !used[i]) return PoolHandle();
+        return PoolHandle(i, generation[i]);
+    }
+
+    // Object behind a handle, or nullptr if it was destroyed since
+    T* get(PoolHandle h) const {
+        if (h.isNull() || h.index >= N || !used[h.index] || generation[h.index] != h.generation) {
+            return nullptr;
+        }
+        return (T*) slot(h.index);
+    }
+
+    bool owns(const T* obj) const { return indexOf(obj) >= 0; }
+    const PoolStats& stats() const { return stat; }
+    uint16_t available() const { return N - stat.live; }
+
+private:
+    alignas(T) uint8_t storage[N][sizeof(T)];
+    uint16_t next_free[N];
+    uint16_t generation[N];
+    bool used[N];
+    uint16_t free_head;
+    PoolStats stat;
+
+    void* slot(uint16_t i) const { return (void*) storage[i]; }
+
+    int indexOf(const T* obj) const {
+        const uint8_t* p = (const uint8_t*) obj;
+        if (p < storage[0] || p >= storage[0] + sizeof(storage)) return -1;
+        size_t offset = p - storage[0];
+        if (offset % sizeof(T)) return -1;
+        return offset / sizeof(T);
+    }
+};
+
+#endif // OBJECT_POOL_H
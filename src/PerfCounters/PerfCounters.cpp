@@ -0,0 +1,193 @@
+#include "PerfCounters.h"
+#include "../SerialTxHandler/SerialTxHandler.h"
+#include "../global_objects.h"
+#include "../InputLatency/InputLatency.h"
+#include "../PowerManager/PowerManager.h"
+#include "../KeypadHandler/KeypadHandler.h"
+
+PerfStat PerfCounters::stats[PERF_PROBES];
+uint32_t PerfCounters::cycles_per_us = 240;
+uint32_t PerfCounters::loop_counter = 0;
+uint32_t PerfCounters::packet_counter = 0;
+uint32_t PerfCounters::loops_per_second = 0;
+uint32_t PerfCounters::packets_per_second = 0;
+uint32_t PerfCounters::packets_total = 0;
+unsigned long PerfCounters::window_start = 0;
+uint32_t PerfCounters::batches_total = 0;
+uint16_t PerfCounters::batch_max = 0;
+uint32_t PerfCounters::drain_lines = 0;
+unsigned long PerfCounters::drain_start = 0;
+uint32_t PerfCounters::drain_peak_lines = 0;
+uint32_t PerfCounters::drain_peak_ms = 0;
+
+// ================== PerfStat ==================
+void PerfStat::add(uint32_t us) {
+    count++;
+    total_us += us;
+    if (us > max_us) max_us = us;
+
+    byte bucket = 0;
+    while (us > 1 && bucket < PERF_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    buckets[bucket]++;
+}
+
+uint32_t PerfStat::percentile_us(byte pct) const {
+    if (count == 0) return 0;
+    uint32_t target = (uint32_t) (((uint64_t) count * pct + 99) / 100);
+    uint32_t seen = 0;
+    for (byte i = 0; i < PERF_BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= target) return i < PERF_BUCKETS - 1 ? (2UL << i) - 1 : max_us;
+    }
+    return max_us;
+}
+
+// ================== PerfCounters ==================
+void PerfCounters::begin() {
+    cycles_per_us = ESP.getCpuFreqMHz();
+    if (cycles_per_us == 0) cycles_per_us = 240;
+    reset();
+}
+
+void PerfCounters::reset() {
+    memset(stats, 0, sizeof(stats));
+    loop_counter = 0;
+    packet_counter = 0;
+    window_start = millis();
+    batches_total = 0;
+    batch_max = 0;
+    drain_lines = 0;
+    drain_peak_lines = 0;
+    drain_peak_ms = 0;
+}
+
+void PerfCounters::record(byte probe, uint32_t start_cycles) {
+    if (probe >= PERF_PROBES) return;
+    // Unsigned subtraction handles cycle counter wrap (~17 s at 240 MHz)
+    uint32_t elapsed = ESP.getCycleCount() - start_cycles;
+    stats[probe].add(elapsed / cycles_per_us);
+    if (probe == PERF_LOOP) loop_counter++;
+}
+
+void PerfCounters::recordBatch(uint16_t lines, unsigned long start_ms, bool drained) {
+    if (lines == 0) return;
+    batches_total++;
+    if (lines > batch_max) batch_max = lines;
+
+    if (drain_lines == 0) drain_start = start_ms;
+    drain_lines += lines;
+    if (!drained) return;
+
+    if (drain_lines >= drain_peak_lines) {
+        drain_peak_lines = drain_lines;
+        drain_peak_ms = millis() - drain_start;
+    }
+    drain_lines = 0;
+}
+
+void PerfCounters::tick() {
+    unsigned long now = millis();
+    unsigned long elapsed = now - window_start;
+    if (elapsed < 1000) return;
+
+    loops_per_second   = (uint32_t) ((uint64_t) loop_counter * 1000 / elapsed);
+    packets_per_second = (uint32_t) ((uint64_t) packet_counter * 1000 / elapsed);
+    packets_total += packet_counter;
+    loop_counter = 0;
+    packet_counter = 0;
+    window_start = now;
+}
+
+const char* PerfCounters::probeName(byte probe) {
+    switch (probe) {
+        case PERF_LOOP:      return "loop";
+        case PERF_SERIAL_RX: return "serial_rx";
+        case PERF_CHAT_DRAW: return "chat_draw";
+        case PERF_NVS_WRITE: return "nvs_write";
+        case PERF_KEY_EVENT: return "key_event";
+    }
+    return "?";
+}
+
+uint32_t PerfCounters::heapFree() {
+    return ESP.getFreeHeap();
+}
+
+uint32_t PerfCounters::heapLargestBlock() {
+    return ESP.getMaxAllocHeap();
+}
+
+byte PerfCounters::heapFragmentation() {
+    uint32_t freeBytes = heapFree();
+    if (freeBytes == 0) return 0;
+    return 100 - (byte) ((uint64_t) heapLargestBlock() * 100 / freeBytes);
+}
+
+// ================== SERIAL DUMP ==================
+// One histogram as "[INFO] <tag> <name> n= avg= p90<= max= hist=b0,b1,..."
+static void dumpStat(const char* tag, const char* name, const PerfStat& s) {
+    char line[160];
+    int len = snprintf(line, sizeof(line), "[INFO] %s %s n=%lu avg=%luus p90<=%luus max=%luus hist=",
+                       tag, name, (unsigned long) s.count, (unsigned long) s.avg_us(),
+                       (unsigned long) s.percentile_us(90), (unsigned long) s.max_us);
+    for (byte b = 0; b < PERF_BUCKETS && len < (int) sizeof(line) - 12; ++b) {
+        len += snprintf(line + len, sizeof(line) - len, b ? ",%lu" : "%lu",
+                        (unsigned long) s.buckets[b]);
+    }
+    SerialTxHandler::enqueueLine(line, len);
+}
+
+void PerfCounters::dump() {
+    char line[160];
+    int len;
+
+    len = snprintf(line, sizeof(line),
+                   "[INFO] PERF rates loop_hz=%lu pkt_s=%lu pkt_total=%lu heap_free=%lu heap_max_block=%lu",
+                   (unsigned long) loops_per_second, (unsigned long) packets_per_second,
+                   (unsigned long) packets_total,
+                   (unsigned long) heapFree(), (unsigned long) heapLargestBlock());
+    SerialTxHandler::enqueueLine(line, len);
+
+    for (byte p = 0; p < PERF_PROBES; ++p) dumpStat("PERF", probeName(p), stats[p]);
+    for (byte s = 0; s < LAT_STAGES; ++s) {
+        dumpStat("KEYLAT", InputLatency::stageName(s), InputLatency::stat(s));
+    }
+
+    // Object pools: a live count that keeps growing across restores is a leak
+    const char* poolNames[] = { "users", "channels", "messages" };
+    const PoolStats* pools[] = { &user_pool.stats(), &channel_pool.stats(), &message_pool.stats() };
+    for (byte i = 0; i < 3; ++i) {
+        const PoolStats& ps = *pools[i];
+        len = snprintf(line, sizeof(line),
+                       "[INFO] POOL %s live=%u/%u peak=%u allocs=%lu frees=%lu fail=%lu bad_free=%lu",
+                       poolNames[i], ps.live, ps.capacity, ps.peak,
+                       (unsigned long) ps.allocs, (unsigned long) ps.frees,
+                       (unsigned long) ps.failures, (unsigned long) ps.bad_frees);
+        SerialTxHandler::enqueueLine(line, len);
+    }
+    len = snprintf(line, sizeof(line), "[INFO] POOL heap_frag=%u%%", heapFragmentation());
+    SerialTxHandler::enqueueLine(line, len);
+
+    len = snprintf(line, sizeof(line), "[INFO] PERF ingest batches=%lu max_batch=%u backlog=%lu lines in %lums",
+                   (unsigned long) batches_total, (unsigned) batch_max,
+                   (unsigned long) drain_peak_lines, (unsigned long) drain_peak_ms);
+    SerialTxHandler::enqueueLine(line, len);
+
+    len = snprintf(line, sizeof(line), "[INFO] PERF power wakes=%lu uart_wakes=%lu damaged_lines=%lu",
+                   PowerManager::wakeCount(), PowerManager::uartWakes(), PowerManager::damagedLines());
+    SerialTxHandler::enqueueLine(line, len);
+
+    len = snprintf(line, sizeof(line), "[INFO] PERF tx pending=%u hwm=%u queued=%lu dropped=%lu packets_dropped=%lu",
+                   (unsigned) SerialTxHandler::pending(), (unsigned) SerialTxHandler::highWatermark(),
+                   (unsigned long) SerialTxHandler::queuedLines(),
+                   (unsigned long) SerialTxHandler::droppedLines(),
+                   (unsigned long) SerialTxHandler::droppedPackets());
+    SerialTxHandler::enqueueLine(line, len);
+
+    len = snprintf(line, sizeof(line), "[INFO] PERF send_handler last=%luus max=%luus",
+                   KeypadHandler::send_handler_us, KeypadHandler::send_handler_max_us);
+    SerialTxHandler::enqueueLine(line, len);
+}
@@ -0,0 +1,124 @@
+#pragma once
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <Arduino.h>
+
+// Uncomment to compile all probes out (PERF_* macros become no-ops)
+// #define DISABLE_PERF
+
+// Uncomment (or build with -DENABLE_TEST_HOOKS) to accept the serial test
+// commands DIAG (counter dump) and KEYS||<keys> (key replay). Off by default:
+// any line on the UART could otherwise drive the UI.
+// #define ENABLE_TEST_HOOKS
+
+// ================== PROBE IDENTIFIERS ==================
+const byte PERF_LOOP      = 0;  // One pass of loop()
+const byte PERF_SERIAL_RX = 1;  // SerialIngest::listen()
+const byte PERF_CHAT_DRAW = 2;  // TFTHandler::drawChatMessages()
+const byte PERF_NVS_WRITE = 3;  // PreferencesHandler writes
+const byte PERF_KEY_EVENT = 4;  // Keypad event callback, event to return
+const byte PERF_PROBES    = 5;
+
+// Log2 histogram: bucket i counts samples in [2^i, 2^(i+1)) microseconds;
+// the last bucket also takes everything longer (full repaints can exceed 65 ms)
+const byte PERF_BUCKETS = 16;
+
+// ----- PerfStat -----
+// Fixed-size timing aggregate for one probe
+struct PerfStat {
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t buckets[PERF_BUCKETS];
+
+    void add(uint32_t us);
+    uint32_t avg_us() const { return count ? (uint32_t) (total_us / count) : 0; }
+    // Upper bound of the bucket holding the given percentile (0-100); the
+    // open-ended last bucket reports the maximum
+    uint32_t percentile_us(byte pct) const;
+};
+
+// ================== PerfCounters ===================
+// Lightweight runtime instrumentation based on the CPU cycle counter.
+// Probes record into fixed histograms; rates are recomputed once a second.
+class PerfCounters {
+public:
+    static void begin();
+
+    // Record a probe duration given its start cycle count
+    static void record(byte probe, uint32_t start_cycles);
+
+    // Count one accepted packet (for packets/s)
+    static void countPacket() { packet_counter++; }
+
+    // One serial ingest batch of lines, begun at start_ms. drained is false
+    // when the time budget ran out with lines still queued; such batches and
+    // the one that finally empties the RX buffer form one backlog drain.
+    static void recordBatch(uint16_t lines, unsigned long start_ms, bool drained);
+    static uint32_t batchesTotal()    { return batches_total; }
+    static uint16_t batchMax()        { return batch_max; }
+    // Largest backlog drained since reset: lines, and ms from first to last
+    static uint32_t drainPeakLines()  { return drain_peak_lines; }
+    static uint32_t drainPeakMs()     { return drain_peak_ms; }
+
+    // Update per-second rates (call once per loop)
+    static void tick();
+
+    static const PerfStat& stat(byte probe) { return stats[probe]; }
+    static const char* probeName(byte probe);
+    static uint32_t loopsPerSecond()   { return loops_per_second; }
+    static uint32_t packetsPerSecond() { return packets_per_second; }
+    static uint32_t packetsTotal()     { return packets_total; }
+
+    // Heap state (bytes)
+    static uint32_t heapFree();
+    static uint32_t heapLargestBlock();
+
+    // Percent of free heap not available as one block (0 = unfragmented)
+    static byte heapFragmentation();
+
+    // Queue a full dump over serial as [INFO] lines
+    static void dump();
+
+    // Clear all histograms and counters
+    static void reset();
+
+private:
+    static PerfStat stats[PERF_PROBES];
+    static uint32_t cycles_per_us;
+    static uint32_t loop_counter;
+    static uint32_t packet_counter;
+    static uint32_t loops_per_second;
+    static uint32_t packets_per_second;
+    static uint32_t packets_total;
+    static unsigned long window_start;
+
+    static uint32_t batches_total;
+    static uint16_t batch_max;
+    static uint32_t drain_lines;         // Lines of the backlog being drained
+    static unsigned long drain_start;
+    static uint32_t drain_peak_lines;
+    static uint32_t drain_peak_ms;
+};
+
+// ----- PerfScope -----
+// Records the lifetime of the enclosing block into a probe
+class PerfScope {
+public:
+    explicit PerfScope(byte probe) : probe(probe), start(ESP.getCycleCount()) {}
+    ~PerfScope() { PerfCounters::record(probe, start); }
+private:
+    byte probe;
+    uint32_t start;
+};
+
+#ifdef DISABLE_PERF
+  #define PERF_SCOPE(probe)
+  #define PERF_COUNT_PACKET()
+#else
+  #define PERF_SCOPE(probe)   PerfScope _perf_scope_##probe(probe)
+  #define PERF_COUNT_PACKET() PerfCounters::countPacket()
+#endif
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,231 @@
+#include "PowerManager.h"
+#include "../PreferencesHandler.h"
+#include "../SerialTxHandler/SerialTxHandler.h"
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include <driver/uart.h>
+
+// ILI9341 power commands
+#define ILI_SLPIN   0x10
+#define ILI_SLPOUT  0x11
+#define ILI_DISPOFF 0x28
+#define ILI_DISPON  0x29
+
+// LEDC channel driving the backlight (only with TFT_BL defined)
+#define BL_CHANNEL  7
+
+TFT_eSPI* PowerManager::tft = nullptr;
+const byte* PowerManager::row_pins = nullptr;
+const byte* PowerManager::col_pins = nullptr;
+byte PowerManager::row_count = 0;
+byte PowerManager::col_count = 0;
+
+byte PowerManager::state = PWR_ACTIVE;
+unsigned long PowerManager::dim_after = PowerManager::DEFAULT_DIM_S * 1000;
+unsigned long PowerManager::blank_after = PowerManager::DEFAULT_BLANK_S * 1000;
+unsigned long PowerManager::last_activity = 0;
+unsigned long PowerManager::state_since = 0;
+unsigned long PowerManager::wake_time = 0;
+unsigned long PowerManager::wakes = 0;
+unsigned long PowerManager::state_ms[PWR_STATES] = {0};
+unsigned long PowerManager::last_rx = 0;
+bool PowerManager::uart_woke = false;
+unsigned long PowerManager::uart_wakes = 0;
+unsigned long PowerManager::damaged_lines = 0;
+
+// ================== CONFIGURATION ==================
+void PowerManager::begin(TFT_eSPI* _tft,
+                         const byte* rowPins, byte rows,
+                         const byte* colPins, byte cols) {
+    tft = _tft;
+    row_pins = rowPins;
+    row_count = rows;
+    col_pins = colPins;
+    col_count = cols;
+
+    dim_after   = (unsigned long) PreferencesHandler::getInt("pwr_dim_s", DEFAULT_DIM_S) * 1000;
+    blank_after = (unsigned long) PreferencesHandler::getInt("pwr_off_s", DEFAULT_BLANK_S) * 1000;
+
+#ifdef TFT_BL
+    ledcSetup(BL_CHANNEL, 5000, 8);
+    ledcAttachPin(TFT_BL, BL_CHANNEL);
+#endif
+    setBacklight(255);
+
+    state = PWR_ACTIVE;
+    last_activity = state_since = millis();
+}
+
+void PowerManager::setTimeouts(unsigned long dim_s, unsigned long blank_s) {
+    dim_after = dim_s * 1000;
+    blank_after = blank_s * 1000;
+    PreferencesHandler::setInt("pwr_dim_s", (int) dim_s);
+    PreferencesHandler::setInt("pwr_off_s", (int) blank_s);
+}
+
+// ================== ACTIVITY ==================
+bool PowerManager::activity() {
+    unsigned long now = millis();
+    last_activity = now;
+
+    if (state != PWR_ACTIVE) {
+        bool wasOn = displayOn();
+        enter(PWR_ACTIVE);
+        if (!wasOn) {
+            wake_time = now;
+            wakes++;
+            return false;
+        }
+        return true;
+    }
+
+    // Swallow the rest of the key that woke the panel
+    return !(wakes && now - wake_time < WAKE_GUARD_MS);
+}
+
+bool PowerManager::takeWakeLine() {
+    bool woke = uart_woke;
+    uart_woke = false;
+    return woke;
+}
+
+// ================== STATE MACHINE ==================
+void PowerManager::update() {
+    unsigned long idle = millis() - last_activity;
+
+    switch (state) {
+        case PWR_ACTIVE:
+        case PWR_DIM:
+            if (blank_after && idle >= blank_after) {
+                enter(PWR_BLANK);
+            }
+#ifdef TFT_BL
+            else if (state == PWR_ACTIVE && dim_after && idle >= dim_after) {
+                enter(PWR_DIM);
+            }
+#endif
+            break;
+        case PWR_BLANK:
+            lightSleep();
+            break;
+    }
+}
+
+void PowerManager::enter(byte next) {
+    unsigned long now = millis();
+    state_ms[state] += now - state_since;
+    state_since = now;
+
+    byte prev = state;
+    state = next;
+
+    switch (next) {
+        case PWR_ACTIVE:
+            if (prev == PWR_BLANK) panelSleep(false);
+            setBacklight(255);
+            break;
+        case PWR_DIM:
+            setBacklight(DIM_LEVEL);
+            break;
+        case PWR_BLANK:
+            setBacklight(0);
+            panelSleep(true);
+            break;
+    }
+}
+
+// ================== HARDWARE ==================
+void PowerManager::setBacklight(byte level) {
+#ifdef TFT_BL
+    ledcWrite(BL_CHANNEL, level);
+#else
+    (void) level;  // No backlight pin: it stays lit, PWR_BLANK only turns the panel off
+#endif
+}
+
+void PowerManager::panelSleep(bool sleep) {
+    if (!tft) return;
+    if (sleep) {
+        tft->writecommand(ILI_DISPOFF);
+        tft->writecommand(ILI_SLPIN);
+        delay(5);
+    } else {
+        // GRAM survives sleep-in, so the last frame comes back as-is
+        tft->writecommand(ILI_SLPOUT);
+        delay(5);  // ILI9341 needs 5 ms after SLPOUT before the next command
+        tft->writecommand(ILI_DISPON);
+    }
+}
+
+void PowerManager::lightSleep() {
+    // Stay awake while there is work queued in either direction, and for a
+    // while after RX so a burst isn't cut by another wake
+    if (Serial.available() || SerialTxHandler::pending()) return;
+    if (millis() - last_rx < RX_AWAKE_MS) return;
+    Serial.flush();
+
+    // Keypad matrix: columns driven LOW, so a key pulls its row LOW
+    for (byte c = 0; c < col_count; ++c) {
+        pinMode(col_pins[c], OUTPUT);
+        digitalWrite(col_pins[c], LOW);
+    }
+    for (byte r = 0; r < row_count; ++r) {
+        pinMode(row_pins[r], INPUT_PULLUP);
+        gpio_wakeup_enable((gpio_num_t) row_pins[r], GPIO_INTR_LOW_LEVEL);
+    }
+#ifdef TOUCH_IRQ
+    // PENIRQ goes LOW while the panel is pressed
+    gpio_wakeup_enable((gpio_num_t) TOUCH_IRQ, GPIO_INTR_LOW_LEVEL);
+#endif
+    esp_sleep_enable_gpio_wakeup();
+
+    uart_set_wakeup_threshold(UART_NUM_0, 3);
+    esp_sleep_enable_uart_wakeup(0);
+    esp_sleep_enable_timer_wakeup((uint64_t) SLEEP_TIMER_MS * 1000);
+
+    unsigned long start = millis();
+    esp_light_sleep_start();
+    unsigned long slept = millis() - start;
+
+    // Sleep time is reported separately from the blank state
+    state_ms[PWR_SLEEP] += slept;
+    state_since += slept;
+
+    for (byte r = 0; r < row_count; ++r) {
+        gpio_wakeup_disable((gpio_num_t) row_pins[r]);
+    }
+#ifdef TOUCH_IRQ
+    gpio_wakeup_disable((gpio_num_t) TOUCH_IRQ);
+#endif
+    // Keypad drives the columns itself while scanning
+    for (byte c = 0; c < col_count; ++c) {
+        pinMode(col_pins[c], INPUT);
+    }
+
+    esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    if (cause == ESP_SLEEP_WAKEUP_GPIO) {
+        activity();
+    } else if (cause == ESP_SLEEP_WAKEUP_UART) {
+        uart_wakes++;
+        uart_woke = true;
+        rxActivity();
+    }
+}
+
+// ================== REPORTING ==================
+unsigned long PowerManager::timeIn(byte s) {
+    if (s >= PWR_STATES) return 0;
+    unsigned long t = state_ms[s];
+    if (s == state) t += millis() - state_since;
+    return t;
+}
+
+const char* PowerManager::stateName(byte s) {
+    switch (s) {
+        case PWR_ACTIVE: return "active";
+        case PWR_DIM:    return "dim";
+        case PWR_BLANK:  return "blank";
+        case PWR_SLEEP:  return "sleep";
+    }
+    return "?";
+}
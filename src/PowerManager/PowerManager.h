@@ -0,0 +1,105 @@
+#pragma once
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+// ================== POWER STATES ==================
+const byte PWR_ACTIVE = 0;  // Backlight full, loop free-running
+const byte PWR_DIM    = 1;  // Backlight dimmed (needs TFT_BL)
+const byte PWR_BLANK  = 2;  // Display off, panel in sleep-in; drawing skipped
+const byte PWR_SLEEP  = 3;  // CPU in light sleep (only entered from PWR_BLANK)
+const byte PWR_STATES = 4;
+
+// ================== PowerManager ===================
+// Idle power management for battery units. After inactivity the backlight
+// is dimmed, then the ILI9341 is switched off (DISPOFF + SLPIN, GRAM is
+// retained) and the loop drops into light sleep between events. Dimming
+// and switching the backlight off need its pin as TFT_BL (platformio.ini);
+// without it the backlight stays lit and the dim state is skipped.
+//
+// Wake sources while sleeping:
+//   - keypad: columns are driven LOW so any key pulls its row input LOW
+//   - touch: PENIRQ (TOUCH_IRQ) held LOW by a press
+//   - UART0 RX: the first bytes of the waking line are consumed by the wake
+//     detector, so that line arrives without its start. After any RX the
+//     loop stays awake for RX_AWAKE_MS, so the rest of a burst is received
+//     whole; waking lines that are then rejected are counted as damaged.
+//   - timer: periodic wake so telemetry and the clock keep running
+//
+// Waking restores the last frame from GRAM (SLPOUT + DISPON); regions
+// invalidated while blank are rendered on the next frame.
+class PowerManager {
+public:
+    static constexpr unsigned long DEFAULT_DIM_S   = 30;   // 0 = never dim
+    static constexpr unsigned long DEFAULT_BLANK_S = 120;  // 0 = never blank
+    static constexpr unsigned long SLEEP_TIMER_MS  = 1000; // Max light-sleep slice
+    static constexpr unsigned long WAKE_GUARD_MS   = 300;  // Keys swallowed after wake
+    static constexpr unsigned long RX_AWAKE_MS     = 3000; // No light sleep after serial RX
+    static constexpr byte DIM_LEVEL = 24;                  // Backlight duty when dimmed
+
+    // Load timeouts from preferences; pins are the keypad matrix used as wake source
+    static void begin(TFT_eSPI* tft,
+                      const byte* rowPins, byte rows,
+                      const byte* colPins, byte cols);
+
+    // Change timeouts at runtime and persist them (seconds, 0 = disabled)
+    static void setTimeouts(unsigned long dim_s, unsigned long blank_s);
+
+    // User input happened. Returns false if the event only woke the display
+    // and should not be acted on.
+    static bool activity();
+
+    // Serial bytes arrived: hold off light sleep for RX_AWAKE_MS (does not
+    // wake the display)
+    static void rxActivity() { last_rx = millis(); }
+
+    // A complete line was received: true if it started right after a UART
+    // wake and so may have lost its first bytes (clears the mark)
+    static bool takeWakeLine();
+
+    // A waking line was rejected by the parser
+    static void countDamagedLine() { damaged_lines++; }
+    static unsigned long uartWakes() { return uart_wakes; }
+    static unsigned long damagedLines() { return damaged_lines; }
+
+    // Step the idle state machine; may light-sleep (call at the end of loop)
+    static void update();
+
+    // True while the panel is showing (ACTIVE or DIM)
+    static bool displayOn() { return state < PWR_BLANK; }
+    static byte currentState() { return state; }
+
+    // Milliseconds spent in each state since boot
+    static unsigned long timeIn(byte s);
+    static const char* stateName(byte s);
+    static unsigned long wakeCount() { return wakes; }
+
+private:
+    static TFT_eSPI* tft;
+    static const byte* row_pins;
+    static const byte* col_pins;
+    static byte row_count;
+    static byte col_count;
+
+    static byte state;
+    static unsigned long dim_after;
+    static unsigned long blank_after;
+    static unsigned long last_activity;
+    static unsigned long state_since;
+    static unsigned long wake_time;
+    static unsigned long wakes;
+    static unsigned long state_ms[PWR_STATES];
+    static unsigned long last_rx;
+    static bool uart_woke;              // Next line started with the wake
+    static unsigned long uart_wakes;
+    static unsigned long damaged_lines;
+
+    static void enter(byte next);
+    static void setBacklight(byte level);
+    static void panelSleep(bool sleep);
+    static void lightSleep();
+};
+
+#endif // POWER_MANAGER_H
@@ -7,6 +7,7 @@
 #include <Preferences.h>
 #include "global_objects.h"
 #include "DebugMacros.h"
+#include "PerfCounters/PerfCounters.h"
 
 
 // ================== PreferencesHandler ===================
@@ -26,6 +27,7 @@ public:
     // ------------------ String Preferences ----------------
     // Save a string value
     static void setString(const char* key, const String& value) {
+        PERF_SCOPE(PERF_NVS_WRITE);
         prefs.putString(key, value);
     }
 
@@ -37,6 +39,7 @@ public:
     // ------------------ Integer Preferences ----------------
     // Save an integer value
     static void setInt(const char* key, int value) {
+        PERF_SCOPE(PERF_NVS_WRITE);
         prefs.putInt(key, value);
     }
 
@@ -48,6 +51,7 @@ public:
     // ------------------ Boolean Preferences ----------------
     // Save a boolean value
     static void setBool(const char* key, bool value) {
+        PERF_SCOPE(PERF_NVS_WRITE);
         prefs.putBool(key, value);
     }
 
@@ -56,6 +60,19 @@ public:
         return prefs.getBool(key, defaultValue);
     }
 
+    // ------------------ Binary Preferences ----------------
+    // Save a small fixed-size blob
+    static void setBytes(const char* key, const void* data, size_t len) {
+        PERF_SCOPE(PERF_NVS_WRITE);
+        prefs.putBytes(key, data, len);
+    }
+
+    // Load a blob; false (data untouched) unless exactly len bytes are stored
+    static bool getBytes(const char* key, void* data, size_t len) {
+        if (prefs.getBytesLength(key) != len) return false;
+        return prefs.getBytes(key, data, len) == len;
+    }
+
     // ------------------ Utility Methods -------------------
     // Clear all saved preferences in this namespace
     static void clearAll() {
@@ -86,13 +103,14 @@ static void saveChannels(const std::vector<Channel*>& channels) {
     String serialized = "";
     for (auto* ch : channels) {
         if (!ch) continue;
-        serialized += ch->ID + "," + ch->name + "," + String(ch->channel_type) + ";";
+        serialized += String(ch->ID.c_str()) + "," + ch->name.c_str() + "," + String(ch->channel_type) + ";";
     }
     setString("channels", serialized);
 }
 
-// Load channels from NVS and rebuild them into memory
+// Load channels from NVS and rebuild them into memory (replaces all channels)
 static void loadChannels(std::vector<Channel*>& channels) {
+    clearChannels();
     channels.clear();
     String data = getString("channels", "");
     if (data.isEmpty()) return;
@@ -112,7 +130,8 @@ static void loadChannels(std::vector<Channel*>& channels) {
         String name = entry.substring(c1 + 1, c2);
         byte type = entry.substring(c2 + 1).toInt();
 
-        channels.push_back(new Channel(type, name, id));
+        Channel* ch = createChannel(type, name, id);
+        if (ch) channels.push_back(ch);
     }
 }
 
@@ -121,13 +140,14 @@ static void saveUsers(const std::vector<User*>& users) {
     String serialized = "";
     for (auto* u : users) {
         if (!u) continue;
-        serialized += u->ID + "," + u->username + ";";
+        serialized += String(u->ID.c_str()) + "," + u->username.c_str() + ";";
     }
     setString("users", serialized);
 }
 
-// Load users from NVS
+// Load users from NVS (replaces all users)
 static void loadUsers(std::vector<User*>& users) {
+    clearUsers();
     users.clear();
     String data = getString("users", "");
     if (data.isEmpty()) return;
@@ -145,7 +165,8 @@ static void loadUsers(std::vector<User*>& users) {
         String id = entry.substring(0, c1);
         String name = entry.substring(c1 + 1);
 
-        users.push_back(new User(id, name));
+        User* u = createUser(id, name);
+        if (u) users.push_back(u);
     }
 }
 
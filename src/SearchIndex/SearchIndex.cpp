@@ -0,0 +1,364 @@
+#include "SearchIndex.h"
+#include "../HistoryStore/HistoryStore.h"
+#include "../TextCodec/TextCodec.h"
+#include <algorithm>
+
+static_assert((SearchIndex::BUCKETS & (SearchIndex::BUCKETS - 1)) == 0,
+              "BUCKETS must be a power of two");
+
+SearchIndex::Bucket SearchIndex::buckets[SearchIndex::BUCKETS];
+SearchIndex::Block SearchIndex::blocks[SearchIndex::BLOCKS];
+SearchIndex::DocRef SearchIndex::docs[SearchIndex::MAX_DOCS];
+uint16_t SearchIndex::ring_next = 0;
+uint16_t SearchIndex::blocks_live = 0;
+uint32_t SearchIndex::next_doc = 0;
+uint32_t SearchIndex::horizon = 0;
+
+SearchHit SearchIndex::hits[SearchIndex::MAX_RESULTS];
+byte SearchIndex::hit_count = 0;
+unsigned long SearchIndex::last_query_us = 0;
+uint32_t SearchIndex::covered = 0;
+uint32_t SearchIndex::stored = 0;
+
+const char* SearchIndex::scan_query = nullptr;
+SearchHit SearchIndex::scan_hits[SearchIndex::SCAN_PAGE];
+byte SearchIndex::scan_count = 0;
+
+// ================== HELPERS ==================
+static inline char fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+// Case-insensitive (ASCII) substring test; needle is already folded
+static bool containsFolded(const char* hay, const char* needle) {
+    for (; *hay; ++hay) {
+        const char* h = hay;
+        const char* n = needle;
+        while (*n && *h && fold(*h) == *n) { ++h; ++n; }
+        if (!*n) return true;
+    }
+    return false;
+}
+
+static const char* senderName(const IdString& sender_id) {
+    User* u = findUserById(sender_id);
+    return u ? u->username.c_str() : sender_id.c_str();
+}
+
+uint16_t SearchIndex::bucketOf(const char* s) {
+    uint32_t h = 2166136261u;
+    for (byte i = 0; i < 3; ++i) h = (h ^ (uint8_t) fold(s[i])) * 16777619u;
+    return h & (BUCKETS - 1);
+}
+
+// ================== INGEST ==================
+void SearchIndex::begin() {
+    static_assert(sizeof(Block) == BLOCK_SIZE, "posting blocks must stay BLOCK_SIZE bytes");
+    memset(buckets, 0xFF, sizeof(buckets));
+    for (Block& b : blocks) b.bucket = NONE;
+    ring_next = blocks_live = 0;
+    next_doc = horizon = 0;
+    hit_count = 0;
+
+    for (Channel* ch : all_channels) {
+        if (!ch) continue;
+        uint32_t first = ch->history_count > BOOT_RECORDS ? ch->history_count - BOOT_RECORDS : 0;
+        HistoryStore::scan(ch, first, onRecord);
+    }
+}
+
+void SearchIndex::onRecord(Channel* channel, uint32_t index, const HistoryRecord& r) {
+    add(channel, index, r.text, r.sender_id);
+}
+
+void SearchIndex::add(const Channel* channel, uint32_t record,
+                      const char* text, const IdString& sender_id) {
+    uint32_t doc = next_doc++;
+    docs[doc % MAX_DOCS].channel_hash = channel->ID.hash();
+    docs[doc % MAX_DOCS].record = record;
+
+    size_t len;
+    const char* plain = TextCodec::view(text, strlen(text), len);
+    indexText(plain, len, doc);
+    const char* name = senderName(sender_id);
+    indexText(name, strlen(name), doc);
+}
+
+void SearchIndex::indexText(const char* text, size_t len, uint32_t doc) {
+    for (size_t i = 0; i + 3 <= len; ++i) post(bucketOf(text + i), doc);
+}
+
+void SearchIndex::post(uint16_t bucket, uint32_t doc) {
+    Bucket& bk = buckets[bucket];
+    uint32_t prev = 0;
+    if (bk.tail != NONE) {
+        prev = blocks[bk.tail].last;
+        if (prev == doc && blocks[bk.tail].used) return;  // Trigram repeats within the message
+    }
+
+    uint8_t enc[5];
+    size_t n = 0;
+    for (uint32_t delta = doc - prev; ; delta >>= 7) {
+        enc[n++] = (delta & 0x7F) | (delta > 0x7F ? 0x80 : 0);
+        if (delta <= 0x7F) break;
+    }
+
+    if (bk.tail == NONE || blocks[bk.tail].used + n > BLOCK_DATA) {
+        // The new block starts from prev, so it decodes on its own even if
+        // allocBlock just evicted the rest of this chain
+        uint16_t b = allocBlock(bucket);
+        blocks[b].base = blocks[b].last = prev;
+        if (bk.tail != NONE) blocks[bk.tail].next = b;
+        else                 bk.head = b;
+        bk.tail = b;
+    }
+
+    Block& blk = blocks[bk.tail];
+    memcpy(blk.data + blk.used, enc, n);
+    blk.used += n;
+    blk.last = doc;
+}
+
+// Oldest block in the arena is always the head of its chain: take it over
+uint16_t SearchIndex::allocBlock(uint16_t bucket) {
+    uint16_t b = ring_next;
+    ring_next = (ring_next + 1) % BLOCKS;
+
+    Block& blk = blocks[b];
+    if (blk.bucket != NONE) {
+        Bucket& owner = buckets[blk.bucket];
+        owner.head = blk.next;
+        if (owner.head == NONE) owner.tail = NONE;
+        horizon = max(horizon, blk.last + 1);
+    } else {
+        blocks_live++;
+    }
+    blk.bucket = bucket;
+    blk.next = NONE;
+    blk.used = 0;
+    return b;
+}
+
+void SearchIndex::shift(const Channel* channel, uint32_t dropped) {
+    uint32_t h = channel->ID.hash();
+    for (DocRef& d : docs) {
+        if (d.channel_hash != h || d.record == UINT32_MAX) continue;
+        d.record = d.record < dropped ? UINT32_MAX : d.record - dropped;
+    }
+}
+
+// ================== QUERY ==================
+// Step through a chain; block == NONE when exhausted
+bool SearchIndex::nextDoc(uint16_t& block, size_t& pos, uint32_t& doc) {
+    while (block != NONE) {
+        const Block& blk = blocks[block];
+        if (pos < blk.used) {
+            uint32_t delta = 0;
+            for (byte bits = 0; pos < blk.used; bits += 7) {
+                uint8_t b = blk.data[pos++];
+                delta |= (uint32_t) (b & 0x7F) << bits;
+                if (!(b & 0x80)) break;
+            }
+            doc += delta;
+            return true;
+        }
+        block = blk.next;
+        pos = 0;
+        if (block != NONE) doc = blocks[block].base;
+    }
+    return false;
+}
+
+// Encoded postings of a list; one varint per doc, so it orders lists by length
+size_t SearchIndex::listBytes(uint16_t bucket) {
+    size_t bytes = 0;
+    for (uint16_t b = buckets[bucket].head; b != NONE; b = blocks[b].next) bytes += blocks[b].used;
+    return bytes;
+}
+
+byte SearchIndex::search(const String& query) {
+    unsigned long start = micros();
+    hit_count = 0;
+    covered = stored = 0;
+
+    char q[32];
+    size_t n = 0;
+    for (size_t i = 0; i < query.length() && n < sizeof(q) - 1; ++i) q[n++] = fold(query[i]);
+    q[n] = 0;
+    if (n < 3) return 0;
+
+    // Distinct trigram lists of the query
+    uint16_t lists[16];
+    byte list_count = 0;
+    for (size_t i = 0; i + 3 <= n && list_count < 16; ++i) {
+        uint16_t b = bucketOf(q + i);
+        if (std::find(lists, lists + list_count, b) == lists + list_count) lists[list_count++] = b;
+    }
+
+    // The shortest list drives: its newest MAX_CANDIDATES docs are the
+    // candidates, so the rarest trigram bounds both the work and the cap
+    byte shortest = 0;
+    size_t shortest_bytes = listBytes(lists[0]);
+    for (byte l = 1; l < list_count && shortest_bytes > 0; ++l) {
+        size_t bytes = listBytes(lists[l]);
+        if (bytes < shortest_bytes) {
+            shortest = l;
+            shortest_bytes = bytes;
+        }
+    }
+    std::swap(lists[0], lists[shortest]);
+
+    // Candidates: the newest MAX_CANDIDATES docs of the driving list
+    static uint32_t cand[MAX_CANDIDATES];
+    size_t total = 0;
+    uint16_t block = buckets[lists[0]].head;
+    size_t pos = 0;
+    uint32_t doc = block != NONE ? blocks[block].base : 0;
+    while (nextDoc(block, pos, doc)) cand[total++ % MAX_CANDIDATES] = doc;
+    size_t count = min(total, (size_t) MAX_CANDIDATES);
+    if (total > MAX_CANDIDATES) {
+        std::rotate(cand, cand + total % MAX_CANDIDATES, cand + MAX_CANDIDATES);
+    }
+    // Docs older than the oldest candidate are never looked at
+    uint32_t floor_doc = total > MAX_CANDIDATES ? cand[0] : 0;
+
+    // Intersect with the other lists (all ascending)
+    for (byte l = 1; l < list_count && count > 0; ++l) {
+        block = buckets[lists[l]].head;
+        pos = 0;
+        doc = block != NONE ? blocks[block].base : 0;
+        size_t kept = 0;
+        size_t i = 0;
+        bool more = nextDoc(block, pos, doc);
+        while (i < count && more) {
+            if (doc < cand[i])      more = nextDoc(block, pos, doc);
+            else if (doc > cand[i]) i++;
+            else {
+                cand[kept++] = cand[i++];
+                more = nextDoc(block, pos, doc);
+            }
+        }
+        count = kept;
+    }
+
+    // Confirm against the stored text, newest first
+    for (size_t i = count; i-- > 0 && hit_count < MAX_RESULTS; ) {
+        if (verify(cand[i], q, hits[hit_count])) hit_count++;
+    }
+
+    for (Channel* ch : all_channels) {
+        if (ch) stored += ch->history_count;
+    }
+    if (hit_count < MAX_RESULTS) scanOlder(q, floor_doc);
+    if (hit_count == MAX_RESULTS) covered = 0;
+
+    last_query_us = micros() - start;
+    return hit_count;
+}
+
+bool SearchIndex::verify(uint32_t doc, const char* query, SearchHit& hit) {
+    if (next_doc - doc > MAX_DOCS) return false;  // Doc map slot reused
+    const DocRef& ref = docs[doc % MAX_DOCS];
+    if (ref.record == UINT32_MAX) return false;
+
+    Channel* channel = nullptr;
+    for (Channel* ch : all_channels) {
+        if (ch && ch->ID.hash() == ref.channel_hash) {
+            channel = ch;
+            break;
+        }
+    }
+    if (!channel) return false;
+
+    static HistoryRecord r;
+    if (!HistoryStore::readRecord(channel, ref.record, r)) return false;
+    return match(channel, ref.record, r, query, hit);
+}
+
+bool SearchIndex::match(Channel* channel, uint32_t record, const HistoryRecord& r,
+                        const char* query, SearchHit& hit) {
+    size_t len;
+    const char* text = TextCodec::view(r.text, strnlen(r.text, sizeof(r.text)), len);
+    IdString sender(r.sender_id);
+    const char* name = senderName(sender);
+    if (!containsFolded(text, query) && !containsFolded(name, query)) return false;
+
+    hit.channel = channel_pool.handleOf(channel);
+    hit.record = record;
+    snprintf(hit.preview, sizeof(hit.preview), "%s: %s", name, text);
+    return true;
+}
+
+// ================== FLASH SCAN ==================
+// Records below the part of each channel the index answered for, read from
+// flash a page at a time walking backwards, so hits stay newest first.
+// SCAN_RECORDS is shared between the channels that have older records.
+void SearchIndex::scanOlder(const char* query, uint32_t floor_doc) {
+    // Docs from lo on have all their postings and a doc map slot
+    uint32_t lo = max(horizon, floor_doc);
+    if (next_doc > MAX_DOCS) lo = max(lo, next_doc - MAX_DOCS);
+
+    // Oldest record of each channel the index searched
+    static uint32_t from[POOL_CHANNELS];
+    size_t channels = min(all_channels.size(), (size_t) POOL_CHANNELS);
+    uint32_t older = 0;
+    for (size_t c = 0; c < channels; ++c) {
+        Channel* ch = all_channels[c];
+        if (!ch) continue;
+        uint32_t h = ch->ID.hash();
+        from[c] = ch->history_count;
+        for (uint32_t d = lo; d < next_doc; ++d) {
+            const DocRef& ref = docs[d % MAX_DOCS];
+            if (ref.channel_hash == h && ref.record < from[c]) from[c] = ref.record;
+        }
+        if (from[c] > 0) older++;
+    }
+    uint32_t share = older ? max(SCAN_RECORDS / older, (uint32_t) SCAN_PAGE) : 0;
+
+    scan_query = query;
+    for (size_t c = 0; c < channels && hit_count < MAX_RESULTS; ++c) {
+        Channel* ch = all_channels[c];
+        if (!ch) continue;
+        uint32_t stop = from[c] > share ? from[c] - share : 0;
+        uint32_t end = from[c];
+        while (end > stop && hit_count < MAX_RESULTS) {
+            uint32_t start = end - min(end - stop, (uint32_t) SCAN_PAGE);
+            scan_count = 0;
+            HistoryStore::scan(ch, start, onScanned, end);
+            while (scan_count > 0 && hit_count < MAX_RESULTS) {
+                const SearchHit& h = scan_hits[--scan_count];
+                if (!alreadyHit(h)) hits[hit_count++] = h;
+            }
+            end = start;
+        }
+        covered += ch->history_count - end;
+    }
+    scan_query = nullptr;
+}
+
+// Candidates older than lo may have been verified already
+bool SearchIndex::alreadyHit(const SearchHit& h) {
+    for (byte i = 0; i < hit_count; ++i) {
+        if (hits[i].channel == h.channel && hits[i].record == h.record) return true;
+    }
+    return false;
+}
+
+void SearchIndex::onScanned(Channel* channel, uint32_t index, const HistoryRecord& r) {
+    if (scan_count < SCAN_PAGE && match(channel, index, r, scan_query, scan_hits[scan_count])) {
+        scan_count++;
+    }
+}
+
+// ================== STATISTICS ==================
+uint16_t SearchIndex::docsSearchable() {
+    return min(next_doc - horizon, (uint32_t) MAX_DOCS);
+}
+
+size_t SearchIndex::bytesUsed() {
+    return sizeof(buckets) + sizeof(docs) + blocks_live * sizeof(Block);
+}
+
+size_t SearchIndex::bytesBudget() {
+    return sizeof(buckets) + sizeof(docs) + sizeof(blocks);
+}
@@ -0,0 +1,135 @@
+#pragma once
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include <Arduino.h>
+#include "../global_objects.h"
+
+struct HistoryRecord;
+
+// ----- SearchHit -----
+// One verified match: stored record of a channel plus a preview line
+struct SearchHit {
+    PoolHandle channel;
+    uint32_t record;          // Record index in the channel's history file
+    char preview[48];
+};
+
+// ================== SearchIndex ===================
+// Trigram index over message bodies and sender names in a fixed RAM budget.
+//
+// Every indexed message gets a doc number (increasing). Trigrams (ASCII
+// case-folded) hash into BUCKETS posting lists; a list is a chain of
+// BLOCK_SIZE-byte blocks holding varint deltas between doc numbers. Blocks
+// are handed out round-robin from one arena, so the block reused next is
+// always the oldest one, which is always the head of its chain: the index
+// forgets the oldest postings first and never needs compaction. A small
+// ring maps recent doc numbers back to (channel, record).
+//
+// Ingest costs O(body length). Queries start from the query trigram with the
+// shortest posting list, intersect the other lists into it and confirm the
+// candidates against the stored record, newest first, so hash collisions
+// never show up as hits.
+//
+// The index only answers for recent messages. A query that has not filled
+// its hits from them reads older records straight from flash, newest first
+// and at most SCAN_RECORDS per query; lastQueryCovered() tells how many of
+// the stored messages the query actually looked at.
+class SearchIndex {
+public:
+    // Blocks must outnumber buckets: a message touching a bucket without a
+    // block takes a fresh one, and with more buckets than blocks that churns
+    // the arena within a few dozen messages
+    static constexpr uint16_t BUCKETS    = 128;   // Power of two
+    static constexpr uint16_t BLOCKS     = 768;
+    static constexpr size_t   BLOCK_SIZE = 32;
+    static constexpr uint16_t MAX_DOCS   = 768;   // Doc map ring
+    static constexpr byte MAX_RESULTS    = 8;
+    static constexpr uint16_t MAX_CANDIDATES = 128;  // Newest docs of the shortest list
+    static constexpr uint32_t BOOT_RECORDS = 64;  // Per channel, indexed at boot
+    static constexpr uint32_t SCAN_RECORDS = 512; // Older records read from flash per query
+
+    // Index the newest BOOT_RECORDS of every channel; after HistoryStore::begin()
+    static void begin();
+
+    // Index one stored message (HistoryStore::append); text may be packed
+    static void add(const Channel* channel, uint32_t record,
+                    const char* text, const IdString& sender_id);
+
+    // Records [0, dropped) of a channel were compacted away; later ones moved down
+    static void shift(const Channel* channel, uint32_t dropped);
+
+    // Run a query (3+ characters); returns the number of hits
+    static byte search(const String& query);
+    static byte hitCount() { return hit_count; }
+    static const SearchHit& hit(byte i) { return hits[i]; }
+
+    // ------------------ Statistics -----------------------
+    static uint32_t docsIndexed() { return next_doc; }
+    static uint16_t docsSearchable();
+    static size_t bytesUsed();
+    static size_t bytesBudget();
+    static unsigned long lastQueryUs() { return last_query_us; }
+    // Stored messages the last query searched exhaustively (the newest of
+    // each channel), of all stored; 0 covered if the hits filled up first
+    static uint32_t lastQueryCovered() { return covered; }
+    static uint32_t lastQueryStored() { return stored; }
+
+private:
+    static constexpr uint16_t NONE = 0xFFFF;
+    static constexpr size_t BLOCK_DATA = BLOCK_SIZE - 13;
+    static constexpr byte SCAN_PAGE = 8;   // Records per flash read in scanOlder()
+
+    struct Bucket {
+        uint16_t head;
+        uint16_t tail;
+    };
+
+    struct Block {
+        uint16_t bucket;      // Owning bucket (NONE = never used)
+        uint16_t next;        // Next block of the chain
+        uint32_t base;        // Doc number the first delta starts from
+        uint32_t last;        // Last doc number written
+        uint8_t used;
+        uint8_t data[BLOCK_DATA];
+    };
+
+    struct DocRef {
+        uint32_t channel_hash;
+        uint32_t record;      // UINT32_MAX once compacted away
+    };
+
+    static Bucket buckets[BUCKETS];
+    static Block blocks[BLOCKS];
+    static DocRef docs[MAX_DOCS];
+    static uint16_t ring_next;       // Next block to hand out
+    static uint16_t blocks_live;
+    static uint32_t next_doc;
+    static uint32_t horizon;         // Docs up to here may have lost postings
+
+    static SearchHit hits[MAX_RESULTS];
+    static byte hit_count;
+    static unsigned long last_query_us;
+    static uint32_t covered;
+    static uint32_t stored;
+
+    static const char* scan_query;       // Query of the running flash scan
+    static SearchHit scan_hits[SCAN_PAGE];
+    static byte scan_count;
+
+    static uint16_t bucketOf(const char* s);
+    static void indexText(const char* text, size_t len, uint32_t doc);
+    static void post(uint16_t bucket, uint32_t doc);
+    static uint16_t allocBlock(uint16_t bucket);
+    static bool nextDoc(uint16_t& block, size_t& pos, uint32_t& doc);
+    static size_t listBytes(uint16_t bucket);
+    static bool verify(uint32_t doc, const char* query, SearchHit& hit);
+    static bool match(Channel* channel, uint32_t record, const HistoryRecord& r,
+                      const char* query, SearchHit& hit);
+    static void scanOlder(const char* query, uint32_t floor_doc);
+    static bool alreadyHit(const SearchHit& h);
+    static void onRecord(Channel* channel, uint32_t index, const HistoryRecord& r);
+    static void onScanned(Channel* channel, uint32_t index, const HistoryRecord& r);
+};
+
+#endif // SEARCH_INDEX_H
@@ -0,0 +1,259 @@
+#include "SerialIngest.h"
+#include "../DebugMacros.h"
+#include "../KeypadHandler/KeypadHandler.h"
+#include "../TFTHandler/TFTHandler.h"
+#include "../PreferencesHandler.h"
+#include "../TelemetryHandler/TelemetryHandler.h"
+#include "../PerfCounters/PerfCounters.h"
+#include "../LinkStats/LinkStats.h"
+#include "../PowerManager/PowerManager.h"
+#include "../HistoryStore/HistoryStore.h"
+#include "../Subscriptions/Subscriptions.h"
+#include "../TextCodec/TextCodec.h"
+
+TFTHandler* SerialIngest::tft = nullptr;
+KeypadHandler* SerialIngest::controller = nullptr;
+String SerialIngest::rx_line;
+bool SerialIngest::rx_overflow = false;
+
+void SerialIngest::begin(TFTHandler* _tft, KeypadHandler* _controller) {
+    tft = _tft;
+    controller = _controller;
+    rx_line.reserve(RX_LINE_MAX);
+}
+
+// ================== PARSED PACKET STRUCT ==================
+struct Packet {
+    IdString channel_id;
+    IdString message_id;
+    IdString sender_id;
+    String message;
+    String time_stamp;
+    bool valid;
+};
+// ================== PARSER ==================
+static Packet parsePacket(String packet) {
+    Packet result;
+    result.valid = false;
+
+    String parts[5];
+    int index = 0;
+
+    while (packet.length() > 0 && index < 5) {
+        int sepIndex = packet.indexOf("||");
+        if (sepIndex == -1) {
+            parts[index++] = packet;
+            break;
+        } else {
+            parts[index++] = packet.substring(0, sepIndex);
+            packet = packet.substring(sepIndex + 2);
+        }
+    }
+    if (index < 5) return result;
+
+    result.channel_id = parts[0];
+    result.message_id = parts[1];
+    result.sender_id  = parts[2];
+    result.message    = parts[3];
+    result.time_stamp = parts[4];
+    result.valid      = true;
+
+    return result;
+}
+
+
+// Accumulate bytes into rx_line; true once it holds a complete line
+bool SerialIngest::readLine() {
+    while (Serial.available()) {
+        char c = (char) Serial.read();
+        if (c == '\n') {
+            bool complete = !rx_overflow;
+            rx_overflow = false;
+            if (!complete) rx_line = "";
+            return complete;
+        }
+        if (rx_line.length() < RX_LINE_MAX) rx_line += c;
+        else                                 rx_overflow = true;
+    }
+    return false;
+}
+
+// ================== LINES ==================
+// Handle one line; false if it was rejected as malformed or not ours
+bool SerialIngest::ingestLine(String& line, Batch& batch) {
+    line.trim();
+    if (line.isEmpty()) return true;
+
+#ifdef ENABLE_TEST_HOOKS
+    // Diagnostics dump requested over serial
+    if (line == "DIAG") {
+        PerfCounters::dump();
+        return true;
+    }
+
+    // Scripted keys for input latency runs: `KEYS||<keypad labels>`
+    if (line.startsWith("KEYS||")) {
+        KeypadHandler::replay(line.substring(6));
+        return true;
+    }
+#endif
+
+    // Ignore debug/system lines from both this MCU and remote MCUs
+    if (line.startsWith("[DBG]") || line.startsWith("[INFO]") ||
+        line.startsWith("[WARN]") || line.startsWith("[ERR]") ||
+        line.startsWith("[D]") || line.startsWith("[LoRa") ||
+        line.startsWith("[FATAL")) return true;
+
+    // Handle latency update packets: format `LAT||<message_id>||<rssi>||<snr>||<latency_ms>`
+    if (line.startsWith("LAT||")) {
+        String parts[4];
+        int idx = 0;
+        String rest = line.substring(5); // skip "LAT||"
+        while (rest.length() > 0 && idx < 4) {
+            int sep = rest.indexOf("||");
+            if (sep == -1) {
+                parts[idx++] = rest;
+                break;
+            } else {
+                parts[idx++] = rest.substring(0, sep);
+                rest = rest.substring(sep + 2);
+            }
+        }
+        if (idx >= 4) {
+            IdString messageId = parts[0];
+            int rssi = parts[1].toInt();
+            int snr = parts[2].toInt();
+            unsigned long lat = (unsigned long) parts[3].toInt();
+            bool updated = updateMessageLatency(messageId, rssi, snr, lat);
+            if (updated) {
+                // find message and its channel to redraw
+                Message* m = findMessageById(messageId);
+                if (m) {
+                    LinkStats::onLatencyReport(m->channel_id, m->sender_id, rssi, snr, lat);
+                    // Message grew a signal line; cached chat heights are stale
+                    batch.layout_stale = true;
+                    Channel* ch = findChannelById(m->channel_id);
+                    if (ch) {
+                        HistoryStore::rewrite(ch, m);
+                        // redraw chat if currently viewing that channel
+                        if (tft->get_currentScreen() == SCREEN_CHAT && controller->target_channel == ch) {
+                            batch.dirty |= TFTHandler::DIRTY_BODY;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // Capability answer from the LoRa MCU
+    if (TextCodec::onCapability(line)) return true;
+
+    // Channels we are not in are dropped on the first field, unparsed
+    IdString channel_id;
+    if (!Subscriptions::accept(line, channel_id)) {
+        TELEMETRY_EVENT(TEL_UNKNOWN_CHANNEL, channel_id);
+        if (tft->get_currentScreen() == SCREEN_DISCOVER) {
+            batch.dirty |= TFTHandler::DIRTY_BODY;
+        }
+        return false;
+    }
+
+    // Parse incoming packet
+    Packet pkt = parsePacket(line);
+    if (!pkt.valid) {
+        TELEMETRY_EVENT(TEL_PARSE_ERROR, "");
+        return false;
+    }
+
+    // Bitmap false positive: still not one of ours
+    Channel* ch = findChannelById(pkt.channel_id);
+    if (!ch) {
+        TELEMETRY_EVENT(TEL_UNKNOWN_CHANNEL, pkt.channel_id);
+        Subscriptions::noteUnknown(pkt.channel_id);
+        if (tft->get_currentScreen() == SCREEN_DISCOVER) {
+            batch.dirty |= TFTHandler::DIRTY_BODY;
+        }
+        return false;
+    }
+
+    // Ensure sender exists; saved once the batch is done
+    User* sender = findUserById(pkt.sender_id);
+    if (!sender) {
+        sender = createUser(pkt.sender_id, pkt.sender_id);
+        if (sender) {
+            all_users.push_back(sender);
+            batch.users_dirty = true;
+        }
+    }
+    // A packed body tells us this peer reads them too
+    TextCodec::onReceived(sender, pkt.message);
+
+    // Avoid duplicates anywhere in the stored history, resident or not
+    // (earlier lines of this batch included)
+    if (HistoryStore::seen(ch, MessageId::keyOf(pkt.message_id))) {
+        TELEMETRY_EVENT(TEL_DUPLICATE, pkt.channel_id);
+        return true;
+    }
+
+    bool viewing = tft->get_currentScreen() == SCREEN_CHAT &&
+                   controller->target_channel == ch;
+
+    // A new message while browsing old pages jumps back to the newest ones
+    if (viewing && !HistoryStore::atTail(ch)) HistoryStore::trim(ch);
+
+    // Stored on flash first; the RAM copy may be skipped when out of slots
+    Message* msg;
+    if (!HistoryStore::append(ch, pkt.message_id, pkt.sender_id,
+                              TextCodec::pack(pkt.message), pkt.time_stamp, msg)) {
+        WARN("Message pool exhausted, dropping packet");
+        return true;
+    }
+
+    // Reported in the next batched telemetry flush
+    TELEMETRY_EVENT(TEL_ACCEPTED, pkt.channel_id);
+    PERF_COUNT_PACKET();
+    LinkStats::onMessage(pkt.channel_id, pkt.sender_id);
+
+    // Move channel to the top of the activity list; count unread unless open
+    touchChannelActivity(ch);
+    if (!viewing) ch->unread_count++;
+
+    // Refresh chat screen if active, or only the changed channel rows
+    if (viewing) {
+        batch.scroll_to = ch;
+        batch.dirty |= TFTHandler::DIRTY_BODY;
+    } else if (tft->get_currentScreen() == SCREEN_MESSAGES) {
+        batch.dirty |= TFTHandler::DIRTY_BODY;
+    }
+    return true;
+}
+
+// ================== BATCH ==================
+void SerialIngest::listen() {
+    if (!Serial.available()) return;
+    PERF_SCOPE(PERF_SERIAL_RX);
+
+    Batch batch = { false, false, 0, nullptr };
+    unsigned long start = millis();
+    uint16_t lines = 0;
+
+    HistoryStore::beginBatch();
+    PowerManager::rxActivity();
+    while (millis() - start < INGEST_BUDGET_MS && readLine()) {
+        // The line that woke the CPU from light sleep lost its first bytes
+        bool waking = PowerManager::takeWakeLine();
+        if (!ingestLine(rx_line, batch) && waking) PowerManager::countDamagedLine();
+        rx_line = "";
+        lines++;
+    }
+    HistoryStore::endBatch();
+
+    // One flush and one invalidation for everything the batch touched
+    if (batch.users_dirty) PreferencesHandler::saveUsers(all_users);
+    if (batch.layout_stale) tft->invalidateChatLayout();
+    if (batch.scroll_to) tft->scrollToBottom(batch.scroll_to);
+    if (batch.dirty) tft->invalidate(batch.dirty);
+
+    PerfCounters::recordBatch(lines, start, !Serial.available());
+}
@@ -0,0 +1,50 @@
+#pragma once
+#ifndef SERIAL_INGEST_H
+#define SERIAL_INGEST_H
+
+#include <Arduino.h>
+#include "../global_objects.h"
+
+class TFTHandler;
+class KeypadHandler;
+
+// ================== SerialIngest ===================
+// Packets, latency reports and control lines from the LoRa MCU. Incoming
+// lines are ingested in batches: every complete line in the RX buffer is
+// handled, within INGEST_BUDGET_MS, before anything is saved or redrawn.
+// When the LoRa MCU flushes a backlog after a reconnect, that is one users
+// save and one chat redraw per batch instead of one per packet.
+//
+// Packets whose key is anywhere in the channel's stored history
+// (HistoryStore::seen) are dropped, so a replayed backlog adds nothing twice.
+class SerialIngest {
+public:
+    static constexpr size_t UART_RX_BUFFER = 4096;         // Holds a reconnect backlog between loops
+    static constexpr size_t RX_LINE_MAX = 512;             // Longer lines are dropped whole
+    static constexpr unsigned long INGEST_BUDGET_MS = 20;  // Per loop; the rest waits for the next one
+
+    // Screen and controller that decide what an incoming packet redraws
+    static void begin(TFTHandler* tft, KeypadHandler* controller);
+
+    // Ingest the complete lines waiting in the RX buffer (call in loop)
+    static void listen();
+
+private:
+    // Side effects collected over a batch and applied once at its end
+    struct Batch {
+        bool users_dirty;        // New senders to persist
+        bool layout_stale;       // Latency lines added to messages
+        byte dirty;              // TFTHandler::DIRTY_* regions to repaint
+        Channel* scroll_to;      // Open chat that received messages
+    };
+
+    static TFTHandler* tft;
+    static KeypadHandler* controller;
+    static String rx_line;       // Line being received, kept across loops
+    static bool rx_overflow;
+
+    static bool readLine();
+    static bool ingestLine(String& line, Batch& batch);
+};
+
+#endif
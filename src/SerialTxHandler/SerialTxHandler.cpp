@@ -0,0 +1,70 @@
+#include "SerialTxHandler.h"
+
+uint8_t  SerialTxHandler::ring[SerialTxHandler::RING_SIZE];
+size_t   SerialTxHandler::head = 0;
+size_t   SerialTxHandler::tail = 0;
+size_t   SerialTxHandler::used = 0;
+size_t   SerialTxHandler::high_watermark = 0;
+uint32_t SerialTxHandler::queued_lines = 0;
+uint32_t SerialTxHandler::dropped_lines = 0;
+uint32_t SerialTxHandler::dropped_bytes = 0;
+uint32_t SerialTxHandler::dropped_packets = 0;
+
+void SerialTxHandler::configure() {
+    // With a TX buffer the UART driver feeds the hardware FIFO from its ISR
+    Serial.setTxBufferSize(UART_TX_BUFFER);
+}
+
+// ================== QUEUEING ==================
+void SerialTxHandler::push(const uint8_t* data, size_t len) {
+    size_t first = min(len, RING_SIZE - head);
+    memcpy(ring + head, data, first);
+    memcpy(ring, data + first, len - first);
+    head = (head + len) % RING_SIZE;
+    used += len;
+}
+
+bool SerialTxHandler::enqueueLine(const char* data, size_t len) {
+    return enqueue(data, len, PACKET_RESERVE);
+}
+
+bool SerialTxHandler::enqueuePacket(const char* data, size_t len) {
+    if (enqueue(data, len, 0)) return true;
+    dropped_packets++;
+    return false;
+}
+
+// Room is what is left of the ring after 'reserve' bytes
+bool SerialTxHandler::enqueue(const char* data, size_t len, size_t reserve) {
+    if (used + reserve > RING_SIZE || len + 1 > RING_SIZE - reserve - used) {
+        dropped_lines++;
+        dropped_bytes += len + 1;
+        return false;
+    }
+
+    const uint8_t newline = '\n';
+    push((const uint8_t*)data, len);
+    push(&newline, 1);
+    if (used > high_watermark) high_watermark = used;
+    queued_lines++;
+
+    // Opportunistically hand what fits to the driver right away
+    pump();
+    return true;
+}
+
+// ================== DRAIN ==================
+void SerialTxHandler::pump() {
+    while (used > 0) {
+        int room = Serial.availableForWrite();
+        if (room <= 0) return;
+
+        // Contiguous chunk up to the end of the ring
+        size_t chunk = min((size_t)room, min(used, RING_SIZE - tail));
+        size_t written = Serial.write(ring + tail, chunk);
+        if (written == 0) return;
+
+        tail = (tail + written) % RING_SIZE;
+        used -= written;
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef SERIAL_TX_HANDLER_H
+#define SERIAL_TX_HANDLER_H
+
+#include <Arduino.h>
+
+// ================== SerialTxHandler ===================
+// Non-blocking transmit path towards the LoRa MCU.
+// Outgoing lines are copied into a preallocated ring and moved into the
+// UART driver's TX buffer (drained by the driver's TX interrupt) only as
+// fast as the driver can take them, so callers never wait on the FIFO.
+// All callers run on the Arduino loop task, so no locking is needed.
+//
+// This is the only writer of Serial: log macros (DebugMacros.h) and control
+// lines are queued here too. pump() may hand the driver part of a line, but
+// since nothing else writes, the rest always follows it unbroken.
+//
+// Log lines may not use the last PACKET_RESERVE bytes of the ring, so a burst
+// of logging drops log lines before it can crowd out the user's packets.
+class SerialTxHandler {
+public:
+    static constexpr size_t RING_SIZE      = 2048; // Bytes queued ahead of the UART driver
+    static constexpr size_t UART_TX_BUFFER = 1024; // Driver-side TX buffer (interrupt drained)
+    static constexpr size_t PACKET_RESERVE = 512;  // Ring bytes only packets may use
+
+    // ------------------ Initialization -------------------
+    // Call before Serial.begin() so the UART driver allocates its TX buffer
+    static void configure();
+
+    // ------------------ Queueing -------------------------
+    // Queue one log line ('\n' appended). The line is queued whole or not at
+    // all; returns false and counts a drop when the ring, less the packet
+    // reserve, has no room.
+    static bool enqueueLine(const char* data, size_t len);
+    static bool enqueueLine(const String& line) {
+        return enqueueLine(line.c_str(), line.length());
+    }
+
+    // Queue a line for the LoRa MCU (messages and control lines); may use
+    // the whole ring
+    static bool enqueuePacket(const char* data, size_t len);
+    static bool enqueuePacket(const String& line) {
+        return enqueuePacket(line.c_str(), line.length());
+    }
+
+    // Move as many queued bytes as the UART driver accepts without blocking (call in loop)
+    static void pump();
+
+    // ------------------ Statistics -----------------------
+    static size_t pending()          { return used; }
+    static size_t highWatermark()    { return high_watermark; }
+    static uint32_t queuedLines()    { return queued_lines; }
+    static uint32_t droppedLines()   { return dropped_lines; }
+    static uint32_t droppedBytes()   { return dropped_bytes; }
+    static uint32_t droppedPackets() { return dropped_packets; }
+
+private:
+    static uint8_t ring[RING_SIZE];
+    static size_t head;            // Next write position
+    static size_t tail;            // Next byte to hand to the UART driver
+    static size_t used;            // Bytes currently queued
+    static size_t high_watermark;  // Largest 'used' value seen
+    static uint32_t queued_lines;    // Lines accepted into the ring
+    static uint32_t dropped_lines;   // All lines, packets included
+    static uint32_t dropped_bytes;
+    static uint32_t dropped_packets;
+
+    static void push(const uint8_t* data, size_t len);
+    static bool enqueue(const char* data, size_t len, size_t reserve);
+};
+
+#endif // SERIAL_TX_HANDLER_H
@@ -0,0 +1,264 @@
+#include "SmoothFont.h"
+#include "../ChatLayout/ChatLayout.h"
+#include "../DebugMacros.h"
+#include <esp_partition.h>
+
+bool SmoothFont::loaded = false;
+const uint8_t* SmoothFont::font = nullptr;
+uint16_t SmoothFont::glyph_count = 0;
+int16_t SmoothFont::ascent = 0;
+int16_t SmoothFont::descent = 0;
+uint32_t* SmoothFont::bitmap_offset = nullptr;
+uint16_t SmoothFont::ascii[95];
+uint16_t SmoothFont::fallback = SmoothFont::NO_GLYPH;
+uint8_t SmoothFont::space_width = 0;
+
+uint16_t SmoothFont::fg = 0;
+uint16_t SmoothFont::bg = 0;
+uint16_t SmoothFont::ramp[256];
+uint16_t SmoothFont::pixels[SmoothFont::CACHE_SLOTS][SmoothFont::SLOT_PIXELS];
+uint16_t SmoothFont::slot_glyph[SmoothFont::CACHE_SLOTS];
+byte* SmoothFont::glyph_slot = nullptr;
+byte SmoothFont::lru_prev[SmoothFont::CACHE_SLOTS];
+byte SmoothFont::lru_next[SmoothFont::CACHE_SLOTS];
+byte SmoothFont::lru_head = 0;
+byte SmoothFont::lru_tail = 0;
+
+uint32_t SmoothFont::cache_hits = 0;
+uint32_t SmoothFont::cache_misses = 0;
+
+// VLW layout: 6-word header, 7-word record per glyph, then the alpha bitmaps
+// in record order. All words are big-endian.
+static const size_t VLW_HEADER = 24;
+static const size_t VLW_RECORD = 28;
+
+// ================== LOADING ==================
+bool SmoothFont::begin() {
+    const esp_partition_t* part =
+        esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "font");
+    if (!part) {
+        WARN("No font partition, chat uses the built-in font");
+        return false;
+    }
+
+    const void* mapped;
+    spi_flash_mmap_handle_t handle;
+    if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+        WARN("Font partition could not be mapped");
+        return false;
+    }
+    font = (const uint8_t*) mapped;
+
+    // Erased flash reads 0xFFFFFFFF: also rejected here
+    uint32_t count = read32(0);
+    size_t bitmaps = VLW_HEADER + count * VLW_RECORD;
+    if (count == 0 || count > MAX_GLYPHS || bitmaps > part->size) {
+        WARN("Font partition holds no VLW font");
+        return false;
+    }
+    glyph_count = count;
+
+    bitmap_offset = (uint32_t*) malloc(glyph_count * sizeof(uint32_t));
+    glyph_slot = (byte*) malloc(glyph_count);
+    if (!bitmap_offset || !glyph_slot) {
+        free(bitmap_offset);
+        free(glyph_slot);
+        bitmap_offset = nullptr;
+        glyph_slot = nullptr;
+        WARN("No memory for the font index");
+        return false;
+    }
+
+    // Offsets, ASCII index and the real extents (VLW ascent/descent are
+    // those of 'd' and 'p'; accents and brackets reach further)
+    ascent = (int16_t) read32(16);
+    descent = (int16_t) read32(20);
+    for (byte i = 0; i < 95; ++i) ascii[i] = NO_GLYPH;
+
+    size_t offset = bitmaps;
+    for (uint16_t i = 0; i < glyph_count; ++i) {
+        size_t rec = VLW_HEADER + i * VLW_RECORD;
+        uint32_t code = read32(rec);
+        int16_t height = (int16_t) read32(rec + 4);
+        int16_t dy = (int16_t) read32(rec + 16);
+
+        bitmap_offset[i] = offset;
+        offset += read32(rec + 8) * (uint32_t) height;
+        glyph_slot[i] = NO_SLOT;
+
+        if (code >= 32 && code <= 126) ascii[code - 32] = i;
+        ascent = max(ascent, dy);
+        descent = max(descent, (int16_t) (height - dy));
+    }
+    if (offset > part->size) {
+        WARN("Font partition truncated");
+        return false;
+    }
+
+    fallback = ascii['?' - 32];
+    space_width = (ascent + descent) * 2 / 7;   // As TFT_eSPI, when the font has no space
+    for (byte s = 0; s < CACHE_SLOTS; ++s) slot_glyph[s] = NO_GLYPH;
+    flush();
+
+    loaded = true;
+    INFO("Smooth font: " + String(glyph_count) + " glyphs, " + String(lineHeight()) + " px lines");
+    return true;
+}
+
+uint32_t SmoothFont::read32(size_t offset) {
+    const uint8_t* p = font + offset;
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+}
+
+uint16_t SmoothFont::find(uint32_t codepoint) {
+    if (codepoint >= 32 && codepoint <= 126) {
+        uint16_t g = ascii[codepoint - 32];
+        return g != NO_GLYPH || codepoint == ' ' ? g : fallback;  // Space may be absent
+    }
+    for (uint16_t i = 0; i < glyph_count; ++i) {
+        if (read32(VLW_HEADER + i * VLW_RECORD) == codepoint) return i;
+    }
+    return fallback;
+}
+
+SmoothFont::Glyph SmoothFont::glyph(uint16_t index) {
+    size_t rec = VLW_HEADER + index * VLW_RECORD;
+    Glyph g;
+    g.height = (uint16_t) read32(rec + 4);
+    g.width = (uint16_t) read32(rec + 8);
+    g.advance = (uint8_t) read32(rec + 12);
+    g.dy = (int16_t) read32(rec + 16);
+    g.dx = (int16_t) read32(rec + 20);
+    g.alpha = font + bitmap_offset[index];
+    return g;
+}
+
+uint8_t SmoothFont::advance(uint32_t codepoint) {
+    if (!loaded) return 0;
+    uint16_t g = find(codepoint);
+    if (g == NO_GLYPH) return codepoint == ' ' ? space_width : 0;
+    return (uint8_t) read32(VLW_HEADER + g * VLW_RECORD + 12);
+}
+
+// ================== CACHE ==================
+void SmoothFont::setColors(uint16_t _fg, uint16_t _bg) {
+    if (_fg == fg && _bg == bg) return;
+    fg = _fg;
+    bg = _bg;
+
+    // Same arithmetic as TFT_eSPI::alphaBlend, stored byte-swapped for the bus
+    uint16_t fr = ((fg >> 10) & 0x3E) + 1, fgn = ((fg >> 4) & 0x7E) + 1, fb = ((fg << 1) & 0x3E) + 1;
+    uint16_t br = ((bg >> 10) & 0x3E) + 1, bgn = ((bg >> 4) & 0x7E) + 1, bb = ((bg << 1) & 0x3E) + 1;
+    for (uint16_t a = 0; a < 256; ++a) {
+        uint16_t r = (fr * a + br * (255 - a)) >> 9;
+        uint16_t g = (fgn * a + bgn * (255 - a)) >> 9;
+        uint16_t b = (fb * a + bb * (255 - a)) >> 9;
+        uint16_t c = (r << 11) | (g << 5) | b;
+        ramp[a] = (c << 8) | (c >> 8);
+    }
+    flush();
+}
+
+// Forget every cached glyph and chain the slots in index order
+void SmoothFont::flush() {
+    for (byte s = 0; s < CACHE_SLOTS; ++s) {
+        if (slot_glyph[s] != NO_GLYPH && glyph_slot) glyph_slot[slot_glyph[s]] = NO_SLOT;
+        slot_glyph[s] = NO_GLYPH;
+        lru_prev[s] = s == 0 ? NO_SLOT : s - 1;
+        lru_next[s] = s + 1 == CACHE_SLOTS ? NO_SLOT : s + 1;
+    }
+    lru_head = 0;
+    lru_tail = CACHE_SLOTS - 1;
+}
+
+// Move a slot to the most recently used end
+void SmoothFont::touch(byte slot) {
+    if (slot == lru_head) return;
+    lru_next[lru_prev[slot]] = lru_next[slot];
+    if (slot == lru_tail) lru_tail = lru_prev[slot];
+    else                  lru_prev[lru_next[slot]] = lru_prev[slot];
+
+    lru_prev[slot] = NO_SLOT;
+    lru_next[slot] = lru_head;
+    lru_prev[lru_head] = slot;
+    lru_head = slot;
+}
+
+byte SmoothFont::hitRate() {
+    uint32_t total = cache_hits + cache_misses;
+    return total ? (byte) ((uint64_t) cache_hits * 100 / total) : 0;
+}
+
+void SmoothFont::resetStats() {
+    cache_hits = 0;
+    cache_misses = 0;
+}
+
+// ================== DRAWING ==================
+int SmoothFont::drawString(TFT_eSPI& tft, const char* text, size_t len, int32_t x, int32_t y) {
+    if (!loaded) return 0;
+
+    // Pixels are stored in bus order
+    bool swap = tft.getSwapBytes();
+    tft.setSwapBytes(false);
+
+    int32_t start = x;
+    uint32_t cp;
+    for (size_t i = 0; i < len; ) {
+        i += ChatLayout::decodeUtf8(text, len, i, cp);
+        uint16_t index = find(cp);
+        if (index == NO_GLYPH) {
+            if (cp == ' ') x += space_width;
+            continue;
+        }
+
+        Glyph g = glyph(index);
+        int32_t gx = x + g.dx;
+        int32_t gy = y + ascent - g.dy;
+        x += g.advance;
+        if (g.width == 0 || g.height == 0) continue;
+
+        uint32_t area = (uint32_t) g.width * g.height;
+        if (area > SLOT_PIXELS) {
+            cache_misses++;
+            drawUncached(tft, g, gx, gy);
+            continue;
+        }
+
+        byte slot = glyph_slot[index];
+        if (slot != NO_SLOT) {
+            cache_hits++;
+        } else {
+            // Evict the least recently used glyph and blend this one into its box
+            cache_misses++;
+            slot = lru_tail;
+            if (slot_glyph[slot] != NO_GLYPH) glyph_slot[slot_glyph[slot]] = NO_SLOT;
+            for (uint32_t p = 0; p < area; ++p) pixels[slot][p] = ramp[g.alpha[p]];
+            slot_glyph[slot] = index;
+            glyph_slot[index] = slot;
+        }
+        touch(slot);
+        tft.pushImage(gx, gy, g.width, g.height, pixels[slot]);
+    }
+
+    tft.setSwapBytes(swap);
+    return x - start;
+}
+
+// Oversized glyph: blend as many rows as fit in one slot per push
+void SmoothFont::drawUncached(TFT_eSPI& tft, const Glyph& g, int32_t x, int32_t y) {
+    if (g.width > SLOT_PIXELS) return;
+    uint16_t* scratch = pixels[lru_tail];
+    if (slot_glyph[lru_tail] != NO_GLYPH) {
+        glyph_slot[slot_glyph[lru_tail]] = NO_SLOT;
+        slot_glyph[lru_tail] = NO_GLYPH;
+    }
+
+    uint16_t rows = SLOT_PIXELS / g.width;
+    for (uint16_t row = 0; row < g.height; row += rows) {
+        uint16_t n = min(rows, (uint16_t) (g.height - row));
+        const uint8_t* a = g.alpha + (uint32_t) row * g.width;
+        for (uint32_t p = 0; p < (uint32_t) n * g.width; ++p) scratch[p] = ramp[a[p]];
+        tft.pushImage(x, y + row, g.width, n, scratch);
+    }
+}
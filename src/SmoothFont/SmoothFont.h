@@ -0,0 +1,88 @@
+#pragma once
+#ifndef SMOOTH_FONT_CACHE_H
+#define SMOOTH_FONT_CACHE_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+// Font id used with ChatLayout for the anti-aliased chat font (built-in fonts are 0..8)
+const byte FONT_SMOOTH = 9;
+
+// ================== SmoothFont ===================
+// Anti-aliased text from a VLW font stored raw in the "font" flash partition
+// (see partitions.csv). The partition is memory-mapped, so metrics and alpha
+// bitmaps are read in place: nothing is copied to RAM except a bitmap offset
+// per glyph and an ASCII index.
+//
+// Glyphs are alpha-blended against the current foreground/background pair
+// once and kept, already in bus byte order, in an LRU cache of CACHE_SLOTS
+// boxes; a cached glyph costs one pushImage. Changing the colour pair drops
+// the cache. Glyphs larger than a slot are blended row by row on every draw.
+//
+// Text is opaque over each glyph box only, so draw onto a cleared background.
+class SmoothFont {
+public:
+    static const byte CACHE_SLOTS = 48;
+    static const uint16_t SLOT_PIXELS = 192;     // 12x16; covers a 16 px font's glyphs
+    static const uint16_t MAX_GLYPHS = 1024;     // Sanity bound on the header
+
+    // Map the partition and index the font; false if missing or not a VLW font
+    static bool begin();
+    static bool ready() { return loaded; }
+
+    // Colour pair for following draws (RGB565); a new pair empties the cache
+    static void setColors(uint16_t fg, uint16_t bg);
+
+    // Pixel advance of a code point (unknown code points use '?')
+    static uint8_t advance(uint32_t codepoint);
+    // Ascent + descent
+    static int lineHeight() { return ascent + descent; }
+
+    // Draw UTF-8 text with its top-left at (x, y); returns the advance in pixels
+    static int drawString(TFT_eSPI& tft, const char* text, size_t len, int32_t x, int32_t y);
+
+    // Cache statistics since boot / the last reset
+    static uint32_t hits() { return cache_hits; }
+    static uint32_t misses() { return cache_misses; }
+    static byte hitRate();
+    static void resetStats();
+
+private:
+    static const uint16_t NO_GLYPH = 0xFFFF;
+    static const byte NO_SLOT = 0xFF;
+
+    struct Glyph {
+        uint16_t width, height;
+        int16_t dx, dy;          // Left and top extent
+        uint8_t advance;
+        const uint8_t* alpha;    // width * height bytes in flash
+    };
+
+    static bool loaded;
+    static const uint8_t* font;          // Mapped partition
+    static uint16_t glyph_count;
+    static int16_t ascent, descent;
+    static uint32_t* bitmap_offset;      // Per glyph, from the start of the font
+    static uint16_t ascii[95];           // Glyph index of 32..126
+    static uint16_t fallback;            // Glyph index of '?'
+    static uint8_t space_width;
+
+    static uint16_t fg, bg;
+    static uint16_t ramp[256];           // Alpha to blended colour, bus byte order
+    static uint16_t pixels[CACHE_SLOTS][SLOT_PIXELS];
+    static uint16_t slot_glyph[CACHE_SLOTS];
+    static byte* glyph_slot;             // Per glyph: cache slot or NO_SLOT
+    static byte lru_prev[CACHE_SLOTS], lru_next[CACHE_SLOTS];
+    static byte lru_head, lru_tail;      // Most / least recently used
+
+    static uint32_t cache_hits, cache_misses;
+
+    static uint32_t read32(size_t offset);
+    static uint16_t find(uint32_t codepoint);
+    static Glyph glyph(uint16_t index);
+    static void flush();
+    static void touch(byte slot);
+    static void drawUncached(TFT_eSPI& tft, const Glyph& g, int32_t x, int32_t y);
+};
+
+#endif // SMOOTH_FONT_CACHE_H
@@ -0,0 +1,132 @@
+#include "Subscriptions.h"
+#include "../global_objects.h"
+#include "../PreferencesHandler.h"
+#include "../SerialTxHandler/SerialTxHandler.h"
+
+uint8_t Subscriptions::bitmap[Subscriptions::BITS / 8] = {0};
+bool Subscriptions::dirty = false;
+bool Subscriptions::discovery = false;
+DiscoveredChannel Subscriptions::discovered_list[Subscriptions::MAX_DISCOVERED];
+byte Subscriptions::discovered_count = 0;
+uint32_t Subscriptions::rejected_count = 0;
+
+// ================== BITMAP ==================
+void Subscriptions::begin() {
+    discovery = PreferencesHandler::getBool("discover", false);
+}
+
+void Subscriptions::setBits(uint32_t h) {
+    uint8_t a = h & 0xFF;
+    uint8_t b = (h >> 16) & 0xFF;
+    bitmap[a >> 3] |= 1 << (a & 7);
+    bitmap[b >> 3] |= 1 << (b & 7);
+}
+
+void Subscriptions::add(const IdString& channel_id) {
+    setBits(channel_id.hash());
+    dirty = true;
+
+    // Joined now, so no longer a discovery candidate
+    for (byte i = 0; i < discovered_count; ++i) {
+        if (discovered_list[i].id == channel_id) {
+            forget(i);
+            break;
+        }
+    }
+}
+
+void Subscriptions::rebuild() {
+    memset(bitmap, 0, sizeof(bitmap));
+    for (Channel* ch : all_channels) {
+        if (ch) setBits(ch->ID.hash());
+    }
+    dirty = true;
+}
+
+bool Subscriptions::mayContain(const IdString& channel_id) {
+    uint32_t h = channel_id.hash();
+    uint8_t a = h & 0xFF;
+    uint8_t b = (h >> 16) & 0xFF;
+    return (bitmap[a >> 3] & (1 << (a & 7))) && (bitmap[b >> 3] & (1 << (b & 7)));
+}
+
+// ================== FAST PATH ==================
+bool Subscriptions::accept(const String& line, IdString& channel_id) {
+    int sep = line.indexOf("||");
+    if (sep <= 0) return true;
+
+    // Only packet-shaped lines (5 fields) reach the bitmap and discovery;
+    // control lines and garbage fall through to the parser
+    byte seps = 1;
+    for (const char* p = line.c_str() + sep + 2; (p = strstr(p, "||")) != nullptr; p += 2) {
+        if (++seps > PACKET_SEPARATORS) return true;
+    }
+    if (seps != PACKET_SEPARATORS) return true;
+
+    channel_id.assign(line.c_str(), sep);
+    if (mayContain(channel_id)) return true;
+
+    rejected_count++;
+    noteUnknown(channel_id);
+    return false;
+}
+
+void Subscriptions::update() {
+    if (!dirty) return;
+
+    static const char hex[] = "0123456789ABCDEF";
+    char line[5 + sizeof(bitmap) * 2];
+    memcpy(line, "SUB||", 5);
+    size_t len = 5;
+    for (uint8_t b : bitmap) {
+        line[len++] = hex[b >> 4];
+        line[len++] = hex[b & 0x0F];
+    }
+    // Ring full: keep the flag and retry on the next pass
+    if (SerialTxHandler::enqueuePacket(line, len)) dirty = false;
+}
+
+// ================== DISCOVERY ==================
+void Subscriptions::setDiscovery(bool on) {
+    discovery = on;
+    if (!on) discovered_count = 0;
+    PreferencesHandler::setBool("discover", on);
+}
+
+void Subscriptions::noteUnknown(const IdString& channel_id) {
+    if (!discovery || channel_id.isEmpty()) return;
+    unsigned long now = millis();
+
+    for (byte i = 0; i < discovered_count; ++i) {
+        DiscoveredChannel& d = discovered_list[i];
+        if (d.id == channel_id) {
+            if (d.packets < 0xFFFF) d.packets++;
+            d.last_seen = now;
+            return;
+        }
+    }
+
+    // Full: replace the quietest entry (oldest on ties)
+    byte slot = discovered_count;
+    if (slot == MAX_DISCOVERED) {
+        slot = 0;
+        for (byte i = 1; i < MAX_DISCOVERED; ++i) {
+            const DiscoveredChannel& d = discovered_list[i];
+            const DiscoveredChannel& s = discovered_list[slot];
+            if (d.packets < s.packets || (d.packets == s.packets && d.last_seen < s.last_seen)) {
+                slot = i;
+            }
+        }
+    } else {
+        discovered_count++;
+    }
+    discovered_list[slot].id = channel_id;
+    discovered_list[slot].packets = 1;
+    discovered_list[slot].last_seen = now;
+}
+
+void Subscriptions::forget(byte i) {
+    if (i >= discovered_count) return;
+    for (byte j = i + 1; j < discovered_count; ++j) discovered_list[j - 1] = discovered_list[j];
+    discovered_count--;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef SUBSCRIPTIONS_H
+#define SUBSCRIPTIONS_H
+
+#include <Arduino.h>
+#include "../FixedString/FixedString.h"
+
+// ----- DiscoveredChannel -----
+// Unknown channel seen on the mesh (opt-in discovery list)
+struct DiscoveredChannel {
+    IdString id;
+    uint16_t packets;          // Packets seen since discovery
+    unsigned long last_seen;   // millis()
+};
+
+// ================== Subscriptions ===================
+// Filter for joined channels: a 256-bit bitmap with two probes per channel
+// ID, taken from the ID's FNV-1a hash (bits 0-7 and 16-23). A clear bit
+// means "not joined" for certain, so packets for other channels are dropped
+// on their first field, before the rest of the line is parsed. Set bits can
+// be false positives; the channel lookup after the full parse decides.
+//
+// The same bitmap goes to the LoRa MCU as `SUB||<64 hex digits>` (byte i,
+// bit j = bitmap bit 8 * i + j) so it can drop foreign traffic before it
+// reaches the UART. Changes are batched and pushed from update().
+class Subscriptions {
+public:
+    static constexpr uint16_t BITS = 256;
+    static constexpr byte MAX_DISCOVERED = 8;
+    static constexpr byte PACKET_SEPARATORS = 4;  // "||" in a 5-field packet line
+
+    // Load the discovery setting; call after PreferencesHandler::begin()
+    static void begin();
+
+    // Bitmap maintenance (registerChannel / rebuildChannelActivity)
+    static void add(const IdString& channel_id);
+    static void rebuild();
+
+    // Fast path: take the channel field of a packet line and check it
+    // against the bitmap. Rejected IDs go to the discovery list (if on).
+    // Lines that are not packet-shaped (channel||id||sender||text||time)
+    // pass, so the full parser can count them.
+    static bool accept(const String& line, IdString& channel_id);
+    static bool mayContain(const IdString& channel_id);
+
+    // Record activity on a channel we are not in (no-op unless enabled)
+    static void noteUnknown(const IdString& channel_id);
+
+    // Push a changed bitmap to the LoRa MCU (call in loop)
+    static void update();
+
+    // ------------------ Discovery list -------------------
+    static bool discoveryEnabled() { return discovery; }
+    static void setDiscovery(bool on);
+    static byte discoveredCount() { return discovered_count; }
+    static const DiscoveredChannel& discovered(byte i) { return discovered_list[i]; }
+    static void forget(byte i);
+
+    // ------------------ Counters ---------------------------
+    static uint32_t rejected() { return rejected_count; }
+
+private:
+    static uint8_t bitmap[BITS / 8];
+    static bool dirty;            // Bitmap changed since the last SUB push
+    static bool discovery;
+    static DiscoveredChannel discovered_list[MAX_DISCOVERED];
+    static byte discovered_count;
+    static uint32_t rejected_count;
+
+    static void setBits(uint32_t h);
+};
+
+#endif // SUBSCRIPTIONS_H
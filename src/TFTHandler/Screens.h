@@ -0,0 +1,161 @@
+#pragma once
+#ifndef SCREENS_H
+#define SCREENS_H
+
+#include "../UIWidgets/UIWidgets.h"
+#include "../Assets/AssetData.h"
+
+// ================== SCREEN LAYOUTS ==================
+// Static parts of every screen as widget tables. Dynamic content (lists,
+// drafts, values, header clock) is drawn by TFTHandler inside W_REGION areas
+// or on top of these widgets. Colours are palette roles (PAL_*), resolved
+// against the active Theme at paint time. Shapes that never change (logo,
+// buttons, footer keys) are pre-rendered ASSET_* images, see
+// tools/gen_assets.py; labels are drawn on top of them.
+
+// ----- Start screen -----
+constexpr Widget START_WIDGETS[] = {
+    uiRect(0, 0, 320, 40, PAL_BAR),
+    uiLabel(160, 20, "MeshCrafted", 4, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+    // Logo: circle plus two signal triangles
+    uiImage(120, 60, ASSET_LOGO),
+    uiImage(40, 160, ASSET_MENU_BUTTON),
+    uiLabel(160, 175, "1. MESSAGES", 2, MC_DATUM, PAL_INK, PAL_ACCENT),
+    uiImage(40, 200, ASSET_MENU_BUTTON),
+    uiLabel(160, 215, "2. SETTINGS", 2, MC_DATUM, PAL_INK, PAL_ACCENT),
+};
+
+// ----- Settings menu -----
+constexpr Widget SETTINGS_WIDGETS[] = {
+    uiRect(0, 0, 320, 30, PAL_BAR),
+    uiLabel(160, 15, "Settings", 2, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+    uiImage(40, 50, ASSET_SETTINGS_BUTTON),
+    uiLabel(160, 65, "1. Edit Username", 2, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+    uiImage(40, 90, ASSET_SETTINGS_BUTTON),
+    uiLabel(160, 105, "2. Change Theme", 2, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+    uiImage(40, 130, ASSET_SETTINGS_BUTTON),
+    uiLabel(160, 145, "3. Connectivity", 2, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+    uiImage(40, 170, ASSET_SETTINGS_BUTTON),
+    uiLabel(160, 185, "4. Calibrate Touch", 2, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+    uiRect(0, 220, 320, 20, PAL_PANEL),
+    uiLabel(160, 230, "Press number to select / * to go back", 1, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+};
+
+// ----- Messages / channel list -----
+constexpr Widget MESSAGES_WIDGETS[] = {
+    uiRect(0, 0, 320, 30, PAL_BAR),
+    uiLabel(160, 15, "Messages", 2, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+    uiRegion(215, 0, 105, 30, PAL_BAR),                    // Header clock
+    uiRegion(0, 30, 320, 160, PAL_BACKGROUND),             // Channel rows
+    // [F1] Add Lobby
+    uiImage(10, 190, ASSET_KEY_LEFT),
+    uiText(35, 202, "F1", 2, MC_DATUM, PAL_INK),
+    uiText(90, 202, "Add Lobby", 2, MC_DATUM, PAL_INK),
+    // [Esc] Main Menu
+    uiImage(165, 190, ASSET_KEY_RIGHT),
+    uiText(195, 202, "Esc", 2, MC_DATUM, PAL_TEXT),
+    uiText(255, 202, "Main Menu", 2, MC_DATUM, PAL_INK),
+    // Status bar
+    uiRect(0, 220, 320, 20, PAL_BAR),
+    uiLabel(160, 230, "MeshCrafted 1.0   B: search  G: discover", 1, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+};
+
+// ----- Channel discovery -----
+constexpr Widget DISCOVER_WIDGETS[] = {
+    uiRect(0, 0, 320, 30, PAL_BAR),
+    uiText(5, 34, "Channel", 1, TL_DATUM, PAL_MUTED),
+    uiText(190, 34, "Packets", 1, TL_DATUM, PAL_MUTED),
+    uiText(250, 34, "Last seen", 1, TL_DATUM, PAL_MUTED),
+    uiRegion(0, 44, 320, 176, PAL_BACKGROUND),             // Channel rows
+    uiRect(0, 220, 320, 20, PAL_PANEL),
+    uiLabel(160, 230, "1-8: join  C: discovery on/off  F: back", 1, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+};
+
+// ----- Search -----
+constexpr Widget SEARCH_WIDGETS[] = {
+    uiRect(0, 0, 320, 30, PAL_BAR),
+    uiRegion(0, 0, 320, 30, PAL_BAR),                      // Title with index size
+    uiRegion(10, 36, 300, 26, PAL_PANEL),                  // Query box
+    uiRegion(0, 66, 320, 154, PAL_BACKGROUND),             // Hits
+    uiRect(0, 220, 320, 20, PAL_PANEL),
+    uiLabel(160, 230, "H: search  D/E: select  B: open  F: back", 1, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+};
+
+// ----- Add lobby -----
+constexpr Widget ADD_LOBBY_WIDGETS[] = {
+    uiRect(0, 0, 320, 30, PAL_BAR),
+    uiLabel(160, 15, "Add Lobby", 2, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+    uiText(20, 55, "Enter Lobby Name:", 2, TL_DATUM, PAL_TEXT),
+    uiRegion(20, 85, 280, 30, PAL_BACKGROUND),             // Name input box
+    // [H] Save
+    uiImage(10, 190, ASSET_KEY_LEFT),
+    uiText(35, 202, "H", 2, MC_DATUM, PAL_INK),
+    uiText(90, 202, "Save", 2, MC_DATUM, PAL_INK),
+    // [F] Cancel
+    uiImage(165, 190, ASSET_KEY_RIGHT),
+    uiText(195, 202, "F", 2, MC_DATUM, PAL_TEXT),
+    uiText(255, 202, "Cancel", 2, MC_DATUM, PAL_INK),
+    // Frame after the keys: the images' corners would clip it, and it has
+    // the keys' own fill role, so painting it last gives the same pixels
+    uiFrame(10, 35, 300, 180, 8, PAL_PANEL),
+    // Status bar
+    uiRect(0, 220, 320, 20, PAL_BAR),
+    uiLabel(160, 230, "Use keypad to type", 1, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+};
+
+// ----- Edit username -----
+constexpr Widget EDIT_USER_WIDGETS[] = {
+    uiRect(0, 0, 320, 40, PAL_BAR),
+    uiLabel(160, 20, "Edit Username", 4, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+    uiRect(20, 70, 280, 50, PAL_PANEL),                    // Name field (text drawn on top)
+    uiRoundRect(40, 150, 100, 40, 6, PAL_GOOD),
+    uiLabel(90, 170, "SAVE", 2, MC_DATUM, PAL_INK, PAL_GOOD),
+    uiRoundRect(180, 150, 100, 40, 6, PAL_BAD),
+    uiLabel(230, 170, "CANCEL", 2, MC_DATUM, PAL_INK, PAL_BAD),
+};
+
+// ----- Chat -----
+constexpr Widget CHAT_WIDGETS[] = {
+    uiRect(0, 0, 320, 30, PAL_BAR),
+    uiLabel(5, 15, "< Back", 2, ML_DATUM, PAL_BAR_TEXT, PAL_BAR),
+    uiRegion(50, 0, 165, 30, PAL_BAR),                     // Channel name
+    uiRegion(215, 0, 105, 30, PAL_BAR),                    // Header clock
+    uiRegion(0, 30, 320, 180, PAL_BACKGROUND),             // Message body
+    uiRegion(0, 210, 320, 30, PAL_PANEL),                  // Draft bar
+};
+
+// ----- Diagnostics -----
+constexpr Widget DIAGNOSTICS_WIDGETS[] = {
+    uiRect(0, 0, 320, 30, PAL_BAR),
+    uiLabel(160, 15, "Diagnostics", 2, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+    uiRegion(0, 32, 320, 186, PAL_BACKGROUND),             // Counter rows
+    uiRect(0, 220, 320, 20, PAL_PANEL),
+    uiLabel(160, 230, "F: back  1: links  0: dump  C: reset", 1, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+};
+
+// ----- Link quality -----
+constexpr Widget LINK_STATS_WIDGETS[] = {
+    uiRect(0, 0, 320, 30, PAL_BAR),
+    uiText(5, 34, "Name", 1, TL_DATUM, PAL_MUTED),
+    uiText(80, 34, "RSSI", 1, TL_DATUM, PAL_MUTED),
+    uiText(135, 34, "SNR", 1, TL_DATUM, PAL_MUTED),
+    uiText(168, 34, "Lat p50/p90", 1, TL_DATUM, PAL_MUTED),
+    uiText(240, 34, "Del", 1, TL_DATUM, PAL_MUTED),
+    uiText(272, 34, "Trend", 1, TL_DATUM, PAL_MUTED),
+    uiRegion(0, 44, 320, 176, PAL_BACKGROUND),             // Table rows
+    uiRect(0, 220, 320, 20, PAL_PANEL),
+    uiLabel(160, 230, "1: channels  2: senders  F: back", 1, MC_DATUM, PAL_PANEL_TEXT, PAL_PANEL),
+};
+
+constexpr UIScreen START_SCREEN       = UI_SCREEN(START_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen SETTINGS_SCREEN    = UI_SCREEN(SETTINGS_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen MESSAGES_SCREEN    = UI_SCREEN(MESSAGES_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen ADD_LOBBY_SCREEN   = UI_SCREEN(ADD_LOBBY_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen EDIT_USER_SCREEN   = UI_SCREEN(EDIT_USER_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen CHAT_SCREEN        = UI_SCREEN(CHAT_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen DIAGNOSTICS_SCREEN = UI_SCREEN(DIAGNOSTICS_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen LINK_STATS_SCREEN  = UI_SCREEN(LINK_STATS_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen DISCOVER_SCREEN    = UI_SCREEN(DISCOVER_WIDGETS, PAL_BACKGROUND);
+constexpr UIScreen SEARCH_SCREEN      = UI_SCREEN(SEARCH_WIDGETS, PAL_BACKGROUND);
+
+#endif // SCREENS_H
@@ -1,122 +1,176 @@
 #include "TFTHandler.h"
 #include "../DebugMacros.h"
+#include "../PerfCounters/PerfCounters.h"
+#include "../SerialTxHandler/SerialTxHandler.h"
+#include "../LinkStats/LinkStats.h"
+#include "../PowerManager/PowerManager.h"
+#include "../HistoryStore/HistoryStore.h"
+#include "../ChatLayout/ChatLayout.h"
+#include "../Subscriptions/Subscriptions.h"
+#include "../SearchIndex/SearchIndex.h"
+#include "../TextCodec/TextCodec.h"
+#include "../GpsHandler/GpsHandler.h"
+#include "../Theme/PaletteSprite.h"
+#include "../SmoothFont/SmoothFont.h"
+#include "../InputLatency/InputLatency.h"
+#include "Screens.h"
 
 int TFTHandler::chatScrollOffset = 0;
 int TFTHandler::messagesScrollOffset = 0;
 
+#define CHAT_FULL     0
+#define CHAT_MESSAGES 1
+#define CHAT_DRAFT    2
+
+
+// ================== CHANNEL LIST SOURCE ==================
+// Channels in activity order feed the virtualized Messages list
+static void* channelItemAt(size_t index) { return channelAtActivityIndex(index); }
+static void* channelNext(void* item)     { return ((Channel*) item)->activity_next; }
+static uint32_t channelVersion(void* item) { return ((Channel*) item)->unread_count; }
+
+// Rows render into a 4-bit palette sprite and go out in one DMA push; if the
+// sprite could not be allocated they are drawn straight to the panel
+static PaletteSprite* rowSprite = nullptr;
+
+static uint16_t spriteInk(byte role) { return role; }
+
+static void drawChannelRowOn(TFT_eSPI& c, uint16_t (*ink)(byte), Channel* ch, byte slot, int16_t y, int16_t h) {
+    const int contentH = 24;
+    const int paddingY = (h - contentH) / 2;
+
+    // Draw row background
+    c.fillRoundRect(10, y + paddingY, 300, contentH, 6, ink(PAL_PANEL));
+
+    // --- Draw button for index number ---
+    int btnX = 15;
+    int btnY = y + paddingY + 2;
+    int btnW = 28;
+    int btnH = contentH - 4;
+    c.fillRoundRect(btnX, btnY, btnW, btnH, 4, ink(PAL_BAR));
+    c.setTextColor(ink(PAL_BAR_TEXT), ink(PAL_BAR));
+    c.setTextDatum(MC_DATUM);
+    c.drawString(String(slot + 1), btnX + btnW / 2, btnY + btnH / 2, 2);
+
+    // --- Draw channel name beside button ---
+    c.setTextColor(ink(PAL_PANEL_TEXT), ink(PAL_PANEL));
+    c.setTextDatum(ML_DATUM);
+    c.drawString(ch->name.c_str(), btnX + btnW + 10, y + h / 2, 2);
+
+    // --- Unread badge on the right ---
+    if (ch->unread_count > 0) {
+        String badge = ch->unread_count > 99 ? String("99+") : String(ch->unread_count);
+        int badgeW = 30;
+        int badgeX = 310 - badgeW - 6;
+        c.fillRoundRect(badgeX, btnY, badgeW, btnH, btnH / 2, ink(PAL_BAD));
+        c.setTextColor(ink(PAL_BAR_TEXT), ink(PAL_BAD));
+        c.setTextDatum(MC_DATUM);
+        c.drawString(badge, badgeX + badgeW / 2, btnY + btnH / 2, 2);
+    }
+}
 
-TFTHandler::TFTHandler() : lastTimeUpdate(0) {}
+static void drawChannelRow(TFT_eSPI& tft, void* item, byte slot, int16_t x, int16_t y, int16_t w, int16_t h) {
+    Channel* ch = (Channel*) item;
+    if (rowSprite && rowSprite->width() == w && rowSprite->height() == h) {
+        rowSprite->fillSprite(PAL_BACKGROUND);
+        drawChannelRowOn(*rowSprite, spriteInk, ch, slot, 0, h);
+        rowSprite->push(x, y);
+        return;
+    }
+    drawChannelRowOn(tft, Theme::color, ch, slot, y, h);
+}
+
+static const ListSource CHANNEL_LIST_SOURCE = {
+    channelItemAt, channelNext, channelVersion, drawChannelRow
+};
+
+TFTHandler::TFTHandler()
+    : chatChannel(nullptr),
+      linkStatsBySender(false),
+      searchSelection(0),
+      sendFailed(false),
+      channelList(0, 35, 320, 30, 5, PAL_BACKGROUND, CHANNEL_LIST_SOURCE),
+      shownLayout(nullptr),
+      dirty(0),
+      shownChatOffset(0),
+      anchorChannel(),
+      anchorIndex(0),
+      anchorY(0),
+      heightChannel(),
+      heightCount(0),
+      heightCache(0),
+      lastFrame(0),
+      lastDraftFrame(0),
+      frameCost(0),
+      frames_requested(0),
+      frames_rendered(0),
+      lastTimeUpdate(0),
+      lastDiagnosticsUpdate(0) {}
 
 void TFTHandler::begin() {
+    Theme::begin();
     tft.init();
     tft.setRotation(1);
+    tft.initDMA();
+    SmoothFont::begin();
+
+    rowSprite = new PaletteSprite(&tft);
+    if (!rowSprite->create(320, 30)) {
+        delete rowSprite;
+        rowSprite = nullptr;
+        WARN("Row sprite allocation failed, drawing rows directly");
+    }
+    ChatLayout::begin(&tft);
+    shownLayout = nullptr;
     current_screen = SCREEN_START;
+    dirty = 0;
     draw_StartScreen();
 }
 
-// ================== START SCREEN ==================
-void TFTHandler::draw_StartScreen() {
-    tft.fillScreen(TFT_BLACK);
-    tft.fillRect(0, 0, 320, 40, TFT_BLUE);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("MeshCrafted", 160, 20, 4);
-
-    int cx = 160, cy = 100;
-    tft.fillCircle(cx, cy, 40, TFT_GREEN);
-    tft.fillTriangle(cx + 50, cy, cx + 70, cy - 20, cx + 70, cy + 20, TFT_YELLOW);
-    tft.fillTriangle(cx + 80, cy, cx + 100, cy - 30, cx + 100, cy + 30, TFT_ORANGE);
-
-    tft.fillRoundRect(40, 160, 240, 30, 6, TFT_CYAN);
-    tft.setTextColor(TFT_BLACK, TFT_CYAN);
-    tft.drawString("1. MESSAGES", 160, 175, 2);
-
-    tft.fillRoundRect(40, 200, 240, 30, 6, TFT_CYAN);
-    tft.setTextColor(TFT_BLACK, TFT_CYAN);
-    tft.drawString("2. SETTINGS", 160, 215, 2);
+// Switch the panel to a screen layout, repainting only what differs
+void TFTHandler::showLayout(const UIScreen& layout) {
+    WidgetRenderer::show(tft, shownLayout, layout);
+    shownLayout = &layout;
 }
 
+void TFTHandler::repaintAll() {
+    shownLayout = nullptr;
+    channelList.invalidate();
+    invalidate(DIRTY_SCREEN);
+}
 
-void TFTHandler::draw_MessagesScreen() {
-// ==============================
-    // SCREEN LAYOUT CONFIGURATION
-    // ==============================
-    const int totalHeight   = 240;
-    const int headerHeight  = 30;
-    const int footerHeight  = 20;
-    const int marginY       = 5;
-    const int visibleHeight = totalHeight - (headerHeight + footerHeight + 2 * marginY); // = 180
+// ================== START SCREEN ==================
+void TFTHandler::draw_StartScreen() {
+    showLayout(START_SCREEN);
+}
 
-    // Row geometry
-    const int rowHeight = 30;  // includes padding + content
-    const int contentH  = 24;
-    const int paddingY  = (rowHeight - contentH) / 2;
 
-    const int startY = headerHeight + marginY;
-    const int endY   = startY + visibleHeight;
+void TFTHandler::draw_MessagesScreen(bool fullRedraw) {
+    // Row geometry (must match channelList)
+    const int rowHeight = 30;
+    const int visibleHeight = 180;
 
     // --- Scroll clamping ---
     int totalListHeight = all_channels.size() * rowHeight;
     int maxOffset = max(totalListHeight - visibleHeight, 0);
     messagesScrollOffset = constrain(messagesScrollOffset, 0, maxOffset);
 
-    // --- Calculate start index ---
-    int firstIndex = messagesScrollOffset / rowHeight;
-    int offsetWithinRow = messagesScrollOffset % rowHeight;
-    int y = startY - offsetWithinRow;
-
-    // --- Draw visible rows (up to 5) ---
-    // Draw header (title + time)
-    drawMessagesHeader();
-
-    tft.setTextDatum(ML_DATUM);
-    for (size_t i = 0; i < 5; ++i) {
-        if (y > endY) break;
-
-        size_t index = i + firstIndex;
-        if (index >= all_channels.size()) break;
-        Channel* ch = all_channels[index];
-        if (!ch) continue;
-
-        // Draw row background
-        tft.fillRoundRect(10, y + paddingY, 300, contentH, 6, TFT_DARKGREY);
-
-        // --- Draw button for index number ---
-        int btnX = 15;
-        int btnY = y + paddingY + 2;
-        int btnW = 28;
-        int btnH = contentH - 4;
-        tft.fillRoundRect(btnX, btnY, btnW, btnH, 4, TFT_BLUE);
-        tft.setTextColor(TFT_WHITE, TFT_BLUE);
-        tft.setTextDatum(MC_DATUM);
-        tft.drawString(String(i + 1), btnX + btnW / 2, btnY + btnH / 2, 2);
-
-        // --- Draw channel name beside button ---
-        tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
-        tft.setTextDatum(ML_DATUM);
-        tft.drawString(ch->name, btnX + btnW + 10, y + rowHeight / 2, 2);
-
-        y += rowHeight;
+    // Static frame + clock on entry; the row region is cleared by the layout
+    if (fullRedraw) {
+        showLayout(MESSAGES_SCREEN);
+        drawHeaderTime();
+        channelList.invalidate();
     }
 
+    // Only rows whose channel or badge changed are repainted
+    channelList.draw(tft, messagesScrollOffset / rowHeight);
 }
 
 
-void TFTHandler::drawMessagesHeader() {
-    tft.fillRect(0, 0, 320, 30, TFT_BLUE);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("Messages", 160, 15, 2);
-    
-    // Display current date and time in the top right corner (full redraw)
-    drawHeaderTime();
-    updateMessagesHeaderTime();
-}
-
 void TFTHandler::drawHeaderTime() {
     // Draw time unconditionally for full redraws
     String currentTimeStr = getTime();
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
+    tft.setTextColor(Theme::color(PAL_BAR_TEXT), Theme::color(PAL_BAR));
     tft.setTextDatum(MR_DATUM);
     tft.drawString(currentTimeStr, 315, 15, 1);
 }
@@ -131,90 +185,31 @@ void TFTHandler::updateMessagesHeaderTime() {
     
     // Only redraw the time portion (small area in the top right)
     // Clear only the time area to avoid flickering
-    tft.fillRect(270, 5, 50, 20, TFT_BLUE);
+    tft.fillRect(270, 5, 50, 20, Theme::color(PAL_BAR));
     
     // Display current date and time in the top right corner
     String currentTimeStr = getTime();
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
+    tft.setTextColor(Theme::color(PAL_BAR_TEXT), Theme::color(PAL_BAR));
     tft.setTextDatum(MR_DATUM);
     tft.drawString(currentTimeStr, 315, 15, 1);
 }
 
-void TFTHandler::drawMessagesFooter() {
-    // ==============================
-    // CONTROL BUTTON ROW (6th slot)
-    // ==============================
-    const int footerStartY = 185 + 5;   // just below 6th visible row (rowHeight * 6)
-    const int btnW = 145;
-    const int btnH = 24;
-    const int gap  = 10;
-
-    // --- Left button: [F1] Add Lobby ---
-    {
-        // Yellow rectangular button
-        const int btnX = 10;
-        tft.fillRoundRect(btnX, footerStartY, btnW, btnH, 6, TFT_DARKGREY);
-
-        // Draw F1 as small key button
-        const int keyW = 30, keyH = 20;
-        const int keyX = btnX + 10;
-        const int keyY = footerStartY + (btnH - keyH) / 2;
-        tft.fillRoundRect(keyX, keyY, keyW, keyH, 3, TFT_YELLOW);
-        tft.setTextColor(TFT_BLACK);
-        tft.setTextDatum(MC_DATUM);
-        tft.drawString("F1", keyX + keyW / 2, keyY + keyH / 2, 2);
-
-        // Label next to F1 key
-        tft.setTextColor(TFT_BLACK);
-        tft.drawString("Add Lobby", keyX + keyW * 2 + 10, footerStartY + btnH / 2, 2);
-    }
-
-    // --- Right button: [ESC] Main Menu ---
-    {
-        // Red oval button
-        const int btnX = 10 + btnW + gap;
-        tft.fillRoundRect(btnX, footerStartY, btnW, btnH, btnH / 2, TFT_DARKGREY);
-
-        // Draw ESC as oval key
-        const int keyW = 40, keyH = 20;
-        const int keyX = btnX + 10;
-        const int keyY = footerStartY + (btnH - keyH) / 2;
-        tft.fillRoundRect(keyX, keyY, keyW, keyH, keyH / 2, TFT_RED);
-        tft.setTextColor(TFT_WHITE);
-        tft.setTextDatum(MC_DATUM);
-        tft.drawString("Esc", keyX + keyW / 2, keyY + keyH / 2, 2);
-
-        // Label next to ESC key
-        tft.setTextColor(TFT_BLACK);
-        tft.drawString("Main Menu", keyX + keyW * 1.5 + 20, footerStartY + btnH / 2, 2);
-    }
-
-    // ==============================
-    // BOTTOM STATUS BAR
-    // ==============================
-    const int statusBarY = 220;
-    const int statusBarH = 20;
-    tft.fillRect(0, statusBarY, 320, statusBarH, TFT_BLUE);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("MeshCrafted 1.0", 160, statusBarY + statusBarH / 2, 1);
-}
-
 void TFTHandler::scrollMessagesUp() {
-    const int scrollStep = 30;  // exactly one row per scroll
-    messagesScrollOffset -= scrollStep;
-    if (messagesScrollOffset < 0) messagesScrollOffset = 0;
-    draw_MessagesScreen();
+    scrollMessagesBy(-30);  // exactly one row per scroll
 }
 
 void TFTHandler::scrollMessagesDown() {
+    scrollMessagesBy(30);
+}
+
+int TFTHandler::scrollMessagesBy(int dy) {
     const int rowHeight = 30;   // matches layout rowHeight
     const int visibleHeight = 180;  // 6 rows visible area
     int maxOffset = max((int)(all_channels.size() * rowHeight) - visibleHeight, 0);
 
-    messagesScrollOffset += rowHeight;
-    if (messagesScrollOffset > maxOffset) messagesScrollOffset = maxOffset;
-    draw_MessagesScreen();
+    int before = messagesScrollOffset;
+    messagesScrollOffset = constrain(messagesScrollOffset + dy, 0, maxOffset);
+    return messagesScrollOffset - before;
 }
 
 
@@ -228,92 +223,408 @@ int TFTHandler::getMessagesIncrement() {
 byte TFTHandler::get_currentScreen() { return current_screen; }
 void TFTHandler::set_CurrentScreen(byte _screen) { current_screen = _screen; }
 
+// ================== REDRAW SCHEDULING ==================
+void TFTHandler::invalidate(byte regions) {
+    dirty |= regions;
+    frames_requested++;
+}
+
+// Repaint the dirty regions of the current screen. Invalidations between
+// frames coalesce (a full-screen flag subsumes the partial ones), so a burst
+// of packets or keys costs one draw; intermediate states are never queued.
+void TFTHandler::render() {
+    if (!dirty) return;
+    unsigned long now = millis();
+
+    // Draft line first: cheap, and what the user is waiting on while typing
+    if (current_screen == SCREEN_CHAT && chatChannel &&
+        (dirty & DIRTY_DRAFT) && !(dirty & DIRTY_SCREEN) &&
+        now - lastDraftFrame >= DRAFT_INTERVAL_MS) {
+        InputLatency::frameStarted();
+        dirty &= ~DIRTY_DRAFT;
+        drawChatDraft(text_draft);
+        lastDraftFrame = now;
+        frames_rendered++;
+        if (!dirty) {
+            InputLatency::frameDone();
+            return;
+        }
+    }
+
+    // Everything else waits for the frame budget; a frame that took longer
+    // than the budget stretches the interval so rendering can't starve the loop
+    if (now - lastFrame < max((unsigned long) FRAME_INTERVAL_MS, frameCost)) return;
+
+    InputLatency::frameStarted();
+    byte regions = dirty;
+    dirty = 0;
+    bool full = regions & DIRTY_SCREEN;
+
+    switch (current_screen) {
+        case SCREEN_START:
+            draw_StartScreen();
+            break;
+        case SCREEN_SETTINGS:
+            draw_SettingsScreen();
+            break;
+        case SCREEN_MESSAGES:
+            draw_MessagesScreen(full);
+            break;
+        case SCREEN_EDIT_USER:
+            draw_EditUserInfoScreen(full, text_draft);
+            break;
+        case SCREEN_CREATE:
+            draw_AddLobbyScreen(text_draft, full);
+            break;
+        case SCREEN_DIAGNOSTICS:
+            draw_DiagnosticsScreen(full);
+            break;
+        case SCREEN_LINK_STATS:
+            draw_LinkStatsScreen(linkStatsBySender);
+            break;
+        case SCREEN_DISCOVER:
+            draw_DiscoverScreen();
+            break;
+        case SCREEN_SEARCH:
+            draw_SearchScreen(text_draft, regions);
+            break;
+        case SCREEN_CHAT:
+            if (!chatChannel) break;
+            if (full) {
+                draw_ChatScreen(chatChannel->ID, text_draft, CHAT_FULL);
+                break;
+            }
+            if (regions & DIRTY_DRAFT) drawChatDraft(text_draft);
+            if (regions & DIRTY_BODY)        drawChatMessages(chatChannel);
+            else if (regions & DIRTY_SCROLL) scrollChatView(chatChannel);
+            break;
+    }
+
+    lastFrame = lastDraftFrame = millis();
+    frameCost = lastFrame - now;
+    frames_rendered++;
+    if (!dirty) InputLatency::frameDone();
+}
+
 void TFTHandler::draw_SettingsScreen() {
-    tft.fillScreen(TFT_BLACK);
-    tft.fillRect(0, 0, 320, 30, TFT_BLUE);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("Settings", 160, 15, 2);
+    showLayout(SETTINGS_SCREEN);
+}
 
-    int y = 50, rowHeight = 30, spacing = 10;
-    tft.fillRoundRect(40, y, 240, rowHeight, 6, TFT_DARKGREY);
-    tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("1. Edit Username", 160, y + rowHeight / 2, 2);
+// ================== DIAGNOSTICS ==================
+// One histogram row; up to 77 characters with 10-digit counters
+static void formatStat(char* line, size_t size, const char* name, const PerfStat& s) {
+    snprintf(line, size, "%-9s n=%lu avg=%lu p90<=%lu max=%lu us",
+             name, (unsigned long) s.count, (unsigned long) s.avg_us(),
+             (unsigned long) s.percentile_us(90), (unsigned long) s.max_us);
+}
 
-    y += rowHeight + spacing;
-    tft.fillRoundRect(40, y, 240, rowHeight, 6, TFT_DARKGREY);
-    tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("2. Change Theme", 160, y + rowHeight / 2, 2);
+void TFTHandler::draw_DiagnosticsScreen(bool fullRedraw) {
+    if (fullRedraw) showLayout(DIAGNOSTICS_SCREEN);
 
-    y += rowHeight + spacing;
-    tft.fillRoundRect(40, y, 240, rowHeight, 6, TFT_DARKGREY);
-    tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("3. Connectivity", 160, y + rowHeight / 2, 2);
+    // Value rows: one line per probe, redrawn in place
+    const int rowHeight = 18;
+    int y = 38;
+    char line[96];
 
-    tft.fillRect(0, 220, 320, 20, TFT_DARKGREY);
-    tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
+    tft.fillRect(0, 32, 320, 186, Theme::color(PAL_BACKGROUND));
+    tft.setTextDatum(TL_DATUM);
+
+    tft.setTextColor(Theme::color(PAL_ACCENT), Theme::color(PAL_BACKGROUND));
+    snprintf(line, sizeof(line), "Loop %lu Hz   Packets %lu/s (%lu)",
+             (unsigned long) PerfCounters::loopsPerSecond(),
+             (unsigned long) PerfCounters::packetsPerSecond(),
+             (unsigned long) PerfCounters::packetsTotal());
+    tft.drawString(line, 5, y, 2);
+    y += rowHeight;
+
+    // Heap free/largest block, then the smooth-font glyph cache hit rate
+    snprintf(line, sizeof(line), "Heap %lu/%lu  Glyphs %u%% of %lu",
+             (unsigned long) PerfCounters::heapFree(),
+             (unsigned long) PerfCounters::heapLargestBlock(),
+             (unsigned) SmoothFont::hitRate(),
+             (unsigned long) (SmoothFont::hits() + SmoothFont::misses()));
+    tft.drawString(line, 5, y, 2);
+    y += rowHeight + 4;
+
+    tft.setTextColor(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
+    for (byte p = 0; p < PERF_PROBES; ++p) {
+        formatStat(line, sizeof(line), PerfCounters::probeName(p), PerfCounters::stat(p));
+        tft.drawString(line, 5, y, 1);
+        y += rowHeight - 4;
+    }
+
+    // Keypress to pixels; the per-stage split is in the DIAG dump
+    formatStat(line, sizeof(line), InputLatency::stageName(LAT_TOTAL), InputLatency::stat(LAT_TOTAL));
+    tft.drawString(line, 5, y, 1);
+    y += rowHeight;
+
+    tft.setTextColor(Theme::color(PAL_WARN), Theme::color(PAL_BACKGROUND));
+    uint32_t plain = TextCodec::plainBytes();
+    snprintf(line, sizeof(line), "TX queued %u  peak %u  dropped %lu  text %u%%%s",
+             (unsigned) SerialTxHandler::pending(), (unsigned) SerialTxHandler::highWatermark(),
+             (unsigned long) SerialTxHandler::droppedLines(),
+             plain ? (unsigned) (TextCodec::packedBytes() * 100 / plain) : 100,
+             TextCodec::linkSupports() ? " Z1" : "");
+    tft.drawString(line, 5, y, 1);
+    y += rowHeight - 4;
+
+    // Frames drawn/requested, then GPS: satellites, PPS, last RTC step
+    const GpsFix& gps = GpsHandler::fix();
+    snprintf(line, sizeof(line), "Frames %lu/%lu  GPS %s %usv%s rtc %+lds",
+             frames_rendered, frames_requested,
+             GpsHandler::hasFix() ? "fix" : "--", gps.satellites,
+             GpsHandler::ppsActive() ? " PPS" : "", (long) GpsHandler::lastStep());
+    tft.drawString(line, 5, y, 1);
+    y += rowHeight - 4;
+
+    // Seconds spent in each power state since boot
+    tft.setTextColor(Theme::color(PAL_GOOD), Theme::color(PAL_BACKGROUND));
+    int len = snprintf(line, sizeof(line), "Power");
+    for (byte s = 0; s < PWR_STATES && len < (int) sizeof(line) - 16; ++s) {
+        len += snprintf(line + len, sizeof(line) - len, " %s %lus",
+                        PowerManager::stateName(s), PowerManager::timeIn(s) / 1000);
+    }
+    tft.drawString(line, 5, y, 1);
+    y += rowHeight - 4;
+
+    tft.setTextColor(Theme::color(PAL_ACCENT), Theme::color(PAL_BACKGROUND));
+    snprintf(line, sizeof(line), "Pools usr %u/%u chn %u/%u msg %u/%u  frag %u%%",
+             user_pool.stats().live, POOL_USERS, channel_pool.stats().live, POOL_CHANNELS,
+             message_pool.stats().live, POOL_MESSAGES, PerfCounters::heapFragmentation());
+    tft.drawString(line, 5, y, 1);
+
+    lastDiagnosticsUpdate = millis();
+}
+
+void TFTHandler::updateDiagnosticsScreen() {
+    if (millis() - lastDiagnosticsUpdate < 1000) return;
+    lastDiagnosticsUpdate = millis();
+    invalidate(DIRTY_BODY);
+}
+
+// ================== LINK QUALITY ==================
+void TFTHandler::draw_LinkStatsScreen(bool bySender) {
+    showLayout(LINK_STATS_SCREEN);
+
+    // Title depends on the view; rows are redrawn from scratch
+    tft.fillRect(0, 0, 320, 30, Theme::color(PAL_BAR));
+    tft.setTextColor(Theme::color(PAL_BAR_TEXT), Theme::color(PAL_BAR));
     tft.setTextDatum(MC_DATUM);
-    tft.drawString("Press number to select / * to go back", 160, 230, 1);
+    tft.drawString(bySender ? "Links by Sender" : "Links by Channel", 160, 15, 2);
+    tft.fillRect(0, 44, 320, 176, Theme::color(PAL_BACKGROUND));
+    tft.setTextDatum(TL_DATUM);
+
+    const int rowHeight = 22;
+    const int sparkX = 270;
+    int y = 46;
+
+    byte size = bySender ? LinkStats::MAX_SENDERS : LinkStats::MAX_CHANNELS;
+    for (byte i = 0; i < size && y + rowHeight <= 218; ++i) {
+        const LinkAggregate& e = bySender ? LinkStats::sender(i) : LinkStats::channel(i);
+        if (e.messages == 0 && e.reports == 0) continue;
+
+        // Resolve a display name for the ID
+        String name = e.id;
+        if (bySender) {
+            User* u = findUserById(name);
+            if (u) name = u->username.c_str();
+        } else {
+            Channel* ch = findChannelById(name);
+            if (ch) name = ch->name.c_str();
+        }
+        if (name.length() > 12) name = name.substring(0, 12);
+
+        char col[24];
+        tft.setTextColor(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
+        tft.drawString(name, 5, y + 6, 1);
+
+        if (e.reports > 0) {
+            // Colour the RSSI column by link health
+            byte health = e.ewma_rssi > -90 ? PAL_GOOD : (e.ewma_rssi > -110 ? PAL_WARN : PAL_BAD);
+            tft.setTextColor(Theme::color(health), Theme::color(PAL_BACKGROUND));
+            snprintf(col, sizeof(col), "%d", (int) e.ewma_rssi);
+            tft.drawString(col, 80, y + 2, 1);
+            tft.setTextColor(Theme::color(PAL_MUTED), Theme::color(PAL_BACKGROUND));
+            snprintf(col, sizeof(col), "%d..%d", e.min_rssi, e.max_rssi);
+            tft.drawString(col, 80, y + 12, 1);
+
+            tft.setTextColor(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
+            snprintf(col, sizeof(col), "%.1f", e.ewma_snr);
+            tft.drawString(col, 135, y + 6, 1);
+
+            snprintf(col, sizeof(col), "%lu/%lu",
+                     (unsigned long) e.latency_p50.value(), (unsigned long) e.latency_p90.value());
+            tft.drawString(col, 168, y + 6, 1);
+        } else {
+            tft.setTextColor(Theme::color(PAL_MUTED), Theme::color(PAL_BACKGROUND));
+            tft.drawString("no reports", 80, y + 6, 1);
+        }
+
+        float ratio = min(e.deliveryRatio(), 1.0f);
+        tft.setTextColor(Theme::color(ratio >= 0.8f ? PAL_GOOD : (ratio >= 0.5f ? PAL_WARN : PAL_BAD)),
+                         Theme::color(PAL_BACKGROUND));
+        snprintf(col, sizeof(col), "%d%%", (int) (ratio * 100 + 0.5f));
+        tft.drawString(col, 240, y + 6, 1);
+
+        // RSSI sparkline, oldest sample on the left
+        byte samples = min<uint32_t>(e.reports, (uint32_t) LinkAggregate::SPARK_LEN);
+        for (byte j = LinkAggregate::SPARK_LEN - samples; j < LinkAggregate::SPARK_LEN; ++j) {
+            int8_t v = e.spark[(e.spark_head + j) % LinkAggregate::SPARK_LEN];
+            int h = map(constrain(v, -120, -30), -120, -30, 1, rowHeight - 4);
+            uint16_t color = Theme::color(v > -90 ? PAL_GOOD : (v > -110 ? PAL_WARN : PAL_BAD));
+            tft.fillRect(sparkX + j * 3, y + rowHeight - 2 - h, 2, h, color);
+        }
+
+        y += rowHeight;
+    }
 }
 
-// ================== EDIT USER ==================
-void TFTHandler::draw_EditUserInfoScreen(bool fullRedraw, String _text_draft) {
-    if (_text_draft == "" && local_user) {
-        _text_draft = local_user->username;
+// ================== DISCOVERY ==================
+void TFTHandler::draw_DiscoverScreen() {
+    showLayout(DISCOVER_SCREEN);
+
+    char line[48];
+    tft.fillRect(0, 0, 320, 30, Theme::color(PAL_BAR));
+    tft.setTextColor(Theme::color(PAL_BAR_TEXT), Theme::color(PAL_BAR));
+    tft.setTextDatum(MC_DATUM);
+    snprintf(line, sizeof(line), "Discover (%s, %lu filtered)",
+             Subscriptions::discoveryEnabled() ? "on" : "off",
+             (unsigned long) Subscriptions::rejected());
+    tft.drawString(line, 160, 15, 2);
+    tft.fillRect(0, 44, 320, 176, Theme::color(PAL_BACKGROUND));
+    tft.setTextDatum(TL_DATUM);
+
+    if (!Subscriptions::discoveryEnabled()) {
+        tft.setTextColor(Theme::color(PAL_MUTED), Theme::color(PAL_BACKGROUND));
+        tft.drawString("Discovery is off. Press C to list", 5, 60, 2);
+        tft.drawString("channels heard on the mesh.", 5, 80, 2);
+        return;
+    }
+    if (Subscriptions::discoveredCount() == 0) {
+        tft.setTextColor(Theme::color(PAL_MUTED), Theme::color(PAL_BACKGROUND));
+        tft.drawString("No unknown channels heard yet", 5, 60, 2);
+        return;
     }
 
-    if (fullRedraw) {
-        tft.fillScreen(TFT_BLACK);
-        tft.fillRect(0, 0, 320, 40, TFT_BLUE);
-        tft.setTextColor(TFT_WHITE, TFT_BLUE);
+    const int rowHeight = 20;
+    int y = 48;
+    unsigned long now = millis();
+    for (byte i = 0; i < Subscriptions::discoveredCount(); ++i) {
+        const DiscoveredChannel& d = Subscriptions::discovered(i);
+
+        tft.setTextColor(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
+        snprintf(line, sizeof(line), "%u. %s", i + 1, d.id.c_str());
+        tft.drawString(line, 5, y, 2);
+
+        tft.setTextColor(Theme::color(PAL_ACCENT), Theme::color(PAL_BACKGROUND));
+        snprintf(line, sizeof(line), "%u", d.packets);
+        tft.drawString(line, 190, y, 2);
+
+        unsigned long age = (now - d.last_seen) / 1000;
+        if (age < 60) snprintf(line, sizeof(line), "%lus", age);
+        else          snprintf(line, sizeof(line), "%lum", age / 60);
+        tft.drawString(line, 250, y, 2);
+        y += rowHeight;
+    }
+}
+
+// ================== SEARCH ==================
+void TFTHandler::draw_SearchScreen(const String& query, byte regions) {
+    bool full = regions & DIRTY_SCREEN;
+    if (full) showLayout(SEARCH_SCREEN);
+    char line[64];
+
+    if (full || (regions & DIRTY_BODY)) {
+        tft.fillRect(0, 0, 320, 30, Theme::color(PAL_BAR));
+        tft.setTextColor(Theme::color(PAL_BAR_TEXT), Theme::color(PAL_BAR));
         tft.setTextDatum(MC_DATUM);
-        tft.drawString("Edit Username", 160, 20, 4);
+        snprintf(line, sizeof(line), "Search (%u msgs, %u/%u KB)",
+                 SearchIndex::docsSearchable(),
+                 (unsigned) (SearchIndex::bytesUsed() / 1024),
+                 (unsigned) (SearchIndex::bytesBudget() / 1024));
+        tft.drawString(line, 160, 15, 2);
+    }
 
-        tft.fillRect(20, 70, 280, 50, TFT_DARKGREY);
-        tft.fillRoundRect(40, 150, 100, 40, 6, TFT_GREEN);
-        tft.setTextColor(TFT_BLACK, TFT_GREEN);
-        tft.drawString("SAVE", 90, 170, 2);
+    if (full || (regions & DIRTY_DRAFT)) {
+        tft.fillRoundRect(10, 36, 300, 26, 6, Theme::color(PAL_PANEL));
+        tft.setTextColor(Theme::color(PAL_PANEL_TEXT), Theme::color(PAL_PANEL));
+        tft.setTextDatum(ML_DATUM);
+        tft.drawString(query, 18, 49, 2);
+    }
+
+    if (!full && !(regions & DIRTY_BODY)) return;
 
-        tft.fillRoundRect(180, 150, 100, 40, 6, TFT_RED);
-        tft.setTextColor(TFT_BLACK, TFT_RED);
-        tft.drawString("CANCEL", 230, 170, 2);
+    tft.fillRect(0, 66, 320, 154, Theme::color(PAL_BACKGROUND));
+    tft.setTextDatum(TL_DATUM);
+    byte hits = SearchIndex::hitCount();
+    uint32_t covered = SearchIndex::lastQueryCovered();
+    uint32_t stored = SearchIndex::lastQueryStored();
+    if (hits == 0) {
+        tft.setTextColor(Theme::color(PAL_MUTED), Theme::color(PAL_BACKGROUND));
+        if (query.length() < 3) {
+            tft.drawString("Type 3+ characters, H to search", 10, 72, 2);
+        } else if (covered < stored) {
+            // Older messages were beyond the per-query scan
+            snprintf(line, sizeof(line), "No matches in newest %lu of %lu msgs",
+                     (unsigned long) covered, (unsigned long) stored);
+            tft.drawString(line, 10, 72, 2);
+        } else {
+            tft.drawString("No matches", 10, 72, 2);
+        }
+        return;
     }
 
-    tft.fillRect(22, 72, 276, 46, TFT_DARKGREY);
-    tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString(_text_draft, 160, 95, 2);
-}
+    const int rowHeight = 16;
+    int y = 70;
+    for (byte i = 0; i < hits; ++i, y += rowHeight) {
+        const SearchHit& h = SearchIndex::hit(i);
+        Channel* ch = channel_pool.get(h.channel);
+        bool selected = i == searchSelection;
+        uint16_t bg = Theme::color(selected ? PAL_PANEL : PAL_BACKGROUND);
+        if (selected) tft.fillRect(0, y - 1, 320, rowHeight, bg);
+
+        tft.setTextColor(Theme::color(PAL_ACCENT), bg);
+        snprintf(line, sizeof(line), "%.10s", ch ? ch->name.c_str() : "?");
+        tft.drawString(line, 5, y, 1);
+        tft.setTextColor(Theme::color(selected ? PAL_PANEL_TEXT : PAL_TEXT), bg);
+        snprintf(line, sizeof(line), "%.40s", h.preview);
+        tft.drawString(line, 70, y, 1);
+    }
 
-// ================== CHAT ==================
-#define CHAT_FULL     0
-#define CHAT_MESSAGES 1
-#define CHAT_DRAFT    2
+    tft.setTextColor(Theme::color(PAL_MUTED), Theme::color(PAL_BACKGROUND));
+    if (hits == SearchIndex::MAX_RESULTS) {
+        snprintf(line, sizeof(line), "%u newest hits in %lu us", hits, SearchIndex::lastQueryUs());
+    } else {
+        snprintf(line, sizeof(line), "%u hits in %lu us, %lu of %lu msgs searched", hits,
+                 SearchIndex::lastQueryUs(), (unsigned long) covered, (unsigned long) stored);
+    }
+    tft.drawString(line, 5, y + 4, 1);
+}
 
-void TFTHandler::drawUpdate() {
-    switch (current_screen) {
-        case SCREEN_START: draw_StartScreen(); break;
-        case SCREEN_MESSAGES: draw_MessagesScreen(); break;
-        case SCREEN_SETTINGS: draw_SettingsScreen(); break;
-        case SCREEN_CHAT: break; // handled externally
+// ================== EDIT USER ==================
+void TFTHandler::draw_EditUserInfoScreen(bool fullRedraw, String _text_draft) {
+    if (_text_draft == "" && local_user) {
+        _text_draft = local_user->username.c_str();
     }
+
+    if (fullRedraw) showLayout(EDIT_USER_SCREEN);
+
+    tft.fillRect(22, 72, 276, 46, Theme::color(PAL_PANEL));
+    tft.setTextColor(Theme::color(PAL_PANEL_TEXT), Theme::color(PAL_PANEL));
+    tft.setTextDatum(MC_DATUM);
+    tft.drawString(_text_draft, 160, 95, 2);
 }
 
-void TFTHandler::draw_ChatScreen(String _channel_id, String& _text_draft, byte mode) {
+// ================== CHAT ==================
+void TFTHandler::draw_ChatScreen(const IdString& _channel_id, String& _text_draft, byte mode) {
     Channel* _channel = findChannelById(_channel_id);
     if (!_channel) return;
 
     if (mode == CHAT_FULL) {
-        tft.fillScreen(TFT_BLACK);
-        tft.fillRect(0, 0, 320, 30, TFT_BLUE);
-        tft.setTextColor(TFT_WHITE, TFT_BLUE);
-        tft.setTextDatum(ML_DATUM);
-        tft.drawString("< Back", 5, 15, 2);
+        showLayout(CHAT_SCREEN);
+        tft.setTextColor(Theme::color(PAL_BAR_TEXT), Theme::color(PAL_BAR));
         tft.setTextDatum(MC_DATUM);
-        tft.drawString(_channel->name, 160, 15, 2);
+        tft.drawString(_channel->name.c_str(), 160, 15, 2);
         
         // Display current date and time in the top right corner (full redraw)
         drawHeaderTime();
@@ -322,7 +633,7 @@ void TFTHandler::draw_ChatScreen(String _channel_id, String& _text_draft, byte m
         drawChatMessages(_channel);
         drawChatDraft(_text_draft);
     } else if (mode == CHAT_MESSAGES) {
-        tft.fillRect(0, 35, 320, 170, TFT_BLACK);
+        tft.fillRect(0, 35, 320, 170, Theme::color(PAL_BACKGROUND));
         drawChatMessages(_channel);
     } else if (mode == CHAT_DRAFT) {
         drawChatDraft(_text_draft);
@@ -330,248 +641,286 @@ void TFTHandler::draw_ChatScreen(String _channel_id, String& _text_draft, byte m
 }
 
 void TFTHandler::drawChatMessages(Channel* channel) {
-    tft.fillRect(0, 40, tft.width(), 160, TFT_BLACK);
-    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    PERF_SCOPE(PERF_CHAT_DRAW);
+    drawChatBand(channel, CHAT_VIEW_TOP, CHAT_VIEW_BOTTOM);
+    shownChatOffset = chatScrollOffset;
+}
+
+// Anti-aliased chat text when the flash font is usable, font 2 otherwise
+static byte chatFont() {
+    return SmoothFont::ready() && SmoothFont::lineHeight() <= TFTHandler::CHAT_LINE_HEIGHT
+        ? FONT_SMOOTH : (byte) TFTHandler::CHAT_FONT;
+}
+
+static void drawChatText(TFT_eSPI& tft, const char* text, size_t len, int x, int y, byte font) {
+    if (font == FONT_SMOOTH) SmoothFont::drawString(tft, text, len, x, y);
+    else                     tft.drawString(text, x, y, font);
+}
+
+void TFTHandler::drawChatBand(Channel* channel, int bandTop, int bandBottom) {
+    // Clip to the band so rows straddling its edges don't bleed outside
+    tft.setViewport(0, bandTop, tft.width(), bandBottom - bandTop, false);
+    tft.fillRect(0, bandTop, tft.width(), bandBottom - bandTop, Theme::color(PAL_BACKGROUND));
+    tft.setTextColor(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
     tft.setTextDatum(TL_DATUM);
+    SmoothFont::setColors(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
+    byte font = chatFont();
 
-    const int lineHeight = 20;
-    const int topY = 40;
-    const int bottomY = 200;
-    int y = topY - chatScrollOffset;
+    const int lineHeight = CHAT_LINE_HEIGHT;
+    int contentY;
+    size_t first = seekChatAnchor(channel, contentY);
+    int y = CHAT_VIEW_TOP + contentY - chatScrollOffset;
 
-    for (Message* msg : channel->channel_messages) {
+    for (size_t i = first; i < channel->channel_messages.size(); ++i) {
+        Message* msg = channel->channel_messages[i];
         if (!msg) continue;
-        if (y + lineHeight > topY && y < bottomY) {
-            User* sender = findUserById(msg->sender_id);
-            bool isOwnMessage = (sender && sender->ID == local_user->ID);
-            
-            if (isOwnMessage) {
-                // Display our own message: "You: message"
-                String line = "You: " + msg->message;
-                tft.drawString(line, 5, y, 2);
-                y += lineHeight;
-                
-                // Display latency only if available
-                if (msg->latency_set) {
-                    String latencyInfo = "  [Latency: " + String(msg->latency) + "ms]";
-                    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-                    tft.drawString(latencyInfo, 5, y, 1);
-                    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                    y += lineHeight;
-                }
-            } else {
-                // Display neighbor's message
-                String senderName = sender ? sender->username : msg->sender_id;
-                String line = senderName + ": " + msg->message;
-                tft.drawString(line, 5, y, 2);
-                y += lineHeight;
-                
-                // Display timestamp
-                tft.setTextColor(TFT_LIGHTGREY, TFT_BLACK);
-                String timestampStr = "  [" + msg->time_stamp + "]";
-                tft.drawString(timestampStr, 5, y, 1);
-                tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                y += lineHeight;
-                
-                // Display signal quality (RSSI, SNR, Latency) if available
-                if (msg->latency_set) {
-                    String signalInfo = "  [RSSI:" + String(msg->rssi) + " SNR:" + String(msg->snr) + " Lat:" + String(msg->latency) + "ms]";
-                    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-                    tft.drawString(signalInfo, 5, y, 1);
-                    tft.setTextColor(TFT_WHITE, TFT_BLACK);
-                    y += lineHeight;
-                }
+        if (y >= bandBottom) break;
+
+        String prefix;
+        bool isOwnMessage;
+        int height = layoutChatMessage(msg, prefix, isOwnMessage);
+
+        // Messages above the band only advance y by their laid-out height
+        if (y + height <= bandTop) {
+            y += height;
+            continue;
+        }
+
+        // Body: prefix on the first line, then the wrapped segments
+        // Packed bodies are expanded for the rows being drawn only
+        size_t bodyLen;
+        const char* body = TextCodec::view(msg->message, bodyLen);
+        size_t lines = msg->line_breaks.size() + 1;
+        int ly = y;
+        for (size_t l = 0; l < lines; ++l, ly += lineHeight) {
+            if (ly + lineHeight <= bandTop || ly >= bandBottom) continue;
+            size_t from = l == 0 ? 0 : msg->line_breaks[l - 1];
+            size_t to   = l + 1 < lines ? msg->line_breaks[l] : bodyLen;
+
+            char segment[128];
+            size_t n = min(to - from, sizeof(segment) - 1);
+            memcpy(segment, body + from, n);
+            segment[n] = 0;
+
+            int x = 5;
+            if (l == 0) {
+                drawChatText(tft, prefix.c_str(), prefix.length(), x, ly, font);
+                x += msg->layout_indent;
             }
-        } else {
-            // Message is off-screen, but still need to advance y by its height
-            User* sender = findUserById(msg->sender_id);
-            bool isOwnMessage = (sender && sender->ID == local_user->ID);
-            
-            if (isOwnMessage) {
-                y += lineHeight;
-                if (msg->latency_set) y += lineHeight;
-            } else {
-                y += lineHeight;  // message
-                y += lineHeight;  // timestamp
-                if (msg->latency_set) y += lineHeight;
+            drawChatText(tft, segment, n, x, ly, font);
+        }
+
+        // Metadata lines below the body
+        if (!isOwnMessage) {
+            if (ly + lineHeight > bandTop && ly < bandBottom) {
+                tft.setTextColor(Theme::color(PAL_MUTED), Theme::color(PAL_BACKGROUND));
+                String timestampStr = "  [" + msg->time_stamp + "]";
+                tft.drawString(timestampStr, 5, ly, 1);
+                tft.setTextColor(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
             }
+            ly += lineHeight;
         }
+
+        if (msg->latency_set && ly + lineHeight > bandTop && ly < bandBottom) {
+            String signalInfo = isOwnMessage
+                ? "  [Latency: " + String(msg->latency) + "ms]"
+                : "  [RSSI:" + String(msg->rssi) + " SNR:" + String(msg->snr) + " Lat:" + String(msg->latency) + "ms]";
+            tft.setTextColor(Theme::color(PAL_WARN), Theme::color(PAL_BACKGROUND));
+            tft.drawString(signalInfo, 5, ly, 1);
+            tft.setTextColor(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
+        }
+
+        y += height;
     }
+
+    tft.resetViewport();
+}
+
+int TFTHandler::layoutChatMessage(Message* msg, String& prefix, bool& isOwnMessage) {
+    User* sender = findUserById(msg->sender_id);
+    isOwnMessage = (sender && sender->ID == local_user->ID);
+    if (isOwnMessage) {
+        prefix = "You: ";
+    } else {
+        prefix = String(sender ? sender->username.c_str() : msg->sender_id.c_str()) + ": ";
+    }
+
+    // Wrapped body lines (layout cached on the message)
+    byte font = chatFont();
+    int indent = ChatLayout::textWidth(prefix.c_str(), prefix.length(), font);
+    int lines = ChatLayout::layoutMessage(msg, font, CHAT_TEXT_WIDTH, indent);
+
+    if (!isOwnMessage) lines++;      // timestamp
+    if (msg->latency_set) lines++;   // signal quality / latency
+    return lines * CHAT_LINE_HEIGHT;
 }
 
 
 // ================== SCROLLING ==================
+// The ILI9341 vertical scroll area (VSCRDEF/VSCRSADD) runs along the panel's
+// native 320-line axis, which is horizontal in rotation 1, so it can't scroll
+// the chat body. Shifting rows through a GRAM readback costs more bus time
+// than repainting (reads are 3 bytes a pixel at SPI_READ_FREQUENCY), so a
+// scroll repaints the view; the anchor walk keeps that independent of
+// history length.
 int TFTHandler::calculateTotalMessagesHeight(Channel* channel) {
-    const int lineHeight = 20;
     int totalHeight = 0;
-    
+    String prefix;
+    bool isOwnMessage;
+
     for (Message* msg : channel->channel_messages) {
         if (!msg) continue;
-        
-        User* sender = findUserById(msg->sender_id);
-        bool isOwnMessage = (sender && sender->ID == local_user->ID);
-        
-        if (isOwnMessage) {
-            // Own message: 1 line for message
-            totalHeight += lineHeight;
-            // + 1 line for latency if available
-            if (msg->latency_set) {
-                totalHeight += lineHeight;
-            }
-        } else {
-            // Neighbor's message: 1 line for message
-            totalHeight += lineHeight;
-            // + 1 line for timestamp
-            totalHeight += lineHeight;
-            // + 1 line for signal quality if available
-            if (msg->latency_set) {
-                totalHeight += lineHeight;
-            }
-        }
+        totalHeight += layoutChatMessage(msg, prefix, isOwnMessage);
     }
     return totalHeight;
 }
 
+int TFTHandler::chatContentHeight(Channel* channel) {
+    if (channel_pool.get(heightChannel) != channel || heightCount != channel->_message_count) {
+        heightCache = calculateTotalMessagesHeight(channel);
+        heightChannel = channel_pool.handleOf(channel);
+        heightCount = channel->_message_count;
+    }
+    return heightCache;
+}
+
+void TFTHandler::invalidateChatLayout() {
+    heightChannel = PoolHandle();
+    anchorChannel = PoolHandle();
+}
+
+void TFTHandler::historyFrontChanged(Channel* channel, int count) {
+    invalidateChatLayout();
+    if (channel != chatChannel || count == 0) return;
+
+    // Height of the messages entering (count > 0) or leaving (count < 0) the front
+    int height = 0;
+    String prefix;
+    bool isOwnMessage;
+    size_t n = min((size_t) abs(count), channel->channel_messages.size());
+    for (size_t i = 0; i < n; ++i) {
+        Message* msg = channel->channel_messages[i];
+        if (msg) height += layoutChatMessage(msg, prefix, isOwnMessage);
+    }
+
+    if (count < 0) height = -height;
+    chatScrollOffset = max(chatScrollOffset + height, 0);
+    shownChatOffset += height;
+}
+
+size_t TFTHandler::seekChatAnchor(Channel* channel, int& y) {
+    const std::vector<Message*>& msgs = channel->channel_messages;
+    if (channel_pool.get(anchorChannel) != channel || anchorIndex >= msgs.size()) {
+        anchorChannel = channel_pool.handleOf(channel);
+        anchorIndex = 0;
+        anchorY = 0;
+    }
+
+    String prefix;
+    bool isOwnMessage;
+    // Back up while the anchor starts below the offset
+    while (anchorIndex > 0 && anchorY > chatScrollOffset) {
+        anchorIndex--;
+        Message* msg = msgs[anchorIndex];
+        if (msg) anchorY -= layoutChatMessage(msg, prefix, isOwnMessage);
+    }
+    // Advance past messages that end above the offset
+    while (anchorIndex + 1 < msgs.size()) {
+        Message* msg = msgs[anchorIndex];
+        int height = msg ? layoutChatMessage(msg, prefix, isOwnMessage) : 0;
+        if (anchorY + height > chatScrollOffset) break;
+        anchorY += height;
+        anchorIndex++;
+    }
+
+    y = anchorY;
+    return anchorIndex;
+}
+
+void TFTHandler::scrollChatView(Channel* channel) {
+    if (shownChatOffset == chatScrollOffset) return;
+    drawChatMessages(channel);
+}
+
 void TFTHandler::scrollChatUp() {
-    chatScrollOffset -= 20;
-    if (chatScrollOffset < 0) chatScrollOffset = 0;
+    scrollChatBy(chatChannel, -CHAT_LINE_HEIGHT);
 }
 
 void TFTHandler::scrollChatDown(Channel* channel) {
-    const int visibleHeight = 200 - 40;  // bottomY - topY
-    int totalHeight = calculateTotalMessagesHeight(channel);
-    int maxOffset = max(totalHeight - visibleHeight, 0);
-    chatScrollOffset += 20;
-    if (chatScrollOffset > maxOffset) chatScrollOffset = maxOffset;
+    scrollChatBy(channel, CHAT_LINE_HEIGHT);
+}
+
+int TFTHandler::scrollChatBy(Channel* channel, int dy) {
+    int before = chatScrollOffset;
+    if (!channel) {
+        chatScrollOffset = max(chatScrollOffset + dy, 0);
+        return chatScrollOffset - before;
+    }
+
+    const int visibleHeight = CHAT_VIEW_BOTTOM - CHAT_VIEW_TOP;
+    int contentHeight = chatContentHeight(channel);
+    int maxOffset = max(contentHeight - visibleHeight, 0);
+    chatScrollOffset = constrain(chatScrollOffset + dy, 0, maxOffset);
+    int moved = chatScrollOffset - before;
+
+    // Ask for the neighbouring page before a window edge is reached
+    // (may move the offset along with the messages it loads)
+    HistoryStore::prefetch(channel, chatScrollOffset, contentHeight, visibleHeight, CHAT_PREFETCH_PX);
+    return moved;
 }
 
 void TFTHandler::scrollToBottom(Channel* channel) {
-    const int visibleHeight = 200 - 40;  // bottomY - topY
-    int totalHeight = calculateTotalMessagesHeight(channel);
-    int maxOffset = max(totalHeight - visibleHeight, 0);
+    const int visibleHeight = CHAT_VIEW_BOTTOM - CHAT_VIEW_TOP;
+    int maxOffset = max(chatContentHeight(channel) - visibleHeight, 0);
     chatScrollOffset = maxOffset;
 }
 
+void TFTHandler::scrollToMessage(Channel* channel, size_t index) {
+    int y = 0;
+    String prefix;
+    bool isOwnMessage;
+    const std::vector<Message*>& msgs = channel->channel_messages;
+    for (size_t i = 0; i < index && i < msgs.size(); ++i) {
+        if (msgs[i]) y += layoutChatMessage(msgs[i], prefix, isOwnMessage);
+    }
+
+    const int visibleHeight = CHAT_VIEW_BOTTOM - CHAT_VIEW_TOP;
+    chatScrollOffset = min(y, max(chatContentHeight(channel) - visibleHeight, 0));
+}
+
 // ================== DRAFT ==================
 void TFTHandler::drawChatDraft(const String& draft) {
-    tft.fillRect(0, 210, 320, 30, TFT_DARKGREY);
-    tft.fillRect(5, 215, 220, 20, TFT_WHITE);
-    tft.setTextColor(TFT_BLACK, TFT_WHITE);
+    tft.fillRect(0, 210, 320, 30, Theme::color(PAL_PANEL));
+    tft.fillRect(5, 215, 220, 20, Theme::color(PAL_FIELD));
+    tft.setTextColor(Theme::color(PAL_FIELD_TEXT), Theme::color(PAL_FIELD));
     tft.setTextDatum(ML_DATUM);
     tft.drawString(draft, 10, 225, 2);
 
-    tft.fillRect(235, 215, 80, 20, TFT_GREEN);
-    tft.setTextColor(TFT_BLACK, TFT_GREEN);
+    byte button = sendFailed ? PAL_BAD : PAL_GOOD;
+    tft.fillRect(235, 215, 80, 20, Theme::color(button));
+    tft.setTextColor(Theme::color(PAL_INK), Theme::color(button));
     tft.setTextDatum(MC_DATUM);
-    tft.drawString("SEND", 275, 225, 2);
+    tft.drawString(sendFailed ? "RETRY" : "SEND", 275, 225, 2);
 }
 
 // ============================================================
 // ADD LOBBY SCREEN
 // ============================================================
 
-// --- Header ---
-void TFTHandler::drawAddLobbyHeader() {
-    tft.fillRect(0, 0, 320, 30, TFT_BLUE);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("Add Lobby", 160, 15, 2);
-}
-
-// --- Footer ---
-void TFTHandler::drawAddLobbyFooter() {
-    // ==============================
-    // CONTROL BUTTON ROW (bottom area)
-    // ==============================
-    const int footerStartY = 185 + 5;
-    const int btnW = 145;
-    const int btnH = 24;
-    const int gap  = 10;
-
-    // --- Left button: [H] Save ---
-    {
-        // Yellow rectangular button
-        const int btnX = 10;
-        tft.fillRoundRect(btnX, footerStartY, btnW, btnH, 6, TFT_DARKGREY);
-
-        // Draw H key as small yellow button
-        const int keyW = 30, keyH = 20;
-        const int keyX = btnX + 10;
-        const int keyY = footerStartY + (btnH - keyH) / 2;
-        tft.fillRoundRect(keyX, keyY, keyW, keyH, 3, TFT_YELLOW);
-        tft.setTextColor(TFT_BLACK);
-        tft.setTextDatum(MC_DATUM);
-        tft.drawString("H", keyX + keyW / 2, keyY + keyH / 2, 2);
-
-        // Label beside key
-        tft.setTextColor(TFT_BLACK);
-        tft.drawString("Save", keyX + keyW * 2 + 10, footerStartY + btnH / 2, 2);
-    }
-
-    // --- Right button: [F] Cancel ---
-    {
-        const int btnX = 10 + btnW + gap;
-        tft.fillRoundRect(btnX, footerStartY, btnW, btnH, btnH / 2, TFT_DARKGREY);
-
-        // Draw F key as red oval button
-        const int keyW = 40, keyH = 20;
-        const int keyX = btnX + 10;
-        const int keyY = footerStartY + (btnH - keyH) / 2;
-        tft.fillRoundRect(keyX, keyY, keyW, keyH, keyH / 2, TFT_RED);
-        tft.setTextColor(TFT_WHITE);
-        tft.setTextDatum(MC_DATUM);
-        tft.drawString("F", keyX + keyW / 2, keyY + keyH / 2, 2);
-
-        // Label beside F key
-        tft.setTextColor(TFT_BLACK);
-        tft.drawString("Cancel", keyX + keyW * 1.5 + 20, footerStartY + btnH / 2, 2);
-    }
-
-    // --- Bottom Status Bar ---
-    const int statusBarY = 220;
-    const int statusBarH = 20;
-    tft.fillRect(0, statusBarY, 320, statusBarH, TFT_BLUE);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("Use keypad to type", 160, statusBarY + statusBarH / 2, 1);
-}
-
-// --- Main Add Lobby Screen ---
-void TFTHandler::draw_AddLobbyScreen(const String& lobbyDraft) {
-
-    // ==============================
-    // INPUT FIELD AREA
-    // ==============================
-    const int marginY = 5;
-    const int headerHeight = 30;
-    const int footerHeight = 20;
-    const int visibleHeight = 180;
-    const int frameX = 10;
-    const int frameY = headerHeight + marginY;
-    const int frameW = 300;
-    const int frameH = visibleHeight;
-
-    // Frame border area (same as message screen)
-    tft.drawRoundRect(frameX, frameY, frameW, frameH, 8, TFT_DARKGREY);
-
-    // Input Label
-    tft.setTextColor(TFT_WHITE);
-    tft.setTextDatum(TL_DATUM);
-    tft.drawString("Enter Lobby Name:", frameX + 10, frameY + 20, 2);
+void TFTHandler::draw_AddLobbyScreen(const String& lobbyDraft, bool fullRedraw) {
+    // Frame, label and footer come from the layout
+    if (fullRedraw) showLayout(ADD_LOBBY_SCREEN);
 
     // Input box
-    const int boxX = frameX + 10;
-    const int boxY = frameY + 50;
-    const int boxW = frameW - 20;
+    const int boxX = 20;
+    const int boxY = 85;
+    const int boxW = 280;
     const int boxH = 30;
-    tft.fillRoundRect(boxX, boxY, boxW, boxH, 6, TFT_DARKGREY);
-    tft.drawRoundRect(boxX, boxY, boxW, boxH, 6, TFT_WHITE);
+    tft.fillRoundRect(boxX, boxY, boxW, boxH, 6, Theme::color(PAL_PANEL));
+    tft.drawRoundRect(boxX, boxY, boxW, boxH, 6, Theme::color(PAL_PANEL_TEXT));
 
     // Show typed text (lobbyDraft)
-    tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
+    tft.setTextColor(Theme::color(PAL_PANEL_TEXT), Theme::color(PAL_PANEL));
     tft.setTextDatum(ML_DATUM);
     tft.drawString(lobbyDraft, boxX + 8, boxY + boxH / 2, 2);
-
-    // Footer
-    drawAddLobbyFooter();
 }
@@ -3,6 +3,7 @@
 #include <TFT_eSPI.h>
 #include "../global_objects.h"
 #include "../PreferencesHandler.h"
+#include "../UIWidgets/UIWidgets.h"
 #include <vector>
 
 class TFTHandler {
@@ -17,26 +18,43 @@ public:
     static int messagesScrollOffset;
     void scrollMessagesUp();
     void scrollMessagesDown();
+    // Move the channel list by dy pixels (clamped); returns pixels moved
+    int scrollMessagesBy(int dy);
 
     // ================== SCREEN MANAGEMENT ==================
     // Draw the main start menu
     void draw_StartScreen();
 
-    // Draw the messages / channel list screen
-    void draw_MessagesScreen();
-    void drawMessagesHeader();
+    // Draw the messages / channel list screen, ordered by recent activity
+    // fullRedraw: also draw the header; otherwise only rows whose channel or
+    // unread badge changed since the last draw are repainted
+    void draw_MessagesScreen(bool fullRedraw = true);
     void drawHeaderTime();
     void updateMessagesHeaderTime();
-    void drawMessagesFooter();
     int getMessagesIncrement();
-    void draw_AddLobbyScreen(const String& lobbyDraft);
-    void drawAddLobbyHeader();
-    void drawAddLobbyFooter();
+
+    // Draw the add lobby screen; fullRedraw also shows the static frame
+    void draw_AddLobbyScreen(const String& lobbyDraft, bool fullRedraw = false);
     
 
     // Draw the settings menu
     void draw_SettingsScreen();
 
+    // Draw the diagnostics screen (performance counters)
+    // fullRedraw: redraw header/footer too; update refreshes values once a second
+    void draw_DiagnosticsScreen(bool fullRedraw);
+    void updateDiagnosticsScreen();
+
+    // Draw the link-quality table (per channel, or per sender if bySender)
+    void draw_LinkStatsScreen(bool bySender);
+
+    // Draw the discovery list (unknown channels with activity counts)
+    void draw_DiscoverScreen();
+
+    // Draw the search screen: query box, and the hit list unless only the
+    // query changed
+    void draw_SearchScreen(const String& query, byte regions);
+
     // Draw the edit user info screen
     // fullRedraw: redraw everything, _text_draft: current text input
     void draw_EditUserInfoScreen(bool fullRedraw, String _text_draft);
@@ -44,10 +62,48 @@ public:
     // Draw chat screen for a specific channel
     // _channel_id: channel to display, _text_draft: current typing buffer
     // mode: CHAT_FULL, CHAT_MESSAGES, or CHAT_DRAFT
-    void draw_ChatScreen(String _channel_id, String& _text_draft, byte mode);
+    void draw_ChatScreen(const IdString& _channel_id, String& _text_draft, byte mode);
+
+    // ================== REDRAW SCHEDULING ==================
+    // Regions marked dirty by input and radio handlers; render() repaints them
+    static const byte DIRTY_SCREEN = 0x01;  // whole screen (after a transition)
+    static const byte DIRTY_BODY   = 0x02;  // list / messages / values
+    static const byte DIRTY_DRAFT  = 0x04;  // text entry line
+    static const byte DIRTY_SCROLL = 0x08;  // chat scroll offset moved
+
+    // Frame budget: body/screen repaints at most ~30 Hz; the draft line has
+    // priority and may be repainted between frames so typing stays responsive
+    static const unsigned long FRAME_INTERVAL_MS = 33;
+    static const unsigned long DRAFT_INTERVAL_MS = 10;
+
+    // Mark regions of the current screen for repaint
+    void invalidate(byte regions);
+
+    // Panel content is unknown (something drew over it): repaint from scratch
+    void repaintAll();
+
+    // Repaint whatever is dirty and due on the current screen (call in loop).
+    // Invalidations arriving between frames coalesce into one repaint.
+    void render();
+
+    // True while invalidated regions wait for render()
+    bool renderPending() const { return dirty != 0; }
+
+    // Invalidations requested vs. frames actually drawn
+    unsigned long framesRequested() const { return frames_requested; }
+    unsigned long framesRendered() const { return frames_rendered; }
+
+    // Channel shown on the chat screen
+    Channel* chatChannel;
+
+    // Link stats view: per sender (true) or per channel (false)
+    bool linkStatsBySender;
+
+    // Highlighted row of the search hit list
+    byte searchSelection;
 
-    // General screen update (partial refresh)
-    void drawUpdate();
+    // The last SEND could not be queued; the draft bar offers a retry
+    bool sendFailed;
 
     // ================== CHAT DRAWING ==================
     // Draw all messages in a channel
@@ -56,9 +112,27 @@ public:
     // Draw the current draft message at the bottom
     void drawChatDraft(const String& draft);
     
-    // Calculate total height of all messages in a channel (accounts for variable heights)
+    // Calculate total height of all messages in a channel (accounts for wrapped bodies)
     int calculateTotalMessagesHeight(Channel* channel);
 
+    // Chat body text geometry (font 2, or the flash smooth font when it fits
+    // the line height; wrapped to the panel width)
+    static const byte CHAT_FONT = 2;
+    static const int CHAT_LINE_HEIGHT = 20;
+    static const int CHAT_TEXT_WIDTH = 310;
+    static const int CHAT_VIEW_TOP = 40;
+    static const int CHAT_VIEW_BOTTOM = 200;
+
+    // Start paging history in once the view is this close to a window edge
+    static const int CHAT_PREFETCH_PX = 3 * CHAT_LINE_HEIGHT;
+
+    // Drop cached chat geometry after message heights changed (e.g. latency reports)
+    void invalidateChatLayout();
+
+    // History window changed at the front (see HistoryStore::FrontHook); keeps
+    // the visible messages in place by moving the scroll offset with them
+    void historyFrontChanged(Channel* channel, int count);
+
     // ================== SCROLLING ==================
     // Scroll chat messages up
     void scrollChatUp();
@@ -66,9 +140,16 @@ public:
     // Scroll chat messages down for a channel
     void scrollChatDown(Channel* channel);
 
+    // Move the chat view by dy pixels (clamped, pages history in); returns
+    // pixels moved, 0 at either end
+    int scrollChatBy(Channel* channel, int dy);
+
     // Scroll to the bottom of the channel
     void scrollToBottom(Channel* channel);
 
+    // Scroll so a resident message (window index) is at the top of the view
+    void scrollToMessage(Channel* channel, size_t index);
+
     
     // ================== MESSAGE FORMATTER ==================
     // Create formatted outgoing message string
@@ -91,12 +172,60 @@ public:
     TFT_eSPI tft;
 
 private:
+    // Show a static screen layout, repainting only what differs from the current one
+    void showLayout(const UIScreen& layout);
+
+    // Lay out one message; returns its height and the sender prefix it uses
+    int layoutChatMessage(Message* msg, String& prefix, bool& isOwnMessage);
+
+    // Paint the chat rows intersecting [bandTop, bandBottom) (screen y)
+    void drawChatBand(Channel* channel, int bandTop, int bandBottom);
+
+    // Apply the pending scroll offset (repaints the view if it moved)
+    void scrollChatView(Channel* channel);
+
+    // First message whose bottom is below the scroll offset; y = its content y.
+    // Walks from the previous anchor, so cost follows scroll distance, not history size
+    size_t seekChatAnchor(Channel* channel, int& y);
+
+    // Total laid-out height of a channel (cached per channel/message count)
+    int chatContentHeight(Channel* channel);
+
     // TFT object from TFT_eSPI library
     
 
     // Current active screen
     byte current_screen;
     
+    // Virtualized channel rows on the Messages screen
+    VirtualList channelList;
+
+    // Layout currently on the panel (nullptr = unknown)
+    const UIScreen* shownLayout;
+
+    // Pending DIRTY_* regions
+    byte dirty;
+
+    // Chat viewport: offset currently on the panel, scroll anchor and height
+    // cache (keyed by pool handle, so a recycled channel slot can't hit)
+    int shownChatOffset;
+    PoolHandle anchorChannel;
+    size_t anchorIndex;
+    int anchorY;
+    PoolHandle heightChannel;
+    unsigned int heightCount;
+    int heightCache;
+
+    // Frame governor state (millis) and counters
+    unsigned long lastFrame;
+    unsigned long lastDraftFrame;
+    unsigned long frameCost;
+    unsigned long frames_requested;
+    unsigned long frames_rendered;
+
     // Last time the header time was updated (millis)
     unsigned long lastTimeUpdate;
+
+    // Last time the diagnostics values were refreshed (millis)
+    unsigned long lastDiagnosticsUpdate;
 };
@@ -0,0 +1,93 @@
+#include "TelemetryHandler.h"
+#include "../PreferencesHandler.h"
+#include "../SerialTxHandler/SerialTxHandler.h"
+
+bool TelemetryHandler::enabled = false;
+bool TelemetryHandler::record_mode = false;
+unsigned long TelemetryHandler::interval = TelemetryHandler::DEFAULT_INTERVAL;
+unsigned long TelemetryHandler::window_start = 0;
+uint16_t TelemetryHandler::counts[TEL_EVENT_TYPES] = {0};
+TelemetryHandler::Record TelemetryHandler::records[TelemetryHandler::MAX_RECORDS];
+size_t TelemetryHandler::record_count = 0;
+
+// ================== CONFIGURATION ==================
+void TelemetryHandler::begin() {
+    interval = (unsigned long) PreferencesHandler::getInt("telem_ms", DEFAULT_INTERVAL);
+    record_mode = PreferencesHandler::getBool("telem_rec", false);
+    enabled = interval > 0;
+    window_start = millis();
+}
+
+void TelemetryHandler::setInterval(unsigned long interval_ms) {
+    interval = interval_ms;
+    enabled = interval > 0;
+    PreferencesHandler::setInt("telem_ms", (int) interval_ms);
+}
+
+void TelemetryHandler::setRecordMode(bool on) {
+    record_mode = on;
+    PreferencesHandler::setBool("telem_rec", on);
+}
+
+// ================== COLLECTION ==================
+void TelemetryHandler::record(byte type, const IdString& channel_id) {
+    if (!enabled || type >= TEL_EVENT_TYPES) return;
+    if (counts[type] < 0xFFFF) counts[type]++;
+
+    if (!record_mode || record_count >= MAX_RECORDS) return;
+
+    // One-byte channel tag: the ID's cached FNV-1a folded to 8 bits
+    uint32_t h = channel_id.hash();
+
+    unsigned long dt = millis() - window_start;
+    Record& r = records[record_count++];
+    r.dt_ms = dt > 0xFFFF ? 0xFFFF : (uint16_t) dt;
+    r.type = type;
+    r.channel_tag = (uint8_t) (h ^ (h >> 8) ^ (h >> 16) ^ (h >> 24));
+}
+
+// ================== FLUSH ==================
+void TelemetryHandler::update() {
+    if (!enabled) return;
+    unsigned long now = millis();
+    if (now - window_start < interval) return;
+    flush(now);
+}
+
+void TelemetryHandler::flush(unsigned long now) {
+    bool any = false;
+    for (byte t = 0; t < TEL_EVENT_TYPES; ++t) any |= counts[t] > 0;
+
+    // Quiet windows produce no traffic
+    if (any) {
+        char line[64];
+        int len = snprintf(line, sizeof(line), "TEL||%lu||%u||%u||%u||%u",
+                           now - window_start,
+                           counts[TEL_ACCEPTED], counts[TEL_DUPLICATE],
+                           counts[TEL_UNKNOWN_CHANNEL], counts[TEL_PARSE_ERROR]);
+        SerialTxHandler::enqueueLine(line, len);
+    }
+
+    if (record_mode && record_count > 0) {
+        static const char hex[] = "0123456789ABCDEF";
+        char line[6 + MAX_RECORDS * sizeof(Record) * 2];
+        size_t len = 0;
+        memcpy(line, "TELR||", 6);
+        len = 6;
+        for (size_t i = 0; i < record_count; ++i) {
+            const uint8_t bytes[4] = {
+                (uint8_t) (records[i].dt_ms & 0xFF), (uint8_t) (records[i].dt_ms >> 8),
+                records[i].type, records[i].channel_tag
+            };
+            for (uint8_t b : bytes) {
+                line[len++] = hex[b >> 4];
+                line[len++] = hex[b & 0x0F];
+            }
+        }
+        SerialTxHandler::enqueueLine(line, len);
+    }
+
+    memset(counts, 0, sizeof(counts));
+    record_count = 0;
+    window_start = now;
+}
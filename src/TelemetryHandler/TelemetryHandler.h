@@ -0,0 +1,71 @@
+#pragma once
+#ifndef TELEMETRY_HANDLER_H
+#define TELEMETRY_HANDLER_H
+
+#include <Arduino.h>
+#include "../FixedString/FixedString.h"
+
+// Uncomment to compile telemetry out entirely (events become no-ops)
+// #define DISABLE_TELEMETRY
+
+// ================== INGEST EVENT TYPES ==================
+const byte TEL_ACCEPTED        = 0;  // Message stored in a channel
+const byte TEL_DUPLICATE       = 1;  // Message ID already present
+const byte TEL_UNKNOWN_CHANNEL = 2;  // Channel not joined
+const byte TEL_PARSE_ERROR     = 3;  // Line did not parse as a packet
+const byte TEL_EVENT_TYPES     = 4;
+
+// ================== TelemetryHandler ===================
+// Collects ingest events in a fixed buffer and flushes them to the LoRa MCU
+// in batches, replacing the per-packet "DATA||" echo.
+//
+// Every interval one summary line is queued:
+//   TEL||<window_ms>||<accepted>||<duplicate>||<unknown>||<parse_error>
+// With record mode on, the raw events follow as one hex line of 4-byte
+// records (dt_ms lo, dt_ms hi, type, channel tag):
+//   TELR||<hex>
+class TelemetryHandler {
+public:
+    static constexpr size_t MAX_RECORDS = 32;       // Events kept per window
+    static constexpr unsigned long DEFAULT_INTERVAL = 10000;
+
+    // Load interval / record mode from preferences (interval 0 = disabled)
+    static void begin();
+
+    // Change flush interval at runtime and persist it
+    static void setInterval(unsigned long interval_ms);
+    static void setRecordMode(bool enabled);
+
+    // Record one ingest event (O(1), no allocation)
+    static void record(byte type, const IdString& channel_id);
+
+    // Flush the window when the interval elapsed (call in loop)
+    static void update();
+
+private:
+    struct Record {
+        uint16_t dt_ms;   // Milliseconds since window start (saturating)
+        uint8_t type;
+        uint8_t channel_tag;
+    };
+
+    static bool enabled;
+    static bool record_mode;
+    static unsigned long interval;
+    static unsigned long window_start;
+    static uint16_t counts[TEL_EVENT_TYPES];
+    static Record records[MAX_RECORDS];
+    static size_t record_count;
+
+    static void flush(unsigned long now);
+};
+
+#ifdef DISABLE_TELEMETRY
+  #define TELEMETRY_EVENT(type, channel_id)
+  #define TELEMETRY_UPDATE()
+#else
+  #define TELEMETRY_EVENT(type, channel_id) TelemetryHandler::record(type, channel_id)
+  #define TELEMETRY_UPDATE()                TelemetryHandler::update()
+#endif
+
+#endif // TELEMETRY_HANDLER_H
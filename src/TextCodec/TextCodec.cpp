@@ -0,0 +1,169 @@
+#include "TextCodec.h"
+#include "../SerialTxHandler/SerialTxHandler.h"
+#include "../global_objects.h"
+
+bool TextCodec::link_packed = false;
+uint32_t TextCodec::plain_bytes = 0;
+uint32_t TextCodec::packed_bytes = 0;
+char TextCodec::scratch[TextCodec::VIEW_SIZE];
+
+// ================== CODEBOOK ==================
+// Code 0x80 + i expands to CODEBOOK[i]. The table is part of the wire and
+// flash format; changing it needs a new capability version.
+static const char* const CODEBOOK[127] = {
+    " the", "the", " a", "e ", "s ", "th", " t", "in", "he", "er", "an", "re", "on", " s",
+    "t ", "d ", "at", "en", "nd", "ou", " o", " i", " w", "or", "es", "is", "it", "ing",
+    "ng", "ha", "to", " to", "ed", " c", "te", "ar", "st", " b", " f", " m", " h", "y ",
+    "of", " of", "hi", "as", "le", "ve", " and", "and", "se", "me", "al", "ll", "o ", "ne",
+    " p", "you", " you", "ro", "ea", " in", " is", "ri", "ti", "co", "ra", "de", "li", "ce",
+    "ch", "om", "ma", "ut", "ur", "ho", "ow", " d", " l", " n", " g", " r", " e", "n ",
+    "r ", "l ", "a ", "k ", "g ", ", ", ". ", "? ", "! ", "ok", " ok", "lo", "ee", "oo",
+    "we", "wh", "be", "no", "so", "go", "do", "up", "un", "us", "ck", "ss", "ly", "ge",
+    "ke", "el", "ht", "gh", "ion", "tion", " for", " that", "that", " what", " are", " on", " it",
+    " be", " we",
+};
+static const byte CODES = sizeof(CODEBOOK) / sizeof(CODEBOOK[0]);
+static const uint8_t ESCAPE = 0xFF;
+static const byte NO_CODE = 0xFF;
+
+// Codes chained by first character, so matching only tries plausible entries
+static byte first_code[128];
+static byte next_code[CODES];
+static byte code_len[CODES];
+
+static void buildTables() {
+    static bool built = false;
+    if (built) return;
+    memset(first_code, NO_CODE, sizeof(first_code));
+    for (int i = CODES - 1; i >= 0; --i) {
+        uint8_t c = CODEBOOK[i][0];
+        code_len[i] = strlen(CODEBOOK[i]);
+        next_code[i] = first_code[c];
+        first_code[c] = i;
+    }
+    built = true;
+}
+
+// ================== CODEC ==================
+size_t TextCodec::compress(const char* in, size_t len, char* out, size_t cap) {
+    buildTables();
+    size_t o = 0;
+    size_t i = 0;
+    while (i < len && o < cap) {
+        uint8_t c = in[i];
+        if (c >= 0x80) {
+            if (o + 2 > cap) break;
+            out[o++] = (char) ESCAPE;
+            out[o++] = c;
+            i++;
+            continue;
+        }
+
+        // Longest codebook fragment starting here
+        byte best = NO_CODE;
+        byte bestLen = 1;
+        for (byte k = first_code[c]; k != NO_CODE; k = next_code[k]) {
+            byte n = code_len[k];
+            if (n > bestLen && i + n <= len && memcmp(in + i, CODEBOOK[k], n) == 0) {
+                best = k;
+                bestLen = n;
+            }
+        }
+        out[o++] = best != NO_CODE ? (char) (0x80 + best) : (char) c;
+        i += bestLen;
+    }
+    return o;
+}
+
+size_t TextCodec::expand(const char* in, size_t len, char* out, size_t cap) {
+    size_t o = 0;
+    for (size_t i = 0; i < len && o < cap; ++i) {
+        uint8_t c = in[i];
+        if (c < 0x80) {
+            out[o++] = c;
+        } else if (c == ESCAPE) {
+            if (++i >= len) break;  // Truncated escape
+            out[o++] = in[i];
+        } else {
+            const char* frag = CODEBOOK[c - 0x80];
+            size_t n = min(strlen(frag), cap - o);
+            memcpy(out + o, frag, n);
+            o += n;
+        }
+    }
+    return o;
+}
+
+String TextCodec::pack(const String& text) {
+    if (isPacked(text.c_str(), text.length())) return text;
+
+    char buf[VIEW_SIZE];
+    buf[0] = MARKER;
+    size_t n = compress(text.c_str(), text.length(), buf + 1, sizeof(buf) - 2);
+    plain_bytes += text.length();
+
+    // Keep it plain unless it shrinks (and fit whole)
+    if (n + 1 >= text.length() || text.length() >= sizeof(buf) - 2) {
+        packed_bytes += text.length();
+        return text;
+    }
+    buf[n + 1] = 0;
+    packed_bytes += n + 1;
+    return String(buf);
+}
+
+const char* TextCodec::view(const char* stored, size_t len, size_t& outLen) {
+    if (!isPacked(stored, len)) {
+        outLen = len;
+        return stored;
+    }
+    outLen = expand(stored + 1, len - 1, scratch, sizeof(scratch) - 1);
+    scratch[outLen] = 0;
+    return scratch;
+}
+
+String TextCodec::forWire(const Channel* channel, const String& stored) {
+    if (!isPacked(stored.c_str(), stored.length()) || channelSupports(channel)) return stored;
+    size_t n;
+    return String(view(stored, n));
+}
+
+// ================== CAPABILITY ==================
+void TextCodec::begin() {
+    SerialTxHandler::enqueuePacket("CAP||Z1");
+}
+
+// CAP||<token>             the LoRa MCU's answer for the link
+// CAP||<token>||<sender>   a peer's advertisement relayed by the LoRa MCU
+bool TextCodec::onCapability(const String& line) {
+    if (!line.startsWith("CAP||")) return false;
+    int end = line.indexOf("||", 5);
+    String token = line.substring(5, end < 0 ? line.length() : end);
+    bool z1 = token == "Z1";
+
+    if (end < 0) {
+        link_packed = z1;
+    } else if (z1) {
+        User* u = findUserById(IdString(line.c_str() + end + 2));
+        if (u) u->packs = true;
+    }
+    return true;
+}
+
+void TextCodec::onReceived(User* sender, const String& body) {
+    if (sender && isPacked(body.c_str(), body.length())) sender->packs = true;
+}
+
+// Senders that have not spoken recently are unknown either way; the window
+// is the best list of who is listening that the controller has
+bool TextCodec::channelSupports(const Channel* channel) {
+    if (!link_packed || !channel) return false;
+    bool peers = false;
+    for (const Message* m : channel->channel_messages) {
+        if (!m || (local_user && m->sender_id == local_user->ID)) continue;
+        User* u = findUserById(m->sender_id);
+        if (!u || !u->packs) return false;
+        peers = true;
+    }
+    return peers;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef TEXT_CODEC_H
+#define TEXT_CODEC_H
+
+#include <Arduino.h>
+
+struct User;
+struct Channel;
+
+// ================== TextCodec ===================
+// SMAZ-style short-text compression for message bodies. Bytes 0x80-0xFE
+// stand for one of 127 fragments common in English chat ("the", " you",
+// "ing", ", " ...), 0xFF escapes one literal byte >= 0x80 (UTF-8), and
+// ASCII passes through, so packed text never gains '\n', '|' or NUL bytes
+// the original didn't have. Typical chat lines shrink to 50-60 %.
+//
+// A packed body starts with MARKER (ASCII SUB), so stored and received
+// bodies describe themselves; text that wouldn't shrink stays plain.
+// Messages keep the packed form in RAM and on flash and are expanded only
+// when a row is laid out, drawn or searched (view()).
+//
+// Packed bodies travel over the air to peers that may run older firmware,
+// so the wire form is decided per channel. A peer counts as able to read
+// them once it sent us a packed body, or once the LoRa MCU relays its
+// advertisement as `CAP||Z1||<sender ID>`. A channel gets packed bodies
+// only if the link itself answered our `CAP||Z1` and every other sender in
+// its resident window is such a peer; until then bodies go out as plain
+// text. Packed bodies from peers are always accepted.
+class TextCodec {
+public:
+    static const char MARKER = 0x1A;
+    static constexpr size_t VIEW_SIZE = 512;  // Expanded body limit
+
+    // Announce the capability to the LoRa MCU
+    static void begin();
+    // Handle a `CAP||...` line; returns false for any other line
+    static bool onCapability(const String& line);
+    static bool linkSupports() { return link_packed; }
+
+    // A body arrived from a peer; a packed one shows the peer reads them
+    static void onReceived(User* sender, const String& body);
+
+    // Stored form of a body: packed if that is shorter, else unchanged
+    static String pack(const String& text);
+    // Body as it goes into an outgoing packet on a channel
+    static String forWire(const Channel* channel, const String& stored);
+    static bool channelSupports(const Channel* channel);
+
+    // Plain text of a stored body. Packed bodies are expanded into a shared
+    // buffer that stays valid until the next call.
+    static const char* view(const char* stored, size_t len, size_t& outLen);
+    static const char* view(const String& stored, size_t& outLen) {
+        return view(stored.c_str(), stored.length(), outLen);
+    }
+
+    static bool isPacked(const char* s, size_t len) { return len > 0 && s[0] == MARKER; }
+
+    static size_t compress(const char* in, size_t len, char* out, size_t cap);
+    static size_t expand(const char* in, size_t len, char* out, size_t cap);
+
+    // Bytes in / out over all pack() calls
+    static uint32_t plainBytes() { return plain_bytes; }
+    static uint32_t packedBytes() { return packed_bytes; }
+
+private:
+    static bool link_packed;
+    static uint32_t plain_bytes;
+    static uint32_t packed_bytes;
+    static char scratch[VIEW_SIZE];
+};
+
+#endif // TEXT_CODEC_H
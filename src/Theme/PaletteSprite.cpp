@@ -0,0 +1,108 @@
+#include "PaletteSprite.h"
+
+uint16_t PaletteSprite::lines[2][CHUNK_PIXELS];
+
+bool PaletteSprite::create(int16_t w, int16_t h) {
+    if (created()) deleteSprite();
+    setColorDepth(4);
+    return createSprite(w, h) != nullptr;
+}
+
+// ================== PUSH ==================
+void PaletteSprite::push(int16_t x, int16_t y) {
+    if (!created()) return;
+
+    const uint16_t* pal = Theme::busPalette();
+    const uint8_t* src = (const uint8_t*) getPointer();
+    int16_t w = width();
+    int16_t h = height();
+    size_t stride = (_iwidth + 1) >> 1;         // Two pixels per byte, high nibble first
+    int16_t rows = max(1, (int) (CHUNK_PIXELS / w));
+
+    bool swap;
+    beginStream(*_tft, x, y, w, h, swap);
+
+    byte buf = 0;
+    for (int16_t row = 0; row < h; row += rows) {
+        int16_t n = min(rows, (int16_t) (h - row));
+        uint16_t* out = lines[buf];
+
+        // Expanding into this buffer overlaps the DMA of the other one
+        for (int16_t r = 0; r < n; ++r) {
+            const uint8_t* in = src + (row + r) * stride;
+            for (int16_t i = 0; i < w; i += 2) {
+                uint8_t pair = *in++;
+                *out++ = pal[pair >> 4];
+                if (i + 1 < w) *out++ = pal[pair & 0x0F];
+            }
+        }
+
+        sendChunk(*_tft, buf, n * w);
+        buf ^= 1;
+    }
+    endStream(*_tft, swap);
+}
+
+void PaletteSprite::pushRuns(TFT_eSPI& tft, const PaletteImage& image, int16_t x, int16_t y) {
+    int16_t w = image.width;
+    int16_t h = image.height;
+    if (w <= 0 || h <= 0 || w > CHUNK_PIXELS) return;
+
+    const uint16_t* pal = Theme::busPalette();
+    const uint8_t* in = image.runs;
+    const uint8_t* last = image.runs + image.size;
+    uint16_t color = 0;
+    uint16_t run = 0;                           // Pixels left in the current run
+    int16_t rows = CHUNK_PIXELS / w;
+
+    bool swap;
+    beginStream(tft, x, y, w, h, swap);
+
+    byte buf = 0;
+    for (int16_t row = 0; row < h; row += rows) {
+        uint32_t count = (uint32_t) min(rows, (int16_t) (h - row)) * w;
+        uint16_t* out = lines[buf];
+
+        for (uint32_t i = 0; i < count; ) {
+            if (run == 0) {
+                if (in >= last) {               // Truncated image: pad with background
+                    color = pal[PAL_BACKGROUND];
+                    run = count - i;
+                } else {
+                    uint8_t b = *in++;
+                    color = pal[b >> 4];
+                    run = b & 0x0F;
+                    if (run == 0) run = (in < last ? *in++ : 0) + 16;
+                }
+            }
+            uint32_t n = min((uint32_t) run, count - i);
+            for (uint32_t k = 0; k < n; ++k) out[i + k] = color;
+            i += n;
+            run -= n;
+        }
+
+        sendChunk(tft, buf, count);
+        buf ^= 1;
+    }
+    endStream(tft, swap);
+}
+
+// ================== BUS ==================
+void PaletteSprite::beginStream(TFT_eSPI& tft, int16_t x, int16_t y, int16_t w, int16_t h, bool& swap) {
+    // Line buffers are already in bus order
+    swap = tft.getSwapBytes();
+    tft.setSwapBytes(false);
+    tft.startWrite();
+    tft.setAddrWindow(x, y, w, h);
+}
+
+void PaletteSprite::sendChunk(TFT_eSPI& tft, byte buf, uint32_t pixels) {
+    if (tft.DMA_Enabled) tft.pushPixelsDMA(lines[buf], pixels);  // Waits for the previous chunk
+    else                 tft.pushPixels(lines[buf], pixels);
+}
+
+void PaletteSprite::endStream(TFT_eSPI& tft, bool swap) {
+    if (tft.DMA_Enabled) tft.dmaWait();
+    tft.endWrite();
+    tft.setSwapBytes(swap);
+}
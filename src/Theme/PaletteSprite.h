@@ -0,0 +1,53 @@
+#pragma once
+#ifndef PALETTE_SPRITE_H
+#define PALETTE_SPRITE_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "Theme.h"
+
+// ----- PaletteImage -----
+// Pre-rendered role image in flash (tools/gen_assets.py): run-length coded
+// palette roles, rows concatenated. Each byte is role << 4 | n: a run of n
+// (1..15) pixels, or with n = 0 a run of (next byte + 16) pixels.
+struct PaletteImage {
+    uint16_t width, height;
+    const uint8_t* runs;
+    uint32_t size;
+};
+
+// ================== PaletteSprite ===================
+// 4-bit sprite whose pixel values are palette roles (PAL_*): draw into it
+// with roles instead of RGB565 colours. A 320x30 row costs 4.8 KB instead of
+// 19.2 KB at 16 bits.
+//
+// push() expands rows through the active theme's bus palette into two small
+// line buffers and streams them over DMA, expanding the next chunk while the
+// previous one is on the wire. The palette is read at push time, so a theme
+// change needs no sprite rebuild. Without DMA it falls back to blocking
+// pushes. The sprite must lie fully on screen. pushRuns() streams flash
+// images the same way, decoding whole rows into each chunk.
+class PaletteSprite : public TFT_eSprite {
+public:
+    static const uint16_t CHUNK_PIXELS = 1280;   // Per line buffer (4 rows of 320)
+
+    explicit PaletteSprite(TFT_eSPI* tft) : TFT_eSprite(tft) {}
+
+    // Allocate a w x h 4-bit sprite; false if out of memory
+    bool create(int16_t w, int16_t h);
+
+    // Expand to RGB565 and send to the panel at (x, y)
+    void push(int16_t x, int16_t y);
+
+    // Decode a PaletteImage row by row through the same line buffers
+    static void pushRuns(TFT_eSPI& tft, const PaletteImage& image, int16_t x, int16_t y);
+
+private:
+    static uint16_t lines[2][CHUNK_PIXELS];
+
+    static void beginStream(TFT_eSPI& tft, int16_t x, int16_t y, int16_t w, int16_t h, bool& swap);
+    static void sendChunk(TFT_eSPI& tft, byte buf, uint32_t pixels);
+    static void endStream(TFT_eSPI& tft, bool swap);
+};
+
+#endif // PALETTE_SPRITE_H
@@ -0,0 +1,48 @@
+#include "Theme.h"
+#include <TFT_eSPI.h>
+#include "../PreferencesHandler.h"
+
+byte Theme::current = 0;
+uint16_t Theme::active[16];
+uint16_t Theme::bus[16];
+
+// ================== THEMES ==================
+// One row per role, in PAL_* order
+static const uint16_t PALETTES[Theme::COUNT][PAL_ROLES] = {
+    // Classic (the original colours)
+    { TFT_BLACK, TFT_WHITE, TFT_LIGHTGREY, TFT_BLUE, TFT_WHITE, TFT_DARKGREY, TFT_WHITE,
+      TFT_CYAN, TFT_BLACK, TFT_GREEN, TFT_YELLOW, TFT_RED, TFT_ORANGE, TFT_WHITE, TFT_BLACK },
+    // Night: dim reds only, keeps dark adaptation
+    { 0x0000, 0xC9A6, 0x7000, 0x3000, 0xFB2C, 0x2000, 0xC9A6,
+      0xA000, 0x0000, 0xB2A0, 0xC9A6, 0xF800, 0x9000, 0x5000, 0xFB2C },
+    // Daylight: dark on light, readable in sun
+    { 0xFFFF, 0x0000, 0x52AA, 0x0010, 0xFFFF, 0x9CF3, 0x0000,
+      0x03EF, 0xFFFF, 0x0400, 0xB300, 0xC000, 0xFC00, 0xFFFF, 0x0000 },
+    // High contrast: black / white / yellow
+    { 0x0000, 0xFFFF, 0xFFE0, 0xFFE0, 0x0000, 0xFFFF, 0x0000,
+      0xFFE0, 0x0000, 0x07E0, 0xFFE0, 0xF800, 0xFFE0, 0xFFFF, 0x0000 },
+};
+
+static const char* const NAMES[Theme::COUNT] = { "Classic", "Night", "Daylight", "Contrast" };
+
+// ================== SELECTION ==================
+void Theme::begin() {
+    int saved = PreferencesHandler::getInt("theme", 0);
+    select(saved >= 0 && saved < COUNT ? saved : 0);
+}
+
+void Theme::select(byte index) {
+    if (index >= COUNT) return;
+    bool changed = index != current;
+    current = index;
+
+    for (byte i = 0; i < 16; ++i) {
+        active[i] = i < PAL_ROLES ? PALETTES[index][i] : 0;
+        bus[i] = (active[i] << 8) | (active[i] >> 8);
+    }
+    if (changed) PreferencesHandler::setInt("theme", index);
+}
+
+const char* Theme::name(byte index) {
+    return index < COUNT ? NAMES[index] : "?";
+}
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef THEME_H
+#define THEME_H
+
+#include <Arduino.h>
+
+// ================== PALETTE ROLES ==================
+// Drawing code names colours by role; the active theme maps each role to
+// RGB565. Roles double as 4-bit sprite pixel values (see PaletteSprite).
+const byte PAL_BACKGROUND = 0;   // Screen background
+const byte PAL_TEXT       = 1;   // Text on the background
+const byte PAL_MUTED      = 2;   // Secondary text, column headings
+const byte PAL_BAR        = 3;   // Title / status bars, index buttons
+const byte PAL_BAR_TEXT   = 4;
+const byte PAL_PANEL      = 5;   // Buttons, rows, footers, input boxes
+const byte PAL_PANEL_TEXT = 6;
+const byte PAL_ACCENT     = 7;   // Menu buttons, highlighted values
+const byte PAL_INK        = 8;   // Dark text on bright fills (accent, keycaps)
+const byte PAL_GOOD       = 9;
+const byte PAL_WARN       = 10;
+const byte PAL_BAD        = 11;
+const byte PAL_HIGHLIGHT  = 12;  // Logo, calibration targets
+const byte PAL_FIELD      = 13;  // Text entry field (draft line)
+const byte PAL_FIELD_TEXT = 14;
+const byte PAL_ROLES      = 15;  // Entry 15 of the 4-bit palette is unused
+
+// ================== Theme ===================
+// A theme is one 16-entry RGB565 palette. Switching themes swaps the active
+// palette and repaints once; no drawing code changes.
+class Theme {
+public:
+    static const byte COUNT = 4;
+
+    // Load the saved theme
+    static void begin();
+
+    static uint16_t color(byte role) { return active[role & 0x0F]; }
+
+    // Active palette, native RGB565 and byte-swapped for the SPI bus
+    static const uint16_t* palette() { return active; }
+    static const uint16_t* busPalette() { return bus; }
+
+    // Switch to (and persist) another theme; caller repaints
+    static void select(byte index);
+    static void next() { select((current + 1) % COUNT); }
+
+    static byte index() { return current; }
+    static const char* name(byte index);
+
+private:
+    static byte current;
+    static uint16_t active[16];
+    static uint16_t bus[16];
+};
+
+#endif // THEME_H
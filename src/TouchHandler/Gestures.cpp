@@ -0,0 +1,97 @@
+#include "Gestures.h"
+#include <math.h>
+#include <stdlib.h>
+
+// ================== GestureRecognizer ==================
+void GestureRecognizer::reset() {
+    down = false;
+    moved = false;
+    history_head = 0;
+    history_count = 0;
+}
+
+Gesture GestureRecognizer::feed(const TouchSample& s) {
+    Gesture g = {GESTURE_NONE, s.x, s.y, 0, 0, 0, 0};
+
+    if (!s.down) {
+        if (!down) return g;
+        down = false;
+        g.x = last.x;
+        g.y = last.y;
+
+        if (moved) {
+            velocity(g.vx, g.vy);
+            bool fast = fabsf(g.vx) >= FLING_MIN || fabsf(g.vy) >= FLING_MIN;
+            g.type = fast ? GESTURE_FLING : GESTURE_RELEASE;
+        } else if (s.t_ms - start.t_ms <= TAP_MAX_MS) {
+            g.type = GESTURE_TAP;
+            g.x = start.x;
+            g.y = start.y;
+        }
+        return g;
+    }
+
+    if (!down) {
+        down = true;
+        moved = false;
+        start = last = s;
+        history_head = 0;
+        history_count = 0;
+    }
+
+    history[history_head] = s;
+    history_head = (history_head + 1) % HISTORY;
+    if (history_count < HISTORY) history_count++;
+
+    if (!moved) {
+        if (abs(s.x - start.x) <= TAP_SLOP && abs(s.y - start.y) <= TAP_SLOP) return g;
+        moved = true;
+        last = start;  // First drag covers the slop too
+    }
+
+    g.dx = s.x - last.x;
+    g.dy = s.y - last.y;
+    last = s;
+    if (g.dx || g.dy) g.type = GESTURE_DRAG;
+    return g;
+}
+
+void GestureRecognizer::velocity(float& vx, float& vy) const {
+    vx = vy = 0;
+    if (history_count < 2) return;
+
+    // Newest sample and the oldest one still inside the window
+    const TouchSample& newest = history[(history_head + HISTORY - 1) % HISTORY];
+    const TouchSample* oldest = &newest;
+    for (uint8_t i = 2; i <= history_count; ++i) {
+        const TouchSample& h = history[(history_head + HISTORY - i) % HISTORY];
+        if (newest.t_ms - h.t_ms > VELOCITY_WINDOW_MS) break;
+        oldest = &h;
+    }
+
+    uint32_t dt = newest.t_ms - oldest->t_ms;
+    if (dt == 0) return;
+    vx = (newest.x - oldest->x) * 1000.0f / dt;
+    vy = (newest.y - oldest->y) * 1000.0f / dt;
+}
+
+// ================== KineticScroller ==================
+void KineticScroller::start(float velocity) {
+    speed = fmaxf(-MAX_SPEED, fminf(velocity, MAX_SPEED));
+    carry = 0;
+    if (fabsf(speed) < STOP_SPEED) speed = 0;
+}
+
+int KineticScroller::step(uint32_t dt_ms) {
+    if (speed == 0) return 0;
+
+    // Exact distance under exponential decay over dt
+    float decay = expf(-(float) dt_ms / TAU_MS);
+    float distance = speed * TAU_MS / 1000.0f * (1.0f - decay) + carry;
+    speed *= decay;
+    if (fabsf(speed) < STOP_SPEED) speed = 0;
+
+    int px = (int) distance;
+    carry = speed != 0 ? distance - px : 0;
+    return px;
+}
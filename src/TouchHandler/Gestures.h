@@ -0,0 +1,96 @@
+#pragma once
+#ifndef GESTURES_H
+#define GESTURES_H
+
+#include <stdint.h>
+
+// Plain C++ (no Arduino/TFT dependencies): recorded sample traces can be fed
+// through GestureRecognizer and KineticScroller on the host.
+
+// ----- TouchSample -----
+// One filtered, calibrated reading; down == false marks the release
+struct TouchSample {
+    int16_t x;
+    int16_t y;
+    bool down;
+    uint32_t t_ms;
+};
+
+// ================== GESTURE TYPES ==================
+const uint8_t GESTURE_NONE    = 0;
+const uint8_t GESTURE_TAP     = 1;  // Short press that stayed within TAP_SLOP
+const uint8_t GESTURE_DRAG    = 2;  // Finger moved: dx/dy since the previous event
+const uint8_t GESTURE_FLING   = 3;  // Drag released while moving: vx/vy in px/s
+const uint8_t GESTURE_RELEASE = 4;  // Drag released at rest
+
+struct Gesture {
+    uint8_t type;
+    int16_t x;        // Current (TAP: press) position
+    int16_t y;
+    int16_t dx;       // DRAG only
+    int16_t dy;
+    float vx;         // FLING only
+    float vy;
+};
+
+// ================== GestureRecognizer ===================
+// Turns a stream of samples into tap / drag / fling events. A press becomes
+// a drag once it leaves TAP_SLOP; the first drag event carries the whole
+// distance from the press point, so nothing is lost to the slop. Release
+// velocity is the slope over the last VELOCITY_WINDOW_MS of samples, so a
+// finger that stops before lifting does not fling.
+class GestureRecognizer {
+public:
+    static constexpr int16_t TAP_SLOP = 10;              // px
+    static constexpr uint32_t TAP_MAX_MS = 350;
+    static constexpr float FLING_MIN = 200.0f;           // px/s
+    static constexpr uint32_t VELOCITY_WINDOW_MS = 80;
+    static constexpr uint8_t HISTORY = 8;
+
+    GestureRecognizer() { reset(); }
+
+    void reset();
+
+    // Feed the next sample; returns GESTURE_NONE when nothing happened
+    Gesture feed(const TouchSample& s);
+
+    bool pressed() const { return down; }
+    bool dragging() const { return moved; }
+
+private:
+    bool down;
+    bool moved;
+    TouchSample start;
+    TouchSample last;
+    TouchSample history[HISTORY];   // Ring of recent down samples
+    uint8_t history_head;
+    uint8_t history_count;
+
+    void velocity(float& vx, float& vy) const;
+};
+
+// ================== KineticScroller ===================
+// Carries a fling on after release: velocity decays exponentially with time
+// constant TAU_MS, so the distance travelled is v * TAU. step() returns whole
+// pixels and keeps the fraction for the next frame.
+class KineticScroller {
+public:
+    static constexpr float TAU_MS = 325.0f;
+    static constexpr float STOP_SPEED = 20.0f;          // px/s
+    static constexpr float MAX_SPEED = 4000.0f;         // px/s
+
+    KineticScroller() : speed(0), carry(0) {}
+
+    void start(float velocity);
+    void stop() { speed = 0; carry = 0; }
+    bool active() const { return speed != 0; }
+
+    // Pixels to scroll for a frame of dt_ms
+    int step(uint32_t dt_ms);
+
+private:
+    float speed;   // px/s, signed
+    float carry;   // Sub-pixel remainder
+};
+
+#endif // GESTURES_H
@@ -0,0 +1,234 @@
+#include "TouchHandler.h"
+#include "../TFTHandler/TFTHandler.h"
+#include "../KeypadHandler/KeypadHandler.h"
+#include "../PowerManager/PowerManager.h"
+#include "../PreferencesHandler.h"
+#include "../Theme/Theme.h"
+#include "../DebugMacros.h"
+#include <algorithm>
+
+TFTHandler* TouchHandler::tft = nullptr;
+GestureRecognizer TouchHandler::recognizer;
+KineticScroller TouchHandler::kinetic;
+volatile bool TouchHandler::pen_irq = false;
+bool TouchHandler::tracking = false;
+bool TouchHandler::swallow = false;
+byte TouchHandler::misses = 0;
+int16_t TouchHandler::last_x = 0;
+int16_t TouchHandler::last_y = 0;
+unsigned long TouchHandler::last_sample = 0;
+unsigned long TouchHandler::last_step = 0;
+unsigned long TouchHandler::sample_count = 0;
+unsigned long TouchHandler::gesture_count = 0;
+
+// Taps act like these keys (see KeypadHandler::transitions)
+const TouchHandler::TapZone TouchHandler::tap_zones[] = {
+    // screen            x    y    w    h    key
+    { SCREEN_START,      40, 160, 240,  30, '1' },
+    { SCREEN_START,      40, 200, 240,  30, '2' },
+
+    { SCREEN_SETTINGS,   40,  50, 240,  30, '1' },
+    { SCREEN_SETTINGS,   40,  90, 240,  30, '2' },
+    { SCREEN_SETTINGS,   40, 130, 240,  30, '3' },
+    { SCREEN_SETTINGS,   40, 170, 240,  30, '4' },
+
+    // Channel rows (channelList slots)
+    { SCREEN_MESSAGES,    0,  35, 320,  30, '1' },
+    { SCREEN_MESSAGES,    0,  65, 320,  30, '2' },
+    { SCREEN_MESSAGES,    0,  95, 320,  30, '3' },
+    { SCREEN_MESSAGES,    0, 125, 320,  30, '4' },
+    { SCREEN_MESSAGES,    0, 155, 320,  30, '5' },
+
+    // Discovered channel rows
+    { SCREEN_DISCOVER,    0,  48, 320,  20, '1' },
+    { SCREEN_DISCOVER,    0,  68, 320,  20, '2' },
+    { SCREEN_DISCOVER,    0,  88, 320,  20, '3' },
+    { SCREEN_DISCOVER,    0, 108, 320,  20, '4' },
+    { SCREEN_DISCOVER,    0, 128, 320,  20, '5' },
+    { SCREEN_DISCOVER,    0, 148, 320,  20, '6' },
+    { SCREEN_DISCOVER,    0, 168, 320,  20, '7' },
+    { SCREEN_DISCOVER,    0, 188, 320,  20, '8' },
+};
+
+#ifdef TOUCH_CS
+
+// TFT_eSPI calibration: raw x min/max, raw y min/max, orientation flags
+static uint16_t calibration[5] = {275, 3620, 264, 3532, 1};
+
+static uint16_t median3(uint16_t a, uint16_t b, uint16_t c) {
+    if (a > b) std::swap(a, b);
+    if (b > c) std::swap(b, c);
+    return max(a, b);
+}
+
+// ================== SETUP ==================
+void TouchHandler::begin(TFTHandler* _tft) {
+    tft = _tft;
+    if (!PreferencesHandler::getBytes("touch_cal", calibration, sizeof(calibration))) {
+        INFO("Touch not calibrated, using defaults");
+    }
+    tft->tft.setTouch(calibration);
+
+#ifdef TOUCH_IRQ
+    pinMode(TOUCH_IRQ, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(TOUCH_IRQ), onPenIrq, FALLING);
+#endif
+}
+
+void TouchHandler::calibrate() {
+    if (!tft) return;
+    kinetic.stop();
+    recognizer.reset();
+
+    TFT_eSPI& t = tft->tft;
+    t.fillScreen(Theme::color(PAL_BACKGROUND));
+    t.setTextColor(Theme::color(PAL_TEXT), Theme::color(PAL_BACKGROUND));
+    t.setTextDatum(MC_DATUM);
+    t.drawString("Touch the arrow in each corner", 160, 120, 2);
+    t.calibrateTouch(calibration, Theme::color(PAL_HIGHLIGHT), Theme::color(PAL_BACKGROUND), 15);
+    t.setTouch(calibration);
+    PreferencesHandler::setBytes("touch_cal", calibration, sizeof(calibration));
+
+    // The routine drew over everything
+    tft->repaintAll();
+    pen_irq = false;
+    tracking = false;
+}
+
+void IRAM_ATTR TouchHandler::onPenIrq() {
+    pen_irq = true;
+}
+
+// ================== SAMPLING ==================
+// Filtered, calibrated point; false if the pen is up (or lifting)
+bool TouchHandler::readPoint(int16_t& x, int16_t& y) {
+    TFT_eSPI& t = tft->tft;
+    if (t.getTouchRawZ() < Z_THRESHOLD) return false;
+
+    uint16_t rx[3], ry[3];
+    for (byte i = 0; i < 3; ++i) t.getTouchRaw(&rx[i], &ry[i]);
+
+    // Coordinates taken while the pen lifts are garbage
+    if (t.getTouchRawZ() < Z_THRESHOLD) return false;
+
+    uint16_t px = median3(rx[0], rx[1], rx[2]);
+    uint16_t py = median3(ry[0], ry[1], ry[2]);
+    t.convertRawXY(&px, &py);
+    x = constrain((int16_t) px, 0, (int16_t) (t.width() - 1));
+    y = constrain((int16_t) py, 0, (int16_t) (t.height() - 1));
+    return true;
+}
+
+void TouchHandler::update() {
+    if (!tft) return;
+    unsigned long now = millis();
+
+    // Kinetic scrolling runs at the frame rate, independent of sampling
+    if (kinetic.active() && now - last_step >= TFTHandler::FRAME_INTERVAL_MS) {
+        int dy = kinetic.step(now - last_step);
+        last_step = now;
+        if (dy && scrollBy(dy) == 0) kinetic.stop();  // Hit an end
+    }
+
+    if (!tracking) {
+#ifdef TOUCH_IRQ
+        if (!pen_irq) return;
+        pen_irq = false;
+        // Our own conversions pulse PENIRQ; only a held pen keeps it low
+        if (digitalRead(TOUCH_IRQ) == HIGH) return;
+#else
+        if (now - last_sample < IDLE_POLL_MS) return;
+#endif
+    } else if (now - last_sample < SAMPLE_INTERVAL_MS) {
+        return;
+    }
+
+    // The bus belongs to the panel until its transfer is done
+    if (tft->tft.dmaBusy()) return;
+    sample(now);
+}
+
+void TouchHandler::sample(unsigned long now) {
+    last_sample = now;
+    sample_count++;
+
+    int16_t x, y;
+    if (readPoint(x, y)) {
+        misses = 0;
+        if (!tracking) {
+            tracking = true;
+            kinetic.stop();
+            // A touch on a dark panel only wakes it
+            swallow = !PowerManager::activity();
+        } else {
+            PowerManager::activity();
+            x = (x + last_x) / 2;
+            y = (y + last_y) / 2;
+        }
+        last_x = x;
+        last_y = y;
+    } else {
+        if (!tracking) return;  // Spurious PENIRQ
+        if (++misses < RELEASE_SAMPLES) return;
+        tracking = false;
+        misses = 0;
+    }
+
+    TouchSample s = {last_x, last_y, tracking, (uint32_t) now};
+    Gesture g = recognizer.feed(s);
+    if (g.type == GESTURE_NONE || swallow) return;
+    gesture_count++;
+    apply(g);
+}
+
+// ================== GESTURES ==================
+void TouchHandler::apply(const Gesture& g) {
+    switch (g.type) {
+        case GESTURE_TAP:
+            tap(g.x, g.y);
+            break;
+        case GESTURE_DRAG:
+            // Content follows the finger
+            scrollBy(-g.dy);
+            break;
+        case GESTURE_FLING:
+            kinetic.start(-g.vy);
+            last_step = millis();
+            break;
+    }
+}
+
+void TouchHandler::tap(int16_t x, int16_t y) {
+    byte screen = tft->get_currentScreen();
+    for (const TapZone& z : tap_zones) {
+        if (z.screen != screen) continue;
+        if (x < z.x || x >= z.x + z.w || y < z.y || y >= z.y + z.h) continue;
+        KeypadHandler::injectKey(z.key);
+        return;
+    }
+}
+
+int TouchHandler::scrollBy(int dy) {
+    switch (tft->get_currentScreen()) {
+        case SCREEN_CHAT: {
+            int moved = tft->scrollChatBy(tft->chatChannel, dy);
+            if (moved) tft->invalidate(TFTHandler::DIRTY_SCROLL);
+            return moved;
+        }
+        case SCREEN_MESSAGES: {
+            int moved = tft->scrollMessagesBy(dy);
+            if (moved) tft->invalidate(TFTHandler::DIRTY_BODY);
+            return moved;
+        }
+    }
+    kinetic.stop();
+    return 0;
+}
+
+#else  // No touch controller configured
+
+void TouchHandler::begin(TFTHandler* _tft) { tft = _tft; }
+void TouchHandler::update() {}
+void TouchHandler::calibrate() {}
+
+#endif // TOUCH_CS
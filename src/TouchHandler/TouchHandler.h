@@ -0,0 +1,84 @@
+#pragma once
+#ifndef TOUCH_HANDLER_H
+#define TOUCH_HANDLER_H
+
+#include <Arduino.h>
+#include "Gestures.h"
+
+class TFTHandler;
+
+// ================== TouchHandler ===================
+// XPT2046 resistive touch on the TFT's SPI bus (TOUCH_CS, optional
+// TOUCH_IRQ). Without TOUCH_CS the whole module compiles to no-ops.
+//
+// Sampling: nothing touches the bus while the pen is up. PENIRQ falling sets
+// a flag; only then (or while a touch is being tracked) update() reads the
+// controller, at most every SAMPLE_INTERVAL_MS. Reads happen from loop()
+// between frames, and are deferred while a DMA transfer owns the bus, so a
+// touch never interrupts a frame half-drawn. TFT_eSPI switches chip select
+// and clock for each read. Without TOUCH_IRQ the pen is polled every
+// IDLE_POLL_MS instead.
+//
+// Filtering: a reading counts only above Z_THRESHOLD pressure, before and
+// after the coordinates are read; each coordinate is the median of three
+// conversions, mapped through the calibration and then averaged with the
+// previous point. A release needs RELEASE_SAMPLES misses in a row, since
+// resistive panels drop out briefly during a drag.
+//
+// Gestures: drags scroll the chat and channel list directly, flings keep
+// scrolling with decaying speed (stepped once per frame interval), taps hit
+// the tap zones of the current screen and act like the key they stand for.
+class TouchHandler {
+public:
+    static constexpr unsigned long SAMPLE_INTERVAL_MS = 10;  // 100 Hz while pressed
+    static constexpr unsigned long IDLE_POLL_MS = 50;        // No TOUCH_IRQ only
+    static constexpr uint16_t Z_THRESHOLD = 350;
+    static constexpr byte RELEASE_SAMPLES = 3;
+
+    // Load the calibration and arm PENIRQ; after TFTHandler::begin()
+    static void begin(TFTHandler* tft);
+
+    // Sample, recognize and apply gestures; step kinetic scrolling (call in loop)
+    static void update();
+
+    // Interactive four-corner calibration (blocks until done); persisted
+    static void calibrate();
+
+    // Readings taken / gestures recognized since boot
+    static unsigned long samples() { return sample_count; }
+    static unsigned long gestures() { return gesture_count; }
+
+private:
+    // Rectangle that acts as a key on one screen
+    struct TapZone {
+        byte screen;
+        int16_t x, y, w, h;
+        char key;
+    };
+    static const TapZone tap_zones[];
+
+    static TFTHandler* tft;
+    static GestureRecognizer recognizer;
+    static KineticScroller kinetic;
+    static volatile bool pen_irq;
+    static bool tracking;           // Pen down (or releasing) as far as we know
+    static bool swallow;            // Touch only woke the display
+    static byte misses;
+    static int16_t last_x;
+    static int16_t last_y;
+    static unsigned long last_sample;
+    static unsigned long last_step;
+    static unsigned long sample_count;
+    static unsigned long gesture_count;
+
+    static void IRAM_ATTR onPenIrq();
+    static bool readPoint(int16_t& x, int16_t& y);
+    static void sample(unsigned long now);
+    static void apply(const Gesture& g);
+    static void tap(int16_t x, int16_t y);
+
+    // Scroll whatever the current screen scrolls; returns pixels moved
+    static int scrollBy(int dy);
+};
+
+#endif // TOUCH_HANDLER_H
@@ -0,0 +1,160 @@
+#include "UIWidgets.h"
+
+// ================== WidgetRenderer ==================
+void WidgetRenderer::paint(TFT_eSPI& tft, const Widget& w) {
+    uint16_t color = Theme::color(w.color);
+    switch (w.type) {
+        case W_RECT:
+        case W_REGION:
+            tft.fillRect(w.x, w.y, w.w, w.h, color);
+            break;
+        case W_ROUND_RECT:
+            tft.fillRoundRect(w.x, w.y, w.w, w.h, w.r, color);
+            break;
+        case W_FRAME:
+            tft.drawRoundRect(w.x, w.y, w.w, w.h, w.r, color);
+            break;
+        case W_LABEL:
+            tft.setTextColor(color, Theme::color(w.bg));
+            tft.setTextDatum(w.datum);
+            tft.drawString(w.text, w.x, w.y, w.font);
+            break;
+        case W_TEXT:
+            tft.setTextColor(color);
+            tft.setTextDatum(w.datum);
+            tft.drawString(w.text, w.x, w.y, w.font);
+            break;
+        case W_CIRCLE:
+            tft.fillCircle(w.x, w.y, w.r, color);
+            break;
+        case W_ARROW:
+            tft.fillTriangle(w.x, w.y, w.x + w.w, w.y - w.h, w.x + w.w, w.y + w.h, color);
+            break;
+        case W_IMAGE:
+            PaletteSprite::pushRuns(tft, *w.image, w.x, w.y);
+            break;
+    }
+}
+
+UIRect WidgetRenderer::bounds(TFT_eSPI& tft, const Widget& w) {
+    switch (w.type) {
+        case W_CIRCLE:
+            return UIRect{ (int16_t) (w.x - w.r), (int16_t) (w.y - w.r),
+                           (int16_t) (2 * w.r + 1), (int16_t) (2 * w.r + 1) };
+        case W_ARROW:
+            return UIRect{ w.x, (int16_t) (w.y - w.h), (int16_t) (w.w + 1), (int16_t) (2 * w.h + 1) };
+        case W_LABEL:
+        case W_TEXT: {
+            int16_t tw = tft.textWidth(w.text, w.font);
+            int16_t th = tft.fontHeight(w.font);
+            // Datum: 0..8 = rows T/M/B x columns L/C/R
+            int16_t x = w.x - (w.datum % 3) * tw / 2;
+            int16_t y = w.y - (w.datum / 3) * th / 2;
+            return UIRect{ x, y, tw, th };
+        }
+        default:
+            return UIRect{ w.x, w.y, w.w, w.h };
+    }
+}
+
+bool WidgetRenderer::same(const Widget& a, const Widget& b) {
+    if (a.type != b.type || a.x != b.x || a.y != b.y || a.w != b.w || a.h != b.h ||
+        a.r != b.r || a.color != b.color || a.bg != b.bg || a.font != b.font || a.datum != b.datum ||
+        a.image != b.image) {
+        return false;
+    }
+    if (a.text == b.text) return true;
+    if (!a.text || !b.text) return false;
+    return strcmp(a.text, b.text) == 0;
+}
+
+byte WidgetRenderer::show(TFT_eSPI& tft, const UIScreen* from, const UIScreen& to) {
+    byte painted = 0;
+
+    // Unknown panel content or a different background: start from scratch
+    if (!from || from->background != to.background) {
+        tft.fillScreen(Theme::color(to.background));
+        for (byte i = 0; i < to.count; ++i) {
+            paint(tft, to.widgets[i]);
+            painted++;
+        }
+        return painted;
+    }
+
+    UIRect damage[MAX_DAMAGE];
+    byte damaged = 0;
+    bool overflow = false;
+
+    // Widgets that disappear leave damage behind: clear it to the background.
+    // A region that stays is refilled below, so it needs no clear of its own.
+    for (byte i = 0; i < from->count; ++i) {
+        const Widget& old = from->widgets[i];
+        bool kept = false;
+        for (byte j = 0; j < to.count && !kept; ++j) kept = same(old, to.widgets[j]);
+        if (kept) continue;
+
+        UIRect r = bounds(tft, old);
+        tft.fillRect(r.x, r.y, r.w, r.h, Theme::color(to.background));
+        if (damaged < MAX_DAMAGE) damage[damaged++] = r;
+        else overflow = true;
+    }
+
+    // Paint new or changed widgets, and unchanged ones touching any damage
+    for (byte i = 0; i < to.count; ++i) {
+        const Widget& w = to.widgets[i];
+        UIRect r = bounds(tft, w);
+
+        bool repaint = overflow || w.type == W_REGION;
+        if (!repaint) {
+            bool existed = false;
+            for (byte j = 0; j < from->count && !existed; ++j) existed = same(w, from->widgets[j]);
+            repaint = !existed;
+        }
+        for (byte d = 0; d < damaged && !repaint; ++d) repaint = r.intersects(damage[d]);
+        if (!repaint) continue;
+
+        paint(tft, w);
+        painted++;
+        // Widgets painted later and overlapping this one must follow it
+        if (damaged < MAX_DAMAGE) damage[damaged++] = r;
+        else overflow = true;
+    }
+    return painted;
+}
+
+// ================== VirtualList ==================
+VirtualList::VirtualList(int16_t x, int16_t y, int16_t w, int16_t rowHeight, byte slots,
+                         byte background, const ListSource& source)
+    : x(x), y(y), w(w), rowHeight(rowHeight),
+      slots(slots > MAX_SLOTS ? MAX_SLOTS : slots),
+      background(background), source(source) {
+    invalidate();
+}
+
+void VirtualList::invalidate() {
+    for (byte i = 0; i < MAX_SLOTS; ++i) drawn[i] = Slot{ false, nullptr, 0 };
+}
+
+byte VirtualList::draw(TFT_eSPI& tft, size_t first) {
+    byte repainted = 0;
+    void* item = source.itemAt(first);
+
+    for (byte i = 0; i < slots; ++i) {
+        uint32_t version = item ? source.version(item) : 0;
+        Slot& slot = drawn[i];
+
+        if (!slot.valid || slot.item != item || slot.version != version) {
+            int16_t rowY = y + i * rowHeight;
+            if (item) {
+                source.drawRow(tft, item, i, x, rowY, w, rowHeight);
+            } else if (!slot.valid || slot.item) {
+                tft.fillRect(x, rowY, w, rowHeight, Theme::color(background));
+            }
+            slot = Slot{ true, item, version };
+            repainted++;
+        }
+
+        if (item) item = source.next(item);
+    }
+    return repainted;
+}
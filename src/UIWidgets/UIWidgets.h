@@ -0,0 +1,141 @@
+#pragma once
+#ifndef UI_WIDGETS_H
+#define UI_WIDGETS_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "../Theme/PaletteSprite.h"
+
+// ================== WIDGET TYPES ==================
+const byte W_RECT       = 0;  // Filled rectangle
+const byte W_ROUND_RECT = 1;  // Filled rounded rectangle (r = corner radius)
+const byte W_FRAME      = 2;  // Rounded rectangle outline
+const byte W_LABEL      = 3;  // Text with opaque background (bg)
+const byte W_TEXT       = 4;  // Text drawn transparently
+const byte W_CIRCLE     = 5;  // Filled circle at (x, y), radius r
+const byte W_ARROW      = 6;  // Filled triangle (x, y), (x + w, y - h), (x + w, y + h)
+const byte W_REGION     = 7;  // Dynamic content area: cleared to 'color' on every entry
+const byte W_IMAGE      = 8;  // Pre-rendered PaletteImage at (x, y)
+
+// ----- Widget -----
+// One retained drawing element. Screens are constexpr arrays of these,
+// painted in order (later widgets sit on top of earlier ones).
+struct Widget {
+    byte type;
+    int16_t x, y, w, h;
+    int16_t r;          // Corner / circle radius
+    byte color;         // Fill or text colour (palette role)
+    byte bg;            // Text background (W_LABEL, palette role)
+    byte font;
+    byte datum;
+    const char* text;
+    const PaletteImage* image;  // W_IMAGE
+};
+
+// ----- Widget constructors (usable in constexpr tables) -----
+constexpr Widget uiRect(int16_t x, int16_t y, int16_t w, int16_t h, byte color) {
+    return Widget{ W_RECT, x, y, w, h, 0, color, 0, 0, 0, nullptr, nullptr };
+}
+constexpr Widget uiRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, byte color) {
+    return Widget{ W_ROUND_RECT, x, y, w, h, r, color, 0, 0, 0, nullptr, nullptr };
+}
+constexpr Widget uiFrame(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, byte color) {
+    return Widget{ W_FRAME, x, y, w, h, r, color, 0, 0, 0, nullptr, nullptr };
+}
+constexpr Widget uiLabel(int16_t x, int16_t y, const char* text, byte font, byte datum,
+                         byte fg, byte bg) {
+    return Widget{ W_LABEL, x, y, 0, 0, 0, fg, bg, font, datum, text, nullptr };
+}
+constexpr Widget uiText(int16_t x, int16_t y, const char* text, byte font, byte datum, byte fg) {
+    return Widget{ W_TEXT, x, y, 0, 0, 0, fg, 0, font, datum, text, nullptr };
+}
+constexpr Widget uiCircle(int16_t x, int16_t y, int16_t r, byte color) {
+    return Widget{ W_CIRCLE, x, y, 0, 0, r, color, 0, 0, 0, nullptr, nullptr };
+}
+constexpr Widget uiArrow(int16_t x, int16_t y, int16_t w, int16_t h, byte color) {
+    return Widget{ W_ARROW, x, y, w, h, 0, color, 0, 0, 0, nullptr, nullptr };
+}
+constexpr Widget uiImage(int16_t x, int16_t y, const PaletteImage& image) {
+    return Widget{ W_IMAGE, x, y, (int16_t) image.width, (int16_t) image.height, 0, 0, 0, 0, 0, nullptr, &image };
+}
+constexpr Widget uiRegion(int16_t x, int16_t y, int16_t w, int16_t h, byte color) {
+    return Widget{ W_REGION, x, y, w, h, 0, color, 0, 0, 0, nullptr, nullptr };
+}
+
+// ----- UIScreen -----
+// Static part of a screen: background role plus widget table
+struct UIScreen {
+    const Widget* widgets;
+    byte count;
+    byte background;
+};
+
+#define UI_SCREEN(table, background) UIScreen{ table, (byte) (sizeof(table) / sizeof(Widget)), background }
+
+// ----- UIRect -----
+struct UIRect {
+    int16_t x, y, w, h;
+    bool intersects(const UIRect& o) const {
+        return x < o.x + o.w && o.x < x + w && y < o.y + o.h && o.y < y + h;
+    }
+};
+
+// ================== WidgetRenderer ===================
+// Paints screens from widget tables with damage tracking: switching from one
+// screen to another repaints only widgets that differ, plus anything on top
+// of a repainted or removed area.
+class WidgetRenderer {
+public:
+    static const byte MAX_DAMAGE = 48;
+
+    // Show 'to'; 'from' is what the panel currently holds (nullptr = unknown,
+    // which repaints everything). Returns the number of widgets painted.
+    static byte show(TFT_eSPI& tft, const UIScreen* from, const UIScreen& to);
+
+    // Paint a single widget
+    static void paint(TFT_eSPI& tft, const Widget& w);
+
+    // Screen-space bounding box of a widget
+    static UIRect bounds(TFT_eSPI& tft, const Widget& w);
+
+    static bool same(const Widget& a, const Widget& b);
+};
+
+// ================== VirtualList ===================
+// Fixed-height row list that only paints visible rows, and of those only the
+// rows whose item or version changed since the previous draw.
+struct ListSource {
+    void* (*itemAt)(size_t index);         // nullptr past the end
+    void* (*next)(void* item);             // Following item, nullptr at the end
+    uint32_t (*version)(void* item);       // Changes whenever the row must repaint
+    void (*drawRow)(TFT_eSPI& tft, void* item, byte slot, int16_t x, int16_t y, int16_t w, int16_t h);
+};
+
+class VirtualList {
+public:
+    static const byte MAX_SLOTS = 8;
+
+    VirtualList(int16_t x, int16_t y, int16_t w, int16_t rowHeight, byte slots,
+                byte background, const ListSource& source);
+
+    // Forget what the slots show (after the area was cleared)
+    void invalidate();
+
+    // Paint rows starting at item 'first'; returns rows repainted
+    byte draw(TFT_eSPI& tft, size_t first);
+
+private:
+    struct Slot {
+        bool valid;
+        void* item;
+        uint32_t version;
+    };
+
+    int16_t x, y, w, rowHeight;
+    byte slots;
+    byte background;        // Palette role
+    ListSource source;
+    Slot drawn[MAX_SLOTS];
+};
+
+#endif // UI_WIDGETS_H
@@ -1,21 +1,75 @@
 #include "global_objects.h"
 #include "DebugMacros.h"
+#include "Subscriptions/Subscriptions.h"
+#include <algorithm>
 
 // ===== RTC object =====
 RTC_DS3231 rtc;
 
 // ===== Actual storage definitions =====
 bool EDIT_MODE = false;
-byte screen_current = SCREEN_START;
 String text_draft = "";
 
+ObjectPool<User, POOL_USERS> user_pool;
+ObjectPool<Channel, POOL_CHANNELS> channel_pool;
+ObjectPool<Message, POOL_MESSAGES> message_pool;
+
 std::vector<User*> all_users;
 std::vector<Channel*> all_channels;
 std::vector<Message*> all_messages;
 User* local_user = nullptr;
+Channel* channels_by_activity = nullptr;
+static Channel* channels_activity_tail = nullptr;
+
+// ===== Object lifetime =====
+User* createUser(const IdString& id, const NameString& uname) {
+    User* u = user_pool.create(id, uname);
+    if (!u) WARN("User pool exhausted");
+    return u;
+}
+
+Channel* createChannel(byte type, const NameString& name, const IdString& id) {
+    Channel* ch = channel_pool.create(type, name, id);
+    if (!ch) WARN("Channel pool exhausted");
+    return ch;
+}
+
+Message* createMessage(const IdString& ch_id, const IdString& msg_id, const IdString& sender,
+                       const String& msg, const String& ts,
+                       int rssi, int snr, unsigned long latency) {
+    return message_pool.create(ch_id, msg_id, sender, msg, ts, rssi, snr, latency);
+}
+
+void destroyUser(User* user) {
+    if (user == local_user) local_user = nullptr;
+    user_pool.destroy(user);
+}
+
+void destroyMessage(Message* msg) {
+    if (!msg) return;
+    auto it = std::find(all_messages.begin(), all_messages.end(), msg);
+    if (it != all_messages.end()) all_messages.erase(it);
+    message_pool.destroy(msg);
+}
+
+void clearUsers() {
+    for (auto* u : all_users) destroyUser(u);
+    all_users.clear();
+}
+
+void clearChannels() {
+    for (auto* c : all_channels) {
+        if (!c) continue;
+        for (auto* m : c->channel_messages) message_pool.destroy(m);
+        channel_pool.destroy(c);
+    }
+    all_channels.clear();
+    all_messages.clear();
+    channels_by_activity = channels_activity_tail = nullptr;
+}
 
 // ===== Helper functions =====
-User* findUserById(const String& id) {
+User* findUserById(const IdString& id) {
     for (auto* u : all_users) {
         if (!u) continue;
         if (u->ID == id) return u;
@@ -23,7 +77,7 @@ User* findUserById(const String& id) {
     return nullptr;
 }
 
-Channel* findChannelById(const String& id) {
+Channel* findChannelById(const IdString& id) {
     for (auto* c : all_channels) {
         if (!c) continue;
         if (c->ID == id) return c;
@@ -31,15 +85,68 @@ Channel* findChannelById(const String& id) {
     return nullptr;
 }
 
-Message* findMessageById(const String& id) {
+Message* findMessageById(const IdString& id) {
+    return findMessageByKey(MessageId::keyOf(id));
+}
+
+Message* findMessageByKey(uint64_t key) {
     for (auto* m : all_messages) {
         if (!m) continue;
-        if (m->message_id == id) return m;
+        if (m->key == key) return m;
     }
     return nullptr;
 }
 
-bool updateMessageLatency(const String& messageId, int rssi, int snr, unsigned long latency) {
+// ===== Channel activity list =====
+static void unlinkChannelActivity(Channel* ch) {
+    if (ch->activity_prev) ch->activity_prev->activity_next = ch->activity_next;
+    else if (channels_by_activity == ch) channels_by_activity = ch->activity_next;
+    if (ch->activity_next) ch->activity_next->activity_prev = ch->activity_prev;
+    else if (channels_activity_tail == ch) channels_activity_tail = ch->activity_prev;
+    ch->activity_prev = ch->activity_next = nullptr;
+}
+
+static void appendChannelActivity(Channel* ch) {
+    ch->activity_prev = channels_activity_tail;
+    ch->activity_next = nullptr;
+    if (channels_activity_tail) channels_activity_tail->activity_next = ch;
+    else channels_by_activity = ch;
+    channels_activity_tail = ch;
+}
+
+void registerChannel(Channel* ch) {
+    if (!ch) return;
+    all_channels.push_back(ch);
+    appendChannelActivity(ch);
+    Subscriptions::add(ch->ID);
+}
+
+void rebuildChannelActivity() {
+    channels_by_activity = channels_activity_tail = nullptr;
+    for (auto* c : all_channels) {
+        if (c) appendChannelActivity(c);
+    }
+    Subscriptions::rebuild();
+}
+
+void touchChannelActivity(Channel* ch) {
+    if (!ch) return;
+    ch->last_activity = millis();
+    if (channels_by_activity == ch) return;
+    unlinkChannelActivity(ch);
+    ch->activity_next = channels_by_activity;
+    if (channels_by_activity) channels_by_activity->activity_prev = ch;
+    else channels_activity_tail = ch;
+    channels_by_activity = ch;
+}
+
+Channel* channelAtActivityIndex(size_t index) {
+    Channel* ch = channels_by_activity;
+    while (ch && index--) ch = ch->activity_next;
+    return ch;
+}
+
+bool updateMessageLatency(const IdString& messageId, int rssi, int snr, unsigned long latency) {
     Message* msg = findMessageById(messageId);
     if (!msg) return false;
     
@@ -54,23 +161,18 @@ bool updateMessageLatency(const String& messageId, int rssi, int snr, unsigned l
 }
 
 // ===== Unique message ID generator =====
-String generateMessageId() {
-    // Compact unique ID using millis() in HEX and a small random hex tail
-    char buf[16];
-    // millis() -> hex
-    sprintf(buf, "%lX", millis());
-    String head = String(buf);
-    // random tail (4 hex digits)
-    int tail = random(0, 0x10000); // 0 .. 0xFFFF
-    char tailBuf[8];
-    sprintf(tailBuf, "%X", tail);
-    String tailStr = String(tailBuf);
-    return head + "_" + tailStr;
+IdString generateMessageId() {
+    // node | epoch | counter, as 13 base32 characters
+    char buf[MessageId::TEXT_LEN + 1];
+    MessageId::format(MessageId::next(), buf);
+    IdString id;
+    id.assign(buf, MessageId::TEXT_LEN);
+    return id;
 }
 
 // ===== RTC Functions =====
 String getTime(){
-    DateTime now = rtc.now();
+    DateTime now = rtc.now() + TimeSpan((int32_t) UTC_OFFSET_MIN * 60);
     char buf[20];
     sprintf(buf, "%02d/%02d/%02d %02d:%02d",
             now.month(), now.day(), now.year(),
@@ -80,20 +182,24 @@ String getTime(){
 
 void RTC_setup() {
     if (! rtc.begin()) {
-        Serial.println("Couldn't find RTC");
-        Serial.flush();
-        while (1) delay(10);
+        ERR("Couldn't find RTC");
+        while (1) {
+            SerialTxHandler::pump();
+            delay(10);
+        }
     }
     // If you want to set the RTC to the date & time this sketch was compiled, uncomment this line
     // rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
 
     if (rtc.lostPower()) {
-        Serial.println("RTC lost power, let's set the time!");
+        WARN("RTC lost power, let's set the time!");
         // When time needs to be set on a new device, or after a power loss, the
-        // following line sets the RTC to the date & time this sketch was compiled
-        rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
+        // following line sets the RTC to the date & time this sketch was compiled.
+        // __DATE__/__TIME__ are the build machine's local time; the RTC keeps UTC.
+        rtc.adjust(DateTime(F(__DATE__), F(__TIME__)) - TimeSpan((int32_t) UTC_OFFSET_MIN * 60));
         // This line sets the RTC with an explicit date & time, for example to set
         // January 21, 2014 at 3am you would call:
         //rtc.adjust(DateTime(2014, 1, 21, 3, 0, 0));
     }
+    MessageId::begin(rtc.now().unixtime());
 }
@@ -6,6 +6,9 @@
 #include <vector>
 #include "DebugMacros.h"
 #include "RTClib.h"
+#include "ObjectPool/ObjectPool.h"
+#include "FixedString/FixedString.h"
+#include "MessageId/MessageId.h"
 
 
 // ================== SCREEN CONSTANTS =====================
@@ -16,6 +19,10 @@ const byte SCREEN_SETTINGS  = 2;  // Settings menu
 const byte SCREEN_EDIT_USER = 3;  // User info edit screen
 const byte SCREEN_CHAT      = 4;  // Chat screen
 const byte SCREEN_CREATE    = 5;
+const byte SCREEN_DIAGNOSTICS = 6;  // Performance counters
+const byte SCREEN_LINK_STATS  = 7;  // Link-quality table
+const byte SCREEN_DISCOVER    = 8;  // Unknown channels seen on the mesh
+const byte SCREEN_SEARCH      = 9;  // Full-text search over channel histories
 
 // ================== CHAT TYPES ===========================
 // Define types of chats
@@ -24,7 +31,6 @@ const byte CHAT_PRIVATE = 0;  // Private chat
 
 // ================== TFT STATE & GLOBAL VARIABLES =========
 extern bool EDIT_MODE;       // True if editing text
-extern byte screen_current;  // Current active screen
 extern String text_draft;    // Draft text for typing / editing
 
 // ================== STRUCT DEFINITIONS ===================
@@ -32,23 +38,25 @@ extern String text_draft;    // Draft text for typing / editing
 // ----- User -----
 // Represents a user in the system
 struct User {
-    String ID;        // Unique user ID
-    String username;  // Display name
-    String status;    // Optional status text
+    IdString ID;          // Unique user ID
+    NameString username;  // Display name
+    String status;        // Optional status text
+    bool packs;           // Known to read packed bodies (see TextCodec); not saved
 
     // Default constructor
-    User() : ID(""), username(""), status("") {}
+    User() : status(""), packs(false) {}
 
     // Parameterized constructor
-    User(const String& id, const String& uname, const String& stat = "")
-        : ID(id), username(uname), status(stat) {}
+    User(const IdString& id, const NameString& uname, const String& stat = "")
+        : ID(id), username(uname), status(stat), packs(false) {}
 };
 // ----- Message -----
 // Represents a chat message with minimal fields
 struct Message {
-    String channel_id;
-    String message_id;
-    String sender_id;
+    IdString channel_id;
+    IdString message_id;
+    uint64_t key;       // Integer form of message_id (see MessageId::keyOf)
+    IdString sender_id;
     String message;
     String time_stamp;
     int rssi;           // Received Signal Strength Indicator (dBm)
@@ -56,15 +64,22 @@ struct Message {
     unsigned long latency;  // Message latency (milliseconds)
     bool latency_set;   // Flag to track if latency has been set
 
+    // Cached word-wrap layout (see ChatLayout); valid for font/width/indent
+    std::vector<uint16_t> line_breaks;  // Byte offsets of lines after the first
+    byte layout_font;                   // 0 = not laid out yet
+    uint16_t layout_width;
+    uint16_t layout_indent;
+
     // Default constructor
     Message()
-        : channel_id(""), message_id(""), sender_id(""), message(""), time_stamp(""), 
-          rssi(0), snr(0), latency(0), latency_set(false) {}
+        : key(0), message(""), time_stamp(""),
+          rssi(0), snr(0), latency(0), latency_set(false),
+          layout_font(0), layout_width(0), layout_indent(0) {}
 
     // Parameterized constructor (auto-assigns timestamp if not provided)
-    Message(const String& ch_id,
-            const String& msg_id,
-            const String& sender,
+    Message(const IdString& ch_id,
+            const IdString& msg_id,
+            const IdString& sender,
             const String& msg,
             const String& ts = "",
             int r = 0,
@@ -72,31 +87,55 @@ struct Message {
             unsigned long lat = 0)
         : channel_id(ch_id),
           message_id(msg_id),
+          key(MessageId::keyOf(msg_id)),
           sender_id(sender),
           message(msg),
           time_stamp(ts.length() ? ts : String(millis(), HEX)),
           rssi(r),
           snr(s),
           latency(lat),
-          latency_set(lat > 0) {}
+          latency_set(lat > 0),
+          layout_font(0), layout_width(0), layout_indent(0) {}
 };
 
 // ----- Channel -----
 // Represents a chat channel (group or private)
+const uint16_t STORED_KEYS = 512;  // Key hashes per channel for dedup (HistoryStore::MAX_RECORDS)
+
 struct Channel {
     byte channel_type;                  // CHAT_GROUP or CHAT_PRIVATE
-    String name;                        // Channel name
-    String ID;                          // Unique channel ID
-    std::vector<Message*> channel_messages; // Messages in this channel
-    unsigned int _message_count;        // Count of messages
+    NameString name;                    // Channel name
+    IdString ID;                        // Unique channel ID
+    std::vector<Message*> channel_messages; // Resident window of this channel's history
+    unsigned int _message_count;        // Count of resident messages
+    uint32_t history_first;             // Stored record index of channel_messages[0]
+    uint32_t history_count;             // Records in stored history (see HistoryStore)
+    unsigned int unread_count;          // Messages received while not viewed
+    unsigned long last_activity;        // millis() of the latest message (0 = none)
+    Channel* activity_prev;             // Intrusive activity list (most recent first)
+    Channel* activity_next;
+
+    // 16-bit hashes of the message keys of the newest key_count stored
+    // records, independent of the resident window, so a replayed backlog is
+    // caught as far back as the history goes (see HistoryStore::seen).
+    // Record i lives in slot (i + key_base) % STORED_KEYS.
+    uint16_t key_hashes[STORED_KEYS];
+    uint32_t key_base;
+    uint16_t key_count;
 
     // Default constructor
     Channel()
-        : channel_type(CHAT_GROUP), name(""), ID(""), _message_count(0) {}
+        : channel_type(CHAT_GROUP), _message_count(0),
+          history_first(0), history_count(0),
+          unread_count(0), last_activity(0), activity_prev(nullptr), activity_next(nullptr),
+          key_base(0), key_count(0) {}
 
     // Parameterized constructor
-    Channel(byte type, const String& n, const String& id)
-        : channel_type(type), name(n), ID(id), _message_count(0) {}
+    Channel(byte type, const NameString& n, const IdString& id)
+        : channel_type(type), name(n), ID(id), _message_count(0),
+          history_first(0), history_count(0),
+          unread_count(0), last_activity(0), activity_prev(nullptr), activity_next(nullptr),
+          key_base(0), key_count(0) {}
 
     // Add a message pointer to this channel and increment message count
     void addMessage(Message* msg) {
@@ -106,34 +145,78 @@ struct Channel {
     }
 };
 
+// ================== OBJECT POOLS ==========================
+// Users, channels and messages live in fixed static arenas; the lists below
+// hold non-owning pointers into them. Create/destroy only through the
+// functions further down.
+const uint16_t POOL_USERS    = 64;
+const uint16_t POOL_CHANNELS = 16;
+const uint16_t POOL_MESSAGES = 256;  // Resident history windows (see HistoryStore)
+
+extern ObjectPool<User, POOL_USERS> user_pool;
+extern ObjectPool<Channel, POOL_CHANNELS> channel_pool;
+extern ObjectPool<Message, POOL_MESSAGES> message_pool;
+
 // ================== GLOBAL OBJECTS ========================
 // Lists of all users, channels, and messages
 extern std::vector<User*> all_users;
 extern std::vector<Channel*> all_channels;
 extern std::vector<Message*> all_messages;
 
+// Channels ordered by recent activity (intrusive list through Channel)
+extern Channel* channels_by_activity;
+
 // Current local user
 extern User* local_user;
 
 // ================== RTC OBJECT =============================
-// Real-time clock (DS3231)
+// Real-time clock (DS3231). It always holds UTC: GPS writes UTC and message
+// IDs carry Unix time. Local time is only for display, UTC_OFFSET_MIN
+// minutes east of UTC (build flag, default 0).
 extern RTC_DS3231 rtc;
 
+#ifndef UTC_OFFSET_MIN
+#define UTC_OFFSET_MIN 0
+#endif
+
+// ================== OBJECT LIFETIME ======================
+// Pool-backed constructors; nullptr when the pool is exhausted
+User* createUser(const IdString& id, const NameString& uname);
+Channel* createChannel(byte type, const NameString& name, const IdString& id);
+Message* createMessage(const IdString& ch_id, const IdString& msg_id, const IdString& sender,
+                       const String& msg, const String& ts = "",
+                       int rssi = 0, int snr = 0, unsigned long latency = 0);
+
+// Return objects to their pools (destroyMessage also drops it from all_messages)
+void destroyUser(User* user);
+void destroyMessage(Message* msg);
+
+// Destroy every user / every channel with its resident messages
+void clearUsers();
+void clearChannels();
+
 // ================== HELPER FUNCTIONS =====================
-// Find user, channel, or message by ID
-User* findUserById(const String& id);
-Channel* findChannelById(const String& id);
-Message* findMessageById(const String& id);
+// Find user, channel, or message by ID (hash-first compares)
+User* findUserById(const IdString& id);
+Channel* findChannelById(const IdString& id);
+Message* findMessageById(const IdString& id);
+Message* findMessageByKey(uint64_t key);
+
+// Channel activity ordering
+void registerChannel(Channel* ch);        // Add to all_channels and the activity list tail
+void rebuildChannelActivity();            // Relink the activity list from all_channels
+void touchChannelActivity(Channel* ch);   // Stamp activity and move to front (O(1))
+Channel* channelAtActivityIndex(size_t index);
 
 // Generate a unique message ID
-String generateMessageId();
+IdString generateMessageId();
 
 // Update message latency (only updates if not already set)
-bool updateMessageLatency(const String& messageId, int rssi, int snr, unsigned long latency);
+bool updateMessageLatency(const IdString& messageId, int rssi, int snr, unsigned long latency);
 
 // RTC functions
 void RTC_setup();
-String getTime();
+String getTime();   // Local time (UTC + UTC_OFFSET_MIN) for timestamps and the header
 
 
 
@@ -0,0 +1,391 @@
+#pragma once
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ================== Host Arduino shim ===================
+// Just enough of the ESP32 Arduino core for the firmware modules to build
+// and run natively (pio test -e native). Everything is header-only; the
+// shared objects live in function-local statics, so no test has to define
+// them.
+//
+// Time is simulated: millis()/micros() read HostClock, which only moves when
+// a test (or the timing TFT shim) advances it, so timings are reproducible.
+// String keeps its text on the heap like the Arduino class (no small-string
+// buffer), so tests can count allocations through operator new.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <string>
+#include <deque>
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HEX 16
+#define DEC 10
+#define F(x) x
+#define IRAM_ATTR
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+#define PI 3.14159265358979
+
+using std::min;
+using std::max;
+
+// ----- HostClock -----
+// Simulated time in microseconds
+struct HostClock {
+    static uint64_t& us() { static uint64_t t = 0; return t; }
+    static void advance(uint64_t d) { us() += d; }
+    static void advanceMs(uint64_t d) { us() += d * 1000; }
+};
+
+inline unsigned long millis() { return (unsigned long) (HostClock::us() / 1000); }
+inline unsigned long micros() { return (unsigned long) HostClock::us(); }
+inline void delay(unsigned long ms) { HostClock::advanceMs(ms); }
+inline void delayMicroseconds(unsigned int us) { HostClock::advance(us); }
+inline void yield() {}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+template <class T, class L, class H>
+T constrain(T x, L lo, H hi) { return x < lo ? lo : (x > hi ? hi : x); }
+
+// Deterministic, so runs repeat exactly
+inline uint32_t& hostRandomState() { static uint32_t s = 1; return s; }
+inline void randomSeed(unsigned long seed) { hostRandomState() = seed ? seed : 1; }
+inline long random(long howbig) {
+    uint32_t& s = hostRandomState();
+    s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+    return howbig > 0 ? (long) (s % (uint32_t) howbig) : 0;
+}
+inline long random(long lo, long hi) { return hi > lo ? lo + random(hi - lo) : lo; }
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(uint8_t, void (*)(), int) {}
+inline void detachInterrupt(uint8_t) {}
+inline void interrupts() {}
+inline void noInterrupts() {}
+inline void ledcSetup(uint8_t, double, uint8_t) {}
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+inline void ledcWrite(uint8_t, uint32_t) {}
+
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isSpace(int c) { return isspace(c) != 0; }
+
+// ================== String ==================
+class String {
+public:
+    String(const char* s = "") { init(s, s ? strlen(s) : 0); }
+    String(const char* s, size_t n) { init(s, n); }
+    String(const String& o) { init(o.buf, o.len); }
+    String(String&& o) : buf(o.buf), len(o.len), cap(o.cap) { o.buf = nullptr; o.len = o.cap = 0; }
+    explicit String(char c) { char s[2] = { c, 0 }; init(s, 1); }
+    explicit String(unsigned char v, unsigned char base = 10) { initNum((unsigned long) v, base); }
+    explicit String(int v, unsigned char base = 10) { initSigned(v, base); }
+    explicit String(unsigned int v, unsigned char base = 10) { initNum(v, base); }
+    explicit String(long v, unsigned char base = 10) { initSigned(v, base); }
+    explicit String(unsigned long v, unsigned char base = 10) { initNum(v, base); }
+    explicit String(float v, unsigned int digits = 2) { initFloat(v, digits); }
+    explicit String(double v, unsigned int digits = 2) { initFloat(v, digits); }
+    ~String() { delete[] buf; }
+
+    String& operator=(const String& o) { if (this != &o) copy(o.buf, o.len); return *this; }
+    String& operator=(String&& o) {
+        if (this != &o) {
+            delete[] buf;
+            buf = o.buf; len = o.len; cap = o.cap;
+            o.buf = nullptr; o.len = o.cap = 0;
+        }
+        return *this;
+    }
+    String& operator=(const char* s) { copy(s, s ? strlen(s) : 0); return *this; }
+
+    unsigned int length() const { return len; }
+    const char* c_str() const { return buf ? buf : ""; }
+    bool isEmpty() const { return len == 0; }
+    char operator[](unsigned int i) const { return i < len ? buf[i] : 0; }
+    char& operator[](unsigned int i) { static char dummy; return i < len ? buf[i] : (dummy = 0); }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+    void setCharAt(unsigned int i, char c) { if (i < len) buf[i] = c; }
+
+    bool equals(const String& o) const { return len == o.len && memcmp(c_str(), o.c_str(), len) == 0; }
+    bool operator==(const String& o) const { return equals(o); }
+    bool operator!=(const String& o) const { return !equals(o); }
+    bool operator==(const char* s) const { return strcmp(c_str(), s ? s : "") == 0; }
+    bool operator!=(const char* s) const { return !(*this == s); }
+    bool operator<(const String& o) const { return strcmp(c_str(), o.c_str()) < 0; }
+
+    bool concat(const char* s, unsigned int n) {
+        if (!n) return true;
+        reserve(len + n);
+        memcpy(buf + len, s, n);
+        len += n;
+        buf[len] = 0;
+        return true;
+    }
+    bool concat(const String& o) { return concat(o.c_str(), o.len); }
+    bool concat(const char* s) { return concat(s, s ? strlen(s) : 0); }
+    bool concat(char c) { return concat(&c, 1); }
+    String& operator+=(const String& o) { concat(o); return *this; }
+    String& operator+=(const char* s) { concat(s); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    bool reserve(unsigned int n) {
+        if (n <= cap && buf) return true;
+        char* nb = new char[n + 1];
+        if (buf) memcpy(nb, buf, len + 1);
+        else     nb[0] = 0;
+        delete[] buf;
+        buf = nb;
+        cap = n;
+        return true;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const {
+        if (from >= len) return -1;
+        const char* p = (const char*) memchr(buf + from, c, len - from);
+        return p ? (int) (p - buf) : -1;
+    }
+    int indexOf(const char* s, unsigned int from = 0) const {
+        if (from > len) return -1;
+        const char* p = strstr(c_str() + from, s);
+        return p ? (int) (p - c_str()) : -1;
+    }
+    int indexOf(const String& s, unsigned int from = 0) const { return indexOf(s.c_str(), from); }
+    int lastIndexOf(char c) const {
+        for (int i = (int) len - 1; i >= 0; --i) if (buf[i] == c) return i;
+        return -1;
+    }
+
+    String substring(unsigned int from) const { return substring(from, len); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= len) return String();
+        if (to > len) to = len;
+        return String(buf + from, to - from);
+    }
+    bool startsWith(const String& p) const { return p.len <= len && memcmp(c_str(), p.c_str(), p.len) == 0; }
+    bool endsWith(const String& p) const {
+        return p.len <= len && memcmp(c_str() + len - p.len, p.c_str(), p.len) == 0;
+    }
+
+    void trim() {
+        if (!len) return;
+        unsigned int a = 0, b = len;
+        while (a < b && isspace((unsigned char) buf[a])) a++;
+        while (b > a && isspace((unsigned char) buf[b - 1])) b--;
+        memmove(buf, buf + a, b - a);
+        len = b - a;
+        buf[len] = 0;
+    }
+    void remove(unsigned int index) { if (index < len) { len = index; buf[len] = 0; } }
+    void remove(unsigned int index, unsigned int count) {
+        if (index >= len) return;
+        count = std::min(count, len - index);
+        memmove(buf + index, buf + index + count, len - index - count + 1);
+        len -= count;
+    }
+    void toUpperCase() { for (unsigned int i = 0; i < len; ++i) buf[i] = toupper((unsigned char) buf[i]); }
+    void toLowerCase() { for (unsigned int i = 0; i < len; ++i) buf[i] = tolower((unsigned char) buf[i]); }
+    long toInt() const { return atol(c_str()); }
+    float toFloat() const { return (float) atof(c_str()); }
+    void toCharArray(char* out, unsigned int n, unsigned int index = 0) const {
+        if (!n) return;
+        unsigned int k = index < len ? std::min(n - 1, len - index) : 0;
+        memcpy(out, c_str() + index, k);
+        out[k] = 0;
+    }
+    void getBytes(unsigned char* out, unsigned int n, unsigned int index = 0) const {
+        toCharArray((char*) out, n, index);
+    }
+
+private:
+    char* buf = nullptr;
+    unsigned int len = 0;
+    unsigned int cap = 0;
+
+    void init(const char* s, size_t n) {
+        buf = nullptr; len = cap = 0;
+        copy(s, n);
+    }
+    void copy(const char* s, size_t n) {
+        if (!n) {
+            // Empty strings own no buffer, as in the Arduino core
+            delete[] buf;
+            buf = nullptr;
+            len = cap = 0;
+            return;
+        }
+        if (!buf || n > cap) {
+            char* nb = new char[n + 1];
+            delete[] buf;
+            buf = nb;
+            cap = n;
+        }
+        memmove(buf, s, n);
+        buf[n] = 0;
+        len = n;
+    }
+    void initNum(unsigned long v, unsigned char base) {
+        char s[34];
+        char* p = s + sizeof(s) - 1;
+        *p = 0;
+        if (base < 2) base = 10;
+        do {
+            unsigned d = v % base;
+            *--p = d < 10 ? '0' + d : 'A' + d - 10;
+            v /= base;
+        } while (v);
+        init(p, strlen(p));
+    }
+    void initSigned(long v, unsigned char base) {
+        if (v < 0 && base == 10) {
+            char s[24];
+            snprintf(s, sizeof(s), "%ld", v);
+            init(s, strlen(s));
+        } else {
+            initNum((unsigned long) v, base);
+        }
+    }
+    void initFloat(double v, unsigned int digits) {
+        char s[48];
+        snprintf(s, sizeof(s), "%.*f", digits, v);
+        init(s, strlen(s));
+    }
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, char b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, int b) { return a + String(b); }
+inline String operator+(const String& a, unsigned int b) { return a + String(b); }
+inline String operator+(const String& a, long b) { return a + String(b); }
+inline String operator+(const String& a, unsigned long b) { return a + String(b); }
+
+// ================== Print / Serial ==================
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) { return write(&c, 1); }
+    virtual size_t write(const uint8_t* data, size_t n) { (void) data; return n; }
+    size_t write(const char* s, size_t n) { return write((const uint8_t*) s, n); }
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s, strlen(s)); }
+    size_t print(char c) { return write((uint8_t) c); }
+    size_t print(int v, int base = DEC) { return print(String(v, (unsigned char) base)); }
+    size_t print(unsigned int v, int base = DEC) { return print(String(v, (unsigned char) base)); }
+    size_t print(long v, int base = DEC) { return print(String(v, (unsigned char) base)); }
+    size_t print(unsigned long v, int base = DEC) { return print(String(v, (unsigned char) base)); }
+    size_t print(double v, int digits = 2) { return print(String(v, (unsigned int) digits)); }
+    size_t println() { return print("\n"); }
+    template <class T> size_t println(const T& v) { return print(v) + println(); }
+    template <class T> size_t println(const T& v, int f) { return print(v, f) + println(); }
+    size_t printf(const char* fmt, ...) {
+        char s[512];
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(s, sizeof(s), fmt, ap);
+        va_end(ap);
+        return n > 0 ? write(s, std::min((size_t) n, sizeof(s) - 1)) : 0;
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+    void setTimeout(unsigned long) {}
+    size_t readBytes(uint8_t* out, size_t n) {
+        size_t k = 0;
+        while (k < n && available()) out[k++] = (uint8_t) read();
+        return k;
+    }
+    size_t readBytes(char* out, size_t n) { return readBytes((uint8_t*) out, n); }
+    String readStringUntil(char end) {
+        String s;
+        int c;
+        while ((c = read()) >= 0 && c != end) s += (char) c;
+        return s;
+    }
+};
+
+#define SERIAL_8N1 0x800001c
+
+// ----- HardwareSerial -----
+// TX is captured in 'tx'; tests queue RX bytes with inject()
+class HardwareSerial : public Stream {
+public:
+    std::string tx;
+    std::deque<uint8_t> rx;
+    size_t tx_room = 4096;   // What availableForWrite() reports
+
+    void begin(unsigned long, uint32_t = SERIAL_8N1, int8_t = -1, int8_t = -1) {}
+    void end() {}
+    void flush() {}
+    operator bool() const { return true; }
+    size_t setTxBufferSize(size_t n) { return n; }
+    size_t setRxBufferSize(size_t n) { return n; }
+    void onReceive(void (*)(void)) {}
+    int availableForWrite() { return (int) tx_room; }
+
+    using Print::write;
+    size_t write(const uint8_t* data, size_t n) override { tx.append((const char*) data, n); return n; }
+    int available() override { return (int) rx.size(); }
+    int read() override {
+        if (rx.empty()) return -1;
+        int c = rx.front();
+        rx.pop_front();
+        return c;
+    }
+    int peek() override { return rx.empty() ? -1 : rx.front(); }
+
+    void inject(const char* s) { while (*s) rx.push_back((uint8_t) *s++); }
+};
+
+inline HardwareSerial& hostSerial(int port) {
+    static HardwareSerial ports[3];
+    return ports[port];
+}
+#define Serial  hostSerial(0)
+#define Serial2 hostSerial(2)
+
+// ----- EspClass -----
+class EspClass {
+public:
+    uint64_t mac = 0x24A1600C0FFEULL;   // Tests set this to simulate other nodes
+    uint32_t getCycleCount() { return (uint32_t) (HostClock::us() * 240); }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getFreeHeap() { return 200000; }
+    uint32_t getMinFreeHeap() { return 180000; }
+    uint32_t getMaxAllocHeap() { return 110000; }
+    uint64_t getEfuseMac() { return mac; }
+    void restart() {}
+};
+
+inline EspClass& hostEsp() {
+    static EspClass esp;
+    return esp;
+}
+#define ESP hostEsp()
+
+#endif // HOST_ARDUINO_H
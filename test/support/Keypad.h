@@ -0,0 +1,60 @@
+#pragma once
+#ifndef HOST_KEYPAD_H
+#define HOST_KEYPAD_H
+
+// ================== Host Keypad shim ===================
+// No matrix to scan: getKey() never reports a key. Tests drive the real
+// KeypadHandler through the listener it registers (see listener()).
+
+#include <Arduino.h>
+
+typedef char KeypadEvent;
+#define NO_KEY '\0'
+#define LIST_MAX 10
+#define makeKeymap(x) ((char*) x)
+
+enum KeyState { IDLE, PRESSED, HOLD, RELEASED };
+
+struct Key {
+    char kchar;
+    int kcode;
+    KeyState kstate;
+    bool stateChanged;
+};
+
+class Keypad {
+public:
+    Key key[LIST_MAX];
+
+    Keypad(char* map, byte* rows, byte* cols, byte nrows, byte ncols)
+        : keymap(map), row_pins(rows), col_pins(cols), n_rows(nrows), n_cols(ncols) {
+        memset(key, 0, sizeof(key));
+    }
+
+    char getKey() { return NO_KEY; }
+    bool getKeys() { return false; }
+    KeyState getState() { return state; }
+    void addEventListener(void (*fn)(char)) { listener_fn = fn; }
+    void setHoldTime(unsigned int) {}
+    void setDebounceTime(unsigned int) {}
+
+    // Deliver one event to the registered listener, as a scan would
+    void fire(char k, KeyState s) {
+        state = s;
+        key[0].kchar = k;
+        key[0].kstate = s;
+        key[0].stateChanged = true;
+        if (listener_fn) listener_fn(k);
+    }
+    void (*listener())(char) { return listener_fn; }
+
+private:
+    char* keymap;
+    byte* row_pins;
+    byte* col_pins;
+    byte n_rows, n_cols;
+    KeyState state = IDLE;
+    void (*listener_fn)(char) = nullptr;
+};
+
+#endif // HOST_KEYPAD_H
@@ -0,0 +1,116 @@
+#pragma once
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+// ================== Host LittleFS shim ===================
+// In-memory filesystem. Tests can make mounting fail (fail_mount) or cap
+// the space (capacity): writes past it are short, as on a full partition.
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct HostFsData {
+    std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> files;
+    bool fail_mount = false;
+    size_t capacity = SIZE_MAX;
+    size_t used() const {
+        size_t n = 0;
+        for (const auto& f : files) n += f.second->size();
+        return n;
+    }
+};
+
+inline HostFsData& hostFs() { static HostFsData fs; return fs; }
+
+class File {
+public:
+    File() {}
+    File(std::shared_ptr<std::vector<uint8_t>> d, bool append) : data(d), pos(append ? d->size() : 0) {}
+
+    operator bool() const { return (bool) data; }
+    size_t size() { return data ? data->size() : 0; }
+    size_t position() { return pos; }
+    bool seek(uint32_t p) {
+        if (!data || p > data->size()) return false;
+        pos = p;
+        return true;
+    }
+    size_t read(uint8_t* out, size_t n) {
+        if (!data || pos >= data->size()) return 0;
+        n = std::min(n, data->size() - pos);
+        memcpy(out, data->data() + pos, n);
+        pos += n;
+        return n;
+    }
+    int read() {
+        uint8_t c;
+        return read(&c, 1) ? c : -1;
+    }
+    size_t write(const uint8_t* in, size_t n) {
+        if (!data) return 0;
+        HostFsData& fs = hostFs();
+        size_t grow = pos + n > data->size() ? pos + n - data->size() : 0;
+        size_t room = fs.capacity > fs.used() ? fs.capacity - fs.used() : 0;
+        if (grow > room) n -= grow - room;
+        if (pos + n > data->size()) data->resize(pos + n);
+        memcpy(data->data() + pos, in, n);
+        pos += n;
+        return n;
+    }
+    void close() { data.reset(); }
+
+private:
+    std::shared_ptr<std::vector<uint8_t>> data;
+    size_t pos = 0;
+};
+
+class LittleFSFS {
+public:
+    bool begin(bool = false) { return !hostFs().fail_mount; }
+    void end() {}
+    bool format() { hostFs().files.clear(); return true; }
+    bool exists(const char* path) { return hostFs().files.count(path) || isDir(path); }
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool mkdir(const char* path) { dirs().push_back(path); return true; }
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    File open(const char* path, const char* mode) {
+        auto& files = hostFs().files;
+        auto it = files.find(path);
+        if (mode[0] == 'r' && mode[1] != '+') {
+            return it == files.end() ? File() : File(it->second, false);
+        }
+        if (mode[0] == 'w' || it == files.end()) {
+            auto d = std::make_shared<std::vector<uint8_t>>();
+            files[path] = d;
+            return File(d, false);
+        }
+        return File(it->second, mode[0] == 'a');
+    }
+    File open(const String& path, const char* mode) { return open(path.c_str(), mode); }
+    bool remove(const String& path) { return hostFs().files.erase(path.c_str()) > 0; }
+    bool rename(const String& from, const String& to) {
+        auto& files = hostFs().files;
+        auto it = files.find(from.c_str());
+        if (it == files.end()) return false;
+        files[to.c_str()] = it->second;
+        files.erase(it);
+        return true;
+    }
+    size_t totalBytes() { return hostFs().capacity; }
+    size_t usedBytes() { return hostFs().used(); }
+
+private:
+    static std::vector<std::string>& dirs() { static std::vector<std::string> d; return d; }
+    static bool isDir(const char* path) {
+        for (const auto& d : dirs()) if (d == path) return true;
+        return false;
+    }
+};
+
+inline LittleFSFS& hostLittleFS() { static LittleFSFS fs; return fs; }
+#define LittleFS hostLittleFS()
+
+#endif // HOST_LITTLEFS_H
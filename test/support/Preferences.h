@@ -0,0 +1,78 @@
+#pragma once
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+// ================== Host Preferences shim ===================
+// NVS as one in-memory map per namespace; it survives begin()/end(), like
+// flash, for the lifetime of the test program.
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::map<std::string, std::vector<uint8_t>> HostNvsSpace;
+
+inline std::map<std::string, HostNvsSpace>& hostNvs() {
+    static std::map<std::string, HostNvsSpace> nvs;
+    return nvs;
+}
+
+class Preferences {
+public:
+    bool begin(const char* name, bool = false, const char* = nullptr) {
+        space = &hostNvs()[name];
+        return true;
+    }
+    void end() { space = nullptr; }
+    bool clear() { if (space) space->clear(); return true; }
+    bool remove(const char* key) { return space && space->erase(key) > 0; }
+    bool isKey(const char* key) { return space && space->count(key); }
+
+    size_t putBytes(const char* key, const void* data, size_t len) {
+        if (!space) return 0;
+        const uint8_t* p = (const uint8_t*) data;
+        (*space)[key].assign(p, p + len);
+        return len;
+    }
+    size_t getBytesLength(const char* key) {
+        if (!space) return 0;
+        auto it = space->find(key);
+        return it == space->end() ? 0 : it->second.size();
+    }
+    size_t getBytes(const char* key, void* out, size_t len) {
+        if (!space) return 0;
+        auto it = space->find(key);
+        if (it == space->end() || it->second.size() > len) return 0;
+        memcpy(out, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+
+    size_t putString(const char* key, const String& v) { return putBytes(key, v.c_str(), v.length() + 1); }
+    String getString(const char* key, const String& def = String()) {
+        size_t n = getBytesLength(key);
+        if (!n) return def;
+        return String((const char*) (*space)[key].data());
+    }
+
+    template <class T> size_t putValue(const char* key, T v) { return putBytes(key, &v, sizeof(v)); }
+    template <class T> T getValue(const char* key, T def) {
+        T v;
+        return getBytesLength(key) == sizeof(T) && getBytes(key, &v, sizeof(v)) ? v : def;
+    }
+    size_t putInt(const char* key, int32_t v) { return putValue(key, v); }
+    int32_t getInt(const char* key, int32_t def = 0) { return getValue(key, def); }
+    size_t putUInt(const char* key, uint32_t v) { return putValue(key, v); }
+    uint32_t getUInt(const char* key, uint32_t def = 0) { return getValue(key, def); }
+    size_t putUChar(const char* key, uint8_t v) { return putValue(key, v); }
+    uint8_t getUChar(const char* key, uint8_t def = 0) { return getValue(key, def); }
+    size_t putULong64(const char* key, uint64_t v) { return putValue(key, v); }
+    uint64_t getULong64(const char* key, uint64_t def = 0) { return getValue(key, def); }
+    size_t putBool(const char* key, bool v) { return putValue(key, (uint8_t) v); }
+    bool getBool(const char* key, bool def = false) { return getValue(key, (uint8_t) def) != 0; }
+
+private:
+    HostNvsSpace* space = nullptr;
+};
+
+#endif // HOST_PREFERENCES_H
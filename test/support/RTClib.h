@@ -0,0 +1,84 @@
+#pragma once
+#ifndef HOST_RTCLIB_H
+#define HOST_RTCLIB_H
+
+// ================== Host RTClib shim ===================
+// DateTime in Unix seconds (2000..2099 range is enough here) and a DS3231
+// that ticks with HostClock from the last adjust().
+
+#include <Arduino.h>
+
+class TimeSpan {
+public:
+    TimeSpan(int32_t seconds = 0) : secs(seconds) {}
+    int32_t totalseconds() const { return secs; }
+private:
+    int32_t secs;
+};
+
+class DateTime {
+public:
+    DateTime(uint32_t t = 946684800) : epoch(t) {}
+    DateTime(uint16_t y, uint8_t m, uint8_t d, uint8_t hh = 0, uint8_t mm = 0, uint8_t ss = 0) {
+        epoch = (uint32_t) daysFromCivil(y, m, d) * 86400 + hh * 3600 + mm * 60 + ss;
+    }
+    // __DATE__ ("Mmm dd yyyy") and __TIME__ ("hh:mm:ss")
+    DateTime(const char* date, const char* time) {
+        static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+        char mon[4] = { date[0], date[1], date[2], 0 };
+        uint8_t m = (uint8_t) ((strstr(months, mon) - months) / 3 + 1);
+        epoch = DateTime((uint16_t) atoi(date + 7), m, (uint8_t) atoi(date + 4),
+                        (uint8_t) atoi(time), (uint8_t) atoi(time + 3), (uint8_t) atoi(time + 6)).epoch;
+    }
+
+    uint32_t unixtime() const { return epoch; }
+    uint16_t year() const { int y, m, d; civil(y, m, d); return (uint16_t) y; }
+    uint8_t month() const { int y, m, d; civil(y, m, d); return (uint8_t) m; }
+    uint8_t day() const { int y, m, d; civil(y, m, d); return (uint8_t) d; }
+    uint8_t hour() const { return (epoch / 3600) % 24; }
+    uint8_t minute() const { return (epoch / 60) % 60; }
+    uint8_t second() const { return epoch % 60; }
+
+    DateTime operator+(const TimeSpan& s) const { return DateTime(epoch + s.totalseconds()); }
+    DateTime operator-(const TimeSpan& s) const { return DateTime(epoch - s.totalseconds()); }
+
+private:
+    uint32_t epoch;
+
+    static long daysFromCivil(int y, int m, int d) {
+        y -= m <= 2;
+        long era = y / 400;
+        long yoe = y - era * 400;
+        long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+    void civil(int& y, int& m, int& d) const {
+        long z = epoch / 86400 + 719468;
+        long era = z / 146097;
+        long doe = z - era * 146097;
+        long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        long mp = (5 * doy + 2) / 153;
+        d = (int) (doy - (153 * mp + 2) / 5 + 1);
+        m = (int) (mp < 10 ? mp + 3 : mp - 9);
+        y = (int) (yoe + era * 400 + (m <= 2));
+    }
+};
+
+class RTC_DS3231 {
+public:
+    bool begin() { return true; }
+    bool lostPower() { return false; }
+    void adjust(const DateTime& t) {
+        set_unix = t.unixtime();
+        set_ms = millis();
+    }
+    DateTime now() { return DateTime(set_unix + (millis() - set_ms) / 1000); }
+
+private:
+    uint32_t set_unix = 1760000000;   // Oct 2025
+    unsigned long set_ms = 0;
+};
+
+#endif // HOST_RTCLIB_H
@@ -0,0 +1,343 @@
+#pragma once
+#ifndef HOST_TFT_ESPI_H
+#define HOST_TFT_ESPI_H
+
+// ================== Host TFT_eSPI shim ===================
+// Recording, timing stand-in for the panel. Every primitive that reaches
+// the bus is counted in 'stats' (and logged to 'ops' while 'recording',
+// with streamed pixel values appended to 'pushed' as they would go over
+// the wire), and charges its SPI time to HostClock:
+//
+//     CALL_US + pixels * PIXEL_NS / 1000
+//
+// PIXEL_NS is one RGB565 pixel at SPI_FREQUENCY (27 MHz -> 593 ns);
+// CALL_US covers the address window and command bytes. Text is charged
+// as an opaque box of textWidth x fontHeight. Drawing into a sprite costs
+// no bus time; pushing it does.
+//
+// Glyph widths follow a fixed model (narrow / wide / normal classes per
+// font), so layout results are deterministic across hosts.
+
+#include <Arduino.h>
+#include <vector>
+#include <string>
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKCYAN    0x03EF
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_OLIVE       0x7BE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK        0xFE19
+#define TFT_BROWN       0x9A60
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+#define TFT_SKYBLUE     0x867D
+#define TFT_VIOLET      0x915C
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+#ifndef TFT_WIDTH
+#define TFT_WIDTH  240
+#endif
+#ifndef TFT_HEIGHT
+#define TFT_HEIGHT 320
+#endif
+
+// ----- TftOp -----
+// One logged primitive: 'F' fill, 'R' outline, 'S' string, 'P' pixel push,
+// 'C' clear screen, 'G' other geometry
+struct TftOp {
+    char op;
+    int32_t x, y, w, h;
+    uint32_t color;
+    std::string text;
+};
+
+struct TftStats {
+    uint32_t calls;          // Primitives that reached the bus
+    uint32_t fills;
+    uint32_t strings;
+    uint32_t pushes;
+    uint32_t clears;         // fillScreen
+    uint32_t measures;       // textWidth() calls
+    uint64_t pixels;
+    uint64_t bus_us;
+};
+
+class TFT_eSPI : public Print {
+public:
+    static const uint32_t PIXEL_NS = 593;
+    static const uint32_t CALL_US = 4;
+
+    TftStats stats;
+    std::vector<TftOp> ops;
+    std::vector<uint16_t> pushed;   // pushColor / pushPixels data while recording
+    bool recording = false;
+    bool DMA_Enabled = false;
+
+    TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT) : _init_w(w), _init_h(h), _w(w), _h(h) {
+        memset(&stats, 0, sizeof(stats));
+    }
+    virtual ~TFT_eSPI() {}
+
+    void resetStats() { memset(&stats, 0, sizeof(stats)); ops.clear(); pushed.clear(); }
+
+    void init(uint8_t = 0) {}
+    void begin() {}
+    void setRotation(uint8_t r) {
+        _rotation = r & 3;
+        bool swap = _rotation & 1;
+        _w = swap ? _init_h : _init_w;
+        _h = swap ? _init_w : _init_h;
+    }
+    uint8_t getRotation() { return _rotation; }
+    int16_t width() { return _w; }
+    int16_t height() { return _h; }
+    void invertDisplay(bool) {}
+    void writecommand(uint8_t) { bus('G', 0, 0, 0, 0, 0, 0); }
+    void writedata(uint8_t) {}
+
+    // ------------------ Geometry -----------------------
+    void fillScreen(uint32_t color) { stats.clears++; fillRect(0, 0, _w, _h, color); }
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+        if (!isSprite()) stats.fills++;
+        bus('F', x, y, w, h, color, (uint64_t) w * h);
+    }
+    void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t, uint32_t color) {
+        fillRect(x, y, w, h, color);
+    }
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+        bus('R', x, y, w, h, color, 2 * (uint64_t) (w + h));
+    }
+    void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t, uint32_t color) {
+        drawRect(x, y, w, h, color);
+    }
+    void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color) {
+        bus('G', x - r, y - r, 2 * r + 1, 2 * r + 1, color, (uint64_t) (3 * r * r + 1));
+    }
+    void drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color) {
+        bus('G', x - r, y - r, 2 * r + 1, 2 * r + 1, color, (uint64_t) (6 * r + 1));
+    }
+    void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color) {
+        int32_t x = std::min(x0, std::min(x1, x2)), y = std::min(y0, std::min(y1, y2));
+        int32_t w = std::max(x0, std::max(x1, x2)) - x + 1, h = std::max(y0, std::max(y1, y2)) - y + 1;
+        bus('G', x, y, w, h, color, (uint64_t) w * h / 2);
+    }
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) { bus('G', x, y, w, 1, color, w); }
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) { bus('G', x, y, 1, h, color, h); }
+    void drawPixel(int32_t x, int32_t y, uint32_t color) { bus('G', x, y, 1, 1, color, 1); }
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+        int32_t n = std::max(abs(x1 - x0), abs(y1 - y0)) + 1;
+        bus('G', std::min(x0, x1), std::min(y0, y1), abs(x1 - x0) + 1, abs(y1 - y0) + 1, color, n);
+    }
+
+    // ------------------ Text -----------------------
+    void setTextColor(uint16_t fg) { _fg = fg; }
+    void setTextColor(uint16_t fg, uint16_t bg, bool = false) { _fg = fg; _bg = bg; }
+    void setTextDatum(uint8_t d) { _datum = d; }
+    uint8_t getTextDatum() { return _datum; }
+    void setTextFont(uint8_t f) { _font = f; }
+    void setTextSize(uint8_t s) { _size = s ? s : 1; }
+    void setTextWrap(bool, bool = false) {}
+    void setCursor(int16_t, int16_t) {}
+
+    int16_t drawString(const char* s, int32_t x, int32_t y, uint8_t font) {
+        int16_t w = 0;
+        for (const char* p = s; *p; ++p) w += glyphWidth((uint8_t) *p, font) * _size;
+        int16_t h = fontHeight(font);
+        // Datum: column 0/1/2 = left/centre/right, row 0/1/2 = top/middle/bottom
+        x -= (_datum % 3) * w / 2;
+        y -= (_datum / 3) * h / 2;
+        if (!isSprite()) stats.strings++;
+        bus('S', x, y, w, h, _fg, (uint64_t) w * h, s);
+        return w;
+    }
+    int16_t drawString(const String& s, int32_t x, int32_t y, uint8_t font) { return drawString(s.c_str(), x, y, font); }
+    int16_t drawString(const char* s, int32_t x, int32_t y) { return drawString(s, x, y, _font); }
+    int16_t drawString(const String& s, int32_t x, int32_t y) { return drawString(s.c_str(), x, y, _font); }
+    int16_t drawNumber(long v, int32_t x, int32_t y, uint8_t font) { return drawString(String(v), x, y, font); }
+    int16_t drawChar(uint16_t c, int32_t x, int32_t y, uint8_t font) {
+        char s[2] = { (char) c, 0 };
+        return drawString(s, x, y, font);
+    }
+
+    int16_t textWidth(const char* s, uint8_t font) {
+        stats.measures++;
+        int16_t w = 0;
+        for (; *s; ++s) w += glyphWidth((uint8_t) *s, font);
+        return w * _size;
+    }
+    int16_t textWidth(const String& s, uint8_t font) { return textWidth(s.c_str(), font); }
+    int16_t textWidth(const char* s) { return textWidth(s, _font); }
+    int16_t fontHeight(int16_t font) {
+        static const int16_t heights[9] = { 8, 8, 16, 16, 26, 26, 48, 48, 75 };
+        return (font >= 0 && font < 9 ? heights[font] : 16) * _size;
+    }
+    int16_t fontHeight() { return fontHeight(_font); }
+
+    // Narrow / wide / normal glyph classes; 0 for bytes the font lacks
+    static int16_t glyphWidth(uint8_t c, uint8_t font) {
+        if (c < 32 || c > 126) return font == 1 ? 6 : 0;
+        if (font == 1) return 6;
+        int16_t w = strchr("il.,:;'!|", c) ? 3 : c == ' ' ? 4 : strchr("mwMW@", c) ? 10 : 7;
+        return font >= 4 ? w * 2 - 1 : w;
+    }
+
+    // ------------------ Pixels -----------------------
+    void startWrite() {}
+    void endWrite() {}
+    void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+        _win_x = x; _win_y = y; _win_w = w; _win_h = h;
+        bus('G', x, y, w, h, 0, 0);
+    }
+    void pushColor(uint16_t c) { pushColor(c, 1); }
+    void pushColor(uint16_t c, uint32_t n) {
+        if (recording && !isSprite()) pushed.insert(pushed.end(), n, c);
+        pushPixelsCounted(n, c);
+    }
+    void pushPixels(const void* data, uint32_t n) {
+        const uint16_t* px = (const uint16_t*) data;
+        if (recording && !isSprite()) pushed.insert(pushed.end(), px, px + n);
+        pushPixelsCounted(n, 0);
+    }
+    void pushPixelsDMA(uint16_t* data, uint32_t n) { pushPixels(data, n); }
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t*) {
+        if (!isSprite()) stats.pushes++;
+        bus('P', x, y, w, h, 0, (uint64_t) w * h);
+    }
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* d) { pushImage(x, y, w, h, (const uint16_t*) d); }
+    void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* d, uint16_t* = nullptr) {
+        pushImage(x, y, w, h, (const uint16_t*) d);
+    }
+    void pushRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* d) { pushImage(x, y, w, h, (const uint16_t*) d); }
+    void readRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* d) {
+        memset(d, 0, (size_t) w * h * 2);
+        bus('G', x, y, w, h, 0, (uint64_t) w * h * 3 / 2);  // 24-bit readback
+    }
+    void setSwapBytes(bool s) { _swap = s; }
+    bool getSwapBytes() { return _swap; }
+    bool initDMA(bool = false) { DMA_Enabled = true; return true; }
+    void deInitDMA() { DMA_Enabled = false; }
+    bool dmaBusy() { return false; }
+    void dmaWait() {}
+    void setViewport(int32_t, int32_t, int32_t, int32_t, bool = true) {}
+    void resetViewport() {}
+
+    // ------------------ Touch / fonts / colour -----------------------
+    uint8_t getTouchRaw(uint16_t* x, uint16_t* y) { *x = *y = 0; return 0; }
+    uint16_t getTouchRawZ() { return 0; }
+    uint8_t getTouch(uint16_t*, uint16_t*, uint16_t = 600) { return 0; }
+    void convertRawXY(uint16_t*, uint16_t*) {}
+    void calibrateTouch(uint16_t*, uint32_t, uint32_t, uint8_t) {}
+    void setTouch(uint16_t*) {}
+    void loadFont(const uint8_t*) {}
+    void loadFont(String, bool = true) {}
+    void unloadFont() {}
+    uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+        return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+    uint16_t alphaBlend(uint8_t a, uint16_t fg, uint16_t bg) { return a > 127 ? fg : bg; }
+
+protected:
+    int16_t _init_w, _init_h, _w, _h;
+    uint8_t _rotation = 0;
+    uint8_t _datum = TL_DATUM;
+    uint8_t _font = 1;
+    uint8_t _size = 1;
+    uint16_t _fg = TFT_WHITE, _bg = TFT_BLACK;
+    bool _swap = false;
+    int32_t _win_x = 0, _win_y = 0, _win_w = 0, _win_h = 0;
+
+    virtual bool isSprite() const { return false; }
+
+    void pushPixelsCounted(uint32_t n, uint16_t color) {
+        if (!isSprite()) stats.pushes++;
+        bus('P', _win_x, _win_y, _win_w, _win_h, color, n);
+    }
+
+    void bus(char op, int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color, uint64_t pixels,
+             const char* text = nullptr) {
+        if (isSprite()) return;
+        uint64_t us = CALL_US + pixels * PIXEL_NS / 1000;
+        stats.calls++;
+        stats.pixels += pixels;
+        stats.bus_us += us;
+        HostClock::advance(us);
+        if (recording) ops.push_back(TftOp{ op, x, y, w, h, color, text ? text : "" });
+    }
+};
+
+// ----- TFT_eSprite -----
+// Owns a real buffer (4 / 8 / 16 bits per pixel); drawing into it is free
+class TFT_eSprite : public TFT_eSPI {
+public:
+    explicit TFT_eSprite(TFT_eSPI* tft) : TFT_eSPI(0, 0), _tft(tft) {}
+    ~TFT_eSprite() { deleteSprite(); }
+
+    void* createSprite(int16_t w, int16_t h, uint8_t = 1) {
+        deleteSprite();
+        size_t bytes = _depth == 4 ? (size_t) ((w + 1) >> 1) * h : (size_t) w * h * (_depth / 8);
+        _buffer = new uint8_t[bytes]();
+        _iwidth = _dwidth = _w = w;
+        _iheight = _dheight = _h = h;
+        _img4 = _img8 = _buffer;
+        _img = (uint16_t*) _buffer;
+        return _buffer;
+    }
+    void deleteSprite() {
+        delete[] _buffer;
+        _buffer = nullptr;
+        _img4 = _img8 = nullptr;
+        _img = nullptr;
+        _w = _h = 0;
+    }
+    bool created() { return _buffer != nullptr; }
+    void* setColorDepth(int8_t d) { _depth = d; return nullptr; }
+    int8_t getColorDepth() { return _depth; }
+    void createPalette(uint16_t*, uint8_t = 16) {}
+    void createPalette(const uint16_t*, uint8_t = 16) {}
+    void setPaletteColor(uint8_t, uint16_t) {}
+    uint16_t getPaletteColor(uint8_t) { return 0; }
+    void setBitmapColor(uint16_t, uint16_t) {}
+    void fillSprite(uint32_t) {}
+    void* getPointer() { return _buffer; }
+
+    void pushSprite(int32_t x, int32_t y) { if (_tft) _tft->pushImage(x, y, _w, _h, (const uint16_t*) nullptr); }
+    void pushSprite(int32_t x, int32_t y, uint16_t) { pushSprite(x, y); }
+
+protected:
+    TFT_eSPI* _tft;
+    int32_t _iwidth = 0, _iheight = 0, _dwidth = 0, _dheight = 0;
+    uint8_t* _img4 = nullptr;
+    uint8_t* _img8 = nullptr;
+    uint16_t* _img = nullptr;
+
+    bool isSprite() const override { return true; }
+
+private:
+    uint8_t* _buffer = nullptr;
+    int8_t _depth = 16;
+};
+
+#endif // HOST_TFT_ESPI_H
@@ -0,0 +1,12 @@
+#pragma once
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+// ================== Host gpio driver shim ===================
+typedef int gpio_num_t;
+typedef enum { GPIO_INTR_LOW_LEVEL = 4, GPIO_INTR_HIGH_LEVEL = 5 } gpio_int_type_t;
+
+inline int gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) { return 0; }
+inline int gpio_wakeup_disable(gpio_num_t) { return 0; }
+
+#endif // HOST_DRIVER_GPIO_H
@@ -0,0 +1,10 @@
+#pragma once
+#ifndef HOST_DRIVER_UART_H
+#define HOST_DRIVER_UART_H
+
+// ================== Host uart driver shim ===================
+typedef enum { UART_NUM_0, UART_NUM_1, UART_NUM_2 } uart_port_t;
+
+inline int uart_set_wakeup_threshold(uart_port_t, int) { return 0; }
+
+#endif // HOST_DRIVER_UART_H
@@ -0,0 +1,24 @@
+#pragma once
+#ifndef HOST_ESP_SLEEP_H
+#define HOST_ESP_SLEEP_H
+
+// ================== Host esp_sleep shim ===================
+// Light sleep returns at once with a timer wake-up
+
+#include <stdint.h>
+
+typedef int esp_err_t;
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED,
+    ESP_SLEEP_WAKEUP_TIMER,
+    ESP_SLEEP_WAKEUP_GPIO,
+    ESP_SLEEP_WAKEUP_UART,
+} esp_sleep_wakeup_cause_t;
+
+inline esp_err_t esp_sleep_enable_gpio_wakeup() { return 0; }
+inline esp_err_t esp_sleep_enable_uart_wakeup(int) { return 0; }
+inline esp_err_t esp_sleep_enable_timer_wakeup(uint64_t) { return 0; }
+inline esp_err_t esp_light_sleep_start() { return 0; }
+inline esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() { return ESP_SLEEP_WAKEUP_TIMER; }
+
+#endif // HOST_ESP_SLEEP_H
@@ -0,0 +1,227 @@
+// Generated by tools/gen_assets.py: the rasters the ASSET_* images encode,
+// one string per row, one hex digit (palette role) per pixel. Do not edit.
+#pragma once
+#ifndef ASSET_RASTER_H
+#define ASSET_RASTER_H
+
+#include "Assets/AssetData.h"
+
+struct AssetRaster {
+    const char* name;
+    const PaletteImage* image;
+    const char* const* rows;
+};
+
+static const char* const LOGO_ROWS[81] = {
+    "000000000000000000000000000000000000999999999000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000000000000099999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000000000999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000000099999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000009999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000099999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000099999999999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "00000000000000999999999999999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000C",
+    "00000000000009999999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000C",
+    "0000000000009999999999999999999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000CC",
+    "000000000009999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000000000000CCC",
+    "000000000099999999999999999999999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000CCC",
+    "00000000099999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000000000CCCC",
+    "0000000099999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000CCCCC",
+    "0000000099999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000CCCCC",
+    "000000099999999999999999999999999999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000CCCCCC",
+    "00000099999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000CCCCCCC",
+    "00000099999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000A00000000000000000000000CCCCCCC",
+    "0000099999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000000AA0000000000000000000000CCCCCCCC",
+    "000009999999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000AAA000000000000000000000CCCCCCCCC",
+    "00009999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000AAAA000000000000000000000CCCCCCCCC",
+    "0000999999999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000AAAAA00000000000000000000CCCCCCCCCC",
+    "000999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000AAAAAA0000000000000000000CCCCCCCCCCC",
+    "00099999999999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000AAAAAAA0000000000000000000CCCCCCCCCCC",
+    "0099999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000AAAAAAAA000000000000000000CCCCCCCCCCCC",
+    "009999999999999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000AAAAAAAAA00000000000000000CCCCCCCCCCCCC",
+    "00999999999999999999999999999999999999999999999999999999999999999999999999999990000000000000000000000AAAAAAAAAA00000000000000000CCCCCCCCCCCCC",
+    "0099999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000AAAAAAAAAAA0000000000000000CCCCCCCCCCCCCC",
+    "099999999999999999999999999999999999999999999999999999999999999999999999999999990000000000000000000AAAAAAAAAAAA000000000000000CCCCCCCCCCCCCCC",
+    "09999999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000AAAAAAAAAAAAA000000000000000CCCCCCCCCCCCCCC",
+    "0999999999999999999999999999999999999999999999999999999999999999999999999999999900000000000000000AAAAAAAAAAAAAA00000000000000CCCCCCCCCCCCCCCC",
+    "099999999999999999999999999999999999999999999999999999999999999999999999999999990000000000000000AAAAAAAAAAAAAAA0000000000000CCCCCCCCCCCCCCCCC",
+    "09999999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000AAAAAAAAAAAAAAAA0000000000000CCCCCCCCCCCCCCCCC",
+    "9999999999999999999999999999999999999999999999999999999999999999999999999999999990000000000000AAAAAAAAAAAAAAAAA000000000000CCCCCCCCCCCCCCCCCC",
+    "999999999999999999999999999999999999999999999999999999999999999999999999999999999000000000000AAAAAAAAAAAAAAAAAA00000000000CCCCCCCCCCCCCCCCCCC",
+    "99999999999999999999999999999999999999999999999999999999999999999999999999999999900000000000AAAAAAAAAAAAAAAAAAA00000000000CCCCCCCCCCCCCCCCCCC",
+    "9999999999999999999999999999999999999999999999999999999999999999999999999999999990000000000AAAAAAAAAAAAAAAAAAAA0000000000CCCCCCCCCCCCCCCCCCCC",
+    "999999999999999999999999999999999999999999999999999999999999999999999999999999999000000000AAAAAAAAAAAAAAAAAAAAA000000000CCCCCCCCCCCCCCCCCCCCC",
+    "9999999999999999999999999999999999999999999999999999999999999999999999999999999990000000000AAAAAAAAAAAAAAAAAAAA000000000CCCCCCCCCCCCCCCCCCCCC",
+    "99999999999999999999999999999999999999999999999999999999999999999999999999999999900000000000AAAAAAAAAAAAAAAAAAA0000000000CCCCCCCCCCCCCCCCCCCC",
+    "999999999999999999999999999999999999999999999999999999999999999999999999999999999000000000000AAAAAAAAAAAAAAAAAA00000000000CCCCCCCCCCCCCCCCCCC",
+    "9999999999999999999999999999999999999999999999999999999999999999999999999999999990000000000000AAAAAAAAAAAAAAAAA00000000000CCCCCCCCCCCCCCCCCCC",
+    "09999999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000AAAAAAAAAAAAAAAA000000000000CCCCCCCCCCCCCCCCCC",
+    "099999999999999999999999999999999999999999999999999999999999999999999999999999990000000000000000AAAAAAAAAAAAAAA0000000000000CCCCCCCCCCCCCCCCC",
+    "0999999999999999999999999999999999999999999999999999999999999999999999999999999900000000000000000AAAAAAAAAAAAAA0000000000000CCCCCCCCCCCCCCCCC",
+    "09999999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000AAAAAAAAAAAAA00000000000000CCCCCCCCCCCCCCCC",
+    "099999999999999999999999999999999999999999999999999999999999999999999999999999990000000000000000000AAAAAAAAAAAA000000000000000CCCCCCCCCCCCCCC",
+    "0099999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000AAAAAAAAAAA000000000000000CCCCCCCCCCCCCCC",
+    "00999999999999999999999999999999999999999999999999999999999999999999999999999990000000000000000000000AAAAAAAAAA0000000000000000CCCCCCCCCCCCCC",
+    "009999999999999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000AAAAAAAAA00000000000000000CCCCCCCCCCCCC",
+    "0099999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000AAAAAAAA00000000000000000CCCCCCCCCCCCC",
+    "00099999999999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000AAAAAAA000000000000000000CCCCCCCCCCCC",
+    "000999999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000AAAAAA0000000000000000000CCCCCCCCCCC",
+    "0000999999999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000AAAAA0000000000000000000CCCCCCCCCCC",
+    "00009999999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000AAAA00000000000000000000CCCCCCCCCC",
+    "000009999999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000AAA000000000000000000000CCCCCCCCC",
+    "0000099999999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000000AA000000000000000000000CCCCCCCCC",
+    "00000099999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000A0000000000000000000000CCCCCCCC",
+    "00000099999999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000CCCCCCC",
+    "00000009999999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000CCCCCCC",
+    "000000009999999999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000000CCCCCC",
+    "0000000099999999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000CCCCC",
+    "0000000009999999999999999999999999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000CCCCC",
+    "00000000009999999999999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000CCCC",
+    "000000000009999999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000000000000CCC",
+    "000000000000999999999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000CCC",
+    "0000000000000999999999999999999999999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000000000000000CC",
+    "00000000000000999999999999999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000C",
+    "000000000000000999999999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000099999999999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000999999999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000099999999999999999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000999999999999999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000009999999999999999999999999999999999900000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000000099999999999999999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000000000999999999999999999999999999000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000000000000099999999999999999990000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+    "000000000000000000000000000000000000999999999000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000",
+};
+
+static const char* const MENU_BUTTON_ROWS[30] = {
+    "000077777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777770000",
+    "000777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777000",
+    "007777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777700",
+    "077777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777770",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777",
+    "077777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777770",
+    "007777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777700",
+    "000777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777000",
+    "000077777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777777770000",
+};
+
+static const char* const SETTINGS_BUTTON_ROWS[30] = {
+    "000055555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550000",
+    "000555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555000",
+    "005555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500",
+    "055555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "055555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550",
+    "005555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500",
+    "000555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555000",
+    "000055555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550000",
+};
+
+static const char* const KEY_LEFT_ROWS[24] = {
+    "0000555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550000",
+    "0005555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555000",
+    "005555555555AAAAAAAAAAAAAAAAAAAAAAAAAA55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500",
+    "05555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAA5555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAAAA555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "05555555555AAAAAAAAAAAAAAAAAAAAAAAAAAAA5555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550",
+    "005555555555AAAAAAAAAAAAAAAAAAAAAAAAAA55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500",
+    "0005555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555000",
+    "0000555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550000",
+};
+
+static const char* const KEY_RIGHT_ROWS[24] = {
+    "0000000005555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555000000000",
+    "0000000555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550000000",
+    "00000555555555555BBBBBBBBBBBBBBBBBBBBBBBBBB555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500000",
+    "000055555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBB5555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550000",
+    "00055555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555000",
+    "0055555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500",
+    "005555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB5555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500",
+    "05555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550",
+    "05555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550",
+    "5555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "5555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555",
+    "05555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550",
+    "05555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550",
+    "005555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB5555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500",
+    "0055555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB55555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500",
+    "00055555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBBBB555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555000",
+    "000055555555555BBBBBBBBBBBBBBBBBBBBBBBBBBBBBB5555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550000",
+    "00000555555555555BBBBBBBBBBBBBBBBBBBBBBBBBB555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555500000",
+    "0000000555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555550000000",
+    "0000000005555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555555000000000",
+};
+
+static const AssetRaster ASSET_RASTERS[] = {
+    { "LOGO", &ASSET_LOGO, LOGO_ROWS },
+    { "MENU_BUTTON", &ASSET_MENU_BUTTON, MENU_BUTTON_ROWS },
+    { "SETTINGS_BUTTON", &ASSET_SETTINGS_BUTTON, SETTINGS_BUTTON_ROWS },
+    { "KEY_LEFT", &ASSET_KEY_LEFT, KEY_LEFT_ROWS },
+    { "KEY_RIGHT", &ASSET_KEY_RIGHT, KEY_RIGHT_ROWS },
+};
+
+#endif // ASSET_RASTER_H
@@ -0,0 +1,150 @@
+// Host tests for ChatLayout: word wrapping of ASCII and UTF-8 bodies,
+// tokens longer than a line, and the per-font advance cache.
+#include <unity.h>
+#include "ChatLayout/ChatLayout.h"
+
+static TFT_eSPI tft;
+static const byte FONT = 2;
+
+void setUp() {
+    ChatLayout::begin(&tft);
+    tft.resetStats();
+}
+
+void tearDown() {}
+
+// Every line fits (trailing spaces may hang), no line is empty, and no
+// break falls inside a UTF-8 sequence
+static void checkLines(const char* text, const std::vector<uint16_t>& breaks, int width, int indent) {
+    size_t len = strlen(text);
+    size_t start = 0;
+    for (size_t l = 0; l <= breaks.size(); ++l) {
+        size_t end = l < breaks.size() ? breaks[l] : len;
+        TEST_ASSERT_TRUE_MESSAGE(end > start, "empty line");
+        TEST_ASSERT_TRUE_MESSAGE(end == len || ((uint8_t) text[end] & 0xC0) != 0x80,
+                                 "break inside a UTF-8 sequence");
+
+        size_t visible = end;
+        while (visible > start && text[visible - 1] == ' ') visible--;
+        int w = ChatLayout::textWidth(text + start, visible - start, FONT);
+        TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(l == 0 ? width - indent : width, w, "line too wide");
+        start = end;
+    }
+}
+
+static void test_short_text_stays_on_one_line() {
+    std::vector<uint16_t> breaks;
+    const char* text = "hello there";
+    ChatLayout::wrap(text, strlen(text), FONT, 300, 0, breaks);
+    TEST_ASSERT_EQUAL(0, breaks.size());
+}
+
+static void test_breaks_after_spaces() {
+    std::vector<uint16_t> breaks;
+    const char* text = "the quick brown fox jumps over the lazy dog and keeps on running";
+    int width = 100;
+    ChatLayout::wrap(text, strlen(text), FONT, width, 0, breaks);
+    TEST_ASSERT_GREATER_THAN(1, breaks.size());
+    for (uint16_t b : breaks) TEST_ASSERT_EQUAL(' ', text[b - 1]);
+    checkLines(text, breaks, width, 0);
+}
+
+static void test_first_line_indent() {
+    std::vector<uint16_t> plain, indented;
+    const char* text = "alpha beta gamma delta epsilon zeta eta theta";
+    ChatLayout::wrap(text, strlen(text), FONT, 120, 0, plain);
+    ChatLayout::wrap(text, strlen(text), FONT, 120, 60, indented);
+    TEST_ASSERT_LESS_THAN(plain[0], indented[0]);
+    checkLines(text, indented, 120, 60);
+}
+
+static void test_long_token_is_split() {
+    std::vector<uint16_t> breaks;
+    std::string text(200, 'x');
+    int width = 70;  // 10 glyphs of 7 px
+    ChatLayout::wrap(text.c_str(), text.size(), FONT, width, 0, breaks);
+    TEST_ASSERT_EQUAL(19, breaks.size());
+    for (size_t i = 0; i < breaks.size(); ++i) TEST_ASSERT_EQUAL((i + 1) * 10, breaks[i]);
+    checkLines(text.c_str(), breaks, width, 0);
+}
+
+static void test_long_token_after_words() {
+    std::vector<uint16_t> breaks;
+    const char* text = "see https://example.com/a/very/long/path/that/never/ends/anywhere ok";
+    ChatLayout::wrap(text, strlen(text), FONT, 90, 0, breaks);
+    // The URL starts a new line rather than being split after "see "
+    TEST_ASSERT_EQUAL(4, breaks[0]);
+    checkLines(text, breaks, 90, 0);
+}
+
+static void test_utf8_words() {
+    std::vector<uint16_t> breaks;
+    const char* text = "caf\xC3\xA9 na\xC3\xAFve \xC3\xBC" "ber gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC" "5 d\xC3\xA9j\xC3\xA0 vu \xF0\x9F\x98\x80 ok";
+    ChatLayout::wrap(text, strlen(text), FONT, 60, 0, breaks);
+    TEST_ASSERT_GREATER_THAN(2, breaks.size());
+    checkLines(text, breaks, 60, 0);
+}
+
+static void test_utf8_long_token() {
+    std::vector<uint16_t> breaks;
+    std::string text;
+    for (int i = 0; i < 60; ++i) text += (i % 3 == 0) ? "\xC3\xA9" : (i % 3 == 1) ? "\xE2\x82\xAC" : "a";
+    ChatLayout::wrap(text.c_str(), text.size(), FONT, 50, 0, breaks);
+    TEST_ASSERT_GREATER_THAN(5, breaks.size());
+    checkLines(text.c_str(), breaks, 50, 0);
+}
+
+static void test_malformed_utf8() {
+    std::vector<uint16_t> breaks;
+    // Truncated sequences and stray continuation bytes advance one byte at a time
+    const char text[] = "ab\xC3 cd\xE2\x82 ef\x80\x80gh \xF0\x9F";
+    ChatLayout::wrap(text, sizeof(text) - 1, FONT, 30, 0, breaks);
+    size_t prev = 0;
+    for (uint16_t b : breaks) {
+        TEST_ASSERT_GREATER_THAN(prev, b);
+        prev = b;
+    }
+    TEST_ASSERT_LESS_THAN(sizeof(text) - 1, prev);
+}
+
+static void test_advances_measured_once() {
+    const char* text = "aaaa bbbb aaaa bbbb";
+    ChatLayout::textWidth(text, strlen(text), FONT);
+    uint32_t first = tft.stats.measures;
+    TEST_ASSERT_EQUAL(3, first);  // 'a', ' ', 'b'
+    ChatLayout::textWidth(text, strlen(text), FONT);
+    std::vector<uint16_t> breaks;
+    ChatLayout::wrap(text, strlen(text), FONT, 40, 0, breaks);
+    TEST_ASSERT_EQUAL(first, tft.stats.measures);
+}
+
+static void test_message_layout_cache() {
+    Message* msg = createMessage("123123", "id1", "alice",
+                                 "one two three four five six seven eight nine ten");
+    TEST_ASSERT_NOT_NULL(msg);
+    byte lines = ChatLayout::layoutMessage(msg, FONT, 80, 20);
+    TEST_ASSERT_GREATER_THAN(1, lines);
+
+    // Same font/width/indent: the stored breaks are reused as they are
+    msg->line_breaks.push_back(1);
+    TEST_ASSERT_EQUAL(lines + 1, ChatLayout::layoutMessage(msg, FONT, 80, 20));
+
+    // A new width invalidates them
+    TEST_ASSERT_EQUAL(1, ChatLayout::layoutMessage(msg, FONT, 400, 20));
+    destroyMessage(msg);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_short_text_stays_on_one_line);
+    RUN_TEST(test_breaks_after_spaces);
+    RUN_TEST(test_first_line_indent);
+    RUN_TEST(test_long_token_is_split);
+    RUN_TEST(test_long_token_after_words);
+    RUN_TEST(test_utf8_words);
+    RUN_TEST(test_utf8_long_token);
+    RUN_TEST(test_malformed_utf8);
+    RUN_TEST(test_advances_measured_once);
+    RUN_TEST(test_message_layout_cache);
+    return UNITY_END();
+}
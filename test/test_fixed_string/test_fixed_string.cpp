@@ -0,0 +1,129 @@
+// Host tests for FixedString: truncation and hashing, and heap allocations
+// per user / lookup / message compared with the String fields IDs and names
+// used before.
+#include <unity.h>
+#include <stdlib.h>
+#include "global_objects.h"
+
+// ----- Allocation counter -----
+static unsigned long allocs = 0;
+
+void* operator new(size_t n) {
+    allocs++;
+    void* p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// User record as it was before IDs and names became FixedStrings
+struct LegacyUser {
+    String ID;
+    String username;
+    String status;
+};
+
+static const int USERS = 48;
+static char ids[USERS][16];
+static LegacyUser legacy[USERS];
+
+static LegacyUser* findLegacy(const String& id) {
+    for (LegacyUser& u : legacy) {
+        if (u.ID == id) return &u;
+    }
+    return nullptr;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ================== BEHAVIOUR ==================
+static void test_truncates_on_utf8_boundary() {
+    // 22 ASCII bytes, then a 2-byte sequence straddling the 23-byte capacity
+    IdString s("abcdefghijklmnopqrstuv\xC3\xA9xyz");
+    TEST_ASSERT_EQUAL(22, s.length());
+    TEST_ASSERT_EQUAL_STRING("abcdefghijklmnopqrstuv", s.c_str());
+    TEST_ASSERT_EQUAL(IdString::hashOf(s.c_str(), s.length()), s.hash());
+
+    NameString n("caf\xC3\xA9");
+    TEST_ASSERT_EQUAL(5, n.length());
+}
+
+static void test_equality_across_capacities() {
+    IdString a("123123");
+    NameString b("123123");
+    IdString c("123124");
+    TEST_ASSERT_TRUE(a == b);
+    TEST_ASSERT_TRUE(a != c);
+    TEST_ASSERT_TRUE(IdString() == IdString(""));
+    TEST_ASSERT_TRUE(a.equals("123123", 6));
+
+    // Narrowing re-hashes the truncated text
+    NameString longName("a name that is longer than ids");
+    IdString narrowed(longName);
+    TEST_ASSERT_EQUAL(23, narrowed.length());
+    TEST_ASSERT_EQUAL(IdString::hashOf(narrowed.c_str(), 23), narrowed.hash());
+}
+
+// ================== ALLOCATIONS ==================
+static void test_fixed_string_operations_never_allocate() {
+    unsigned long before = allocs;
+    IdString a("n1a2b3c4d5e6f7g8");
+    IdString b = a;
+    NameString n(a);
+    b = "other";
+    bool eq = a == n && a != b;
+    TEST_ASSERT_TRUE(eq);
+    TEST_ASSERT_EQUAL(0, allocs - before);
+}
+
+// Creating users and looking them up by ID: the String fields cost
+// allocations for every record and for every lookup key, IdString none
+static void test_user_records_and_lookups_allocate_less() {
+    for (int i = 0; i < USERS; ++i) snprintf(ids[i], sizeof(ids[i]), "user%02d", i);
+
+    unsigned long before = allocs;
+    for (int i = 0; i < USERS; ++i) {
+        legacy[i].ID = ids[i];
+        legacy[i].username = ids[i];
+    }
+    for (int i = 0; i < USERS; ++i) TEST_ASSERT_NOT_NULL(findLegacy(ids[i]));
+    unsigned long legacyAllocs = allocs - before;
+
+    all_users.reserve(USERS);
+    before = allocs;
+    for (int i = 0; i < USERS; ++i) all_users.push_back(createUser(ids[i], ids[i]));
+    for (int i = 0; i < USERS; ++i) TEST_ASSERT_NOT_NULL(findUserById(ids[i]));
+    unsigned long fixedAllocs = allocs - before;
+
+    // ID, name and lookup key per user before; nothing now
+    TEST_ASSERT_EQUAL(3 * USERS, legacyAllocs);
+    TEST_ASSERT_EQUAL(0, fixedAllocs);
+
+    clearUsers();
+}
+
+// A message allocates for its body and timestamp only
+static void test_message_ids_do_not_allocate() {
+    String body("hello"), ts("12:00:00");
+    unsigned long before = allocs;
+    Message* m = createMessage(IdString("123123"), IdString("n1a2b3c4d5e6f7g8"), IdString("user01"), body, ts);
+    TEST_ASSERT_NOT_NULL(m);
+    TEST_ASSERT_EQUAL(2, allocs - before);
+    TEST_ASSERT_TRUE(m->channel_id == IdString("123123"));
+    destroyMessage(m);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_truncates_on_utf8_boundary);
+    RUN_TEST(test_equality_across_capacities);
+    RUN_TEST(test_fixed_string_operations_never_allocate);
+    RUN_TEST(test_user_records_and_lookups_allocate_less);
+    RUN_TEST(test_message_ids_do_not_allocate);
+    return UNITY_END();
+}
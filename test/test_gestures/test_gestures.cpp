@@ -0,0 +1,160 @@
+// Host tests for GestureRecognizer and KineticScroller: recorded sample
+// traces (10 ms apart, as the touch task delivers them) replayed into taps,
+// drags, flings and releases, and fling distance under kinetic decay.
+#include <unity.h>
+#include <math.h>
+#include <vector>
+#include "TouchHandler/Gestures.h"
+
+// ----- Recorded traces -----
+// A light tap with a pixel of jitter
+static const TouchSample TAP[] = {
+    {161, 118, true, 0}, {162, 119, true, 10}, {161, 120, true, 20}, {162, 119, true, 30},
+    {162, 119, false, 40},
+};
+
+// Flick upwards through a chat: fast and still moving when lifted
+static const TouchSample FLICK[] = {
+    {150, 200, true, 0}, {150, 196, true, 10}, {151, 186, true, 20}, {151, 170, true, 30},
+    {152, 150, true, 40}, {152, 128, true, 50}, {153, 106, true, 60}, {153, 85, true, 70},
+    {153, 66, true, 80}, {153, 66, false, 90},
+};
+
+// Slow drag that stops and rests before lifting
+static const TouchSample PARK[] = {
+    {100, 60, true, 0}, {100, 64, true, 10}, {101, 70, true, 20}, {101, 78, true, 30},
+    {102, 86, true, 40}, {102, 92, true, 50}, {102, 95, true, 60}, {102, 95, true, 100},
+    {102, 96, true, 140}, {102, 95, true, 180}, {102, 95, true, 220}, {102, 95, false, 230},
+};
+
+// Press held past TAP_MAX_MS without moving
+static const TouchSample HOLD[] = {
+    {40, 40, true, 0}, {41, 40, true, 100}, {40, 41, true, 200}, {41, 41, true, 300},
+    {40, 40, true, 400}, {40, 40, false, 410},
+};
+
+static std::vector<Gesture> replay(const TouchSample* trace, size_t n) {
+    GestureRecognizer r;
+    std::vector<Gesture> out;
+    for (size_t i = 0; i < n; ++i) {
+        Gesture g = r.feed(trace[i]);
+        if (g.type != GESTURE_NONE) out.push_back(g);
+    }
+    TEST_ASSERT_FALSE(r.pressed());
+    return out;
+}
+
+#define REPLAY(trace) replay(trace, sizeof(trace) / sizeof(trace[0]))
+
+void setUp() {}
+void tearDown() {}
+
+// ================== GestureRecognizer ==================
+static void test_jittery_press_is_a_tap_at_the_press_point() {
+    std::vector<Gesture> g = REPLAY(TAP);
+    TEST_ASSERT_EQUAL(1, g.size());
+    TEST_ASSERT_EQUAL(GESTURE_TAP, g[0].type);
+    TEST_ASSERT_EQUAL(161, g[0].x);
+    TEST_ASSERT_EQUAL(118, g[0].y);
+}
+
+// Drags add up to the whole distance, slop included; the lift flings upwards
+static void test_flick_drags_then_flings() {
+    std::vector<Gesture> g = REPLAY(FLICK);
+    TEST_ASSERT_TRUE(g.size() >= 2);
+
+    int dy = 0;
+    for (size_t i = 0; i + 1 < g.size(); ++i) {
+        TEST_ASSERT_EQUAL(GESTURE_DRAG, g[i].type);
+        dy += g[i].dy;
+    }
+    TEST_ASSERT_EQUAL(66 - 200, dy);
+
+    const Gesture& f = g.back();
+    TEST_ASSERT_EQUAL(GESTURE_FLING, f.type);
+    // About 2 px/ms over the last 80 ms
+    TEST_ASSERT_TRUE(f.vy < -1500 && f.vy > -2500);
+    TEST_ASSERT_TRUE(fabsf(f.vx) < GestureRecognizer::FLING_MIN);
+}
+
+static void test_finger_at_rest_releases_without_fling() {
+    std::vector<Gesture> g = REPLAY(PARK);
+    TEST_ASSERT_EQUAL(GESTURE_RELEASE, g.back().type);
+    TEST_ASSERT_TRUE(fabsf(g.back().vy) < GestureRecognizer::FLING_MIN);
+}
+
+static void test_long_press_is_not_a_tap() {
+    TEST_ASSERT_EQUAL(0, REPLAY(HOLD).size());
+}
+
+// A release without a press, and a new press after a gesture, start clean
+static void test_recognizer_recovers_between_traces() {
+    GestureRecognizer r;
+    TEST_ASSERT_EQUAL(GESTURE_NONE, r.feed({10, 10, false, 0}).type);
+    for (const TouchSample& s : FLICK) r.feed(s);
+
+    Gesture last = {GESTURE_NONE, 0, 0, 0, 0, 0, 0};
+    for (TouchSample s : TAP) {
+        s.t_ms += 1000;
+        Gesture g = r.feed(s);
+        if (g.type != GESTURE_NONE) last = g;
+    }
+    TEST_ASSERT_EQUAL(GESTURE_TAP, last.type);
+}
+
+// ================== KineticScroller ==================
+// At 30 fps a fling travels v * TAU and stops on its own
+static void test_fling_distance_and_stop() {
+    KineticScroller k;
+    k.start(-2000.0f);
+    int total = 0, frames = 0;
+    while (k.active() && frames < 1000) {
+        total += k.step(33);
+        frames++;
+    }
+    TEST_ASSERT_FALSE(k.active());
+    printf("KineticScroller: -2000 px/s -> %d px in %d frames\n", total, frames);
+    float expected = -2000.0f * KineticScroller::TAU_MS / 1000.0f;
+    TEST_ASSERT_TRUE(fabsf(total - expected) < 10);
+    TEST_ASSERT_TRUE(frames < 100);
+}
+
+// Frame rate changes the steps, not the distance
+static void test_distance_independent_of_frame_rate() {
+    int totals[2];
+    const uint32_t dts[2] = {16, 50};
+    for (int i = 0; i < 2; ++i) {
+        KineticScroller k;
+        k.start(1200.0f);
+        totals[i] = 0;
+        while (k.active()) totals[i] += k.step(dts[i]);
+    }
+    TEST_ASSERT_TRUE(abs(totals[0] - totals[1]) <= 2);
+}
+
+static void test_speed_is_clamped_and_slow_flings_ignored() {
+    KineticScroller k;
+    k.start(10.0f);
+    TEST_ASSERT_FALSE(k.active());
+    TEST_ASSERT_EQUAL(0, k.step(33));
+
+    int fast = 0, capped = 0;
+    k.start(50000.0f);
+    while (k.active()) fast += k.step(33);
+    k.start(KineticScroller::MAX_SPEED);
+    while (k.active()) capped += k.step(33);
+    TEST_ASSERT_EQUAL(capped, fast);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_jittery_press_is_a_tap_at_the_press_point);
+    RUN_TEST(test_flick_drags_then_flings);
+    RUN_TEST(test_finger_at_rest_releases_without_fling);
+    RUN_TEST(test_long_press_is_not_a_tap);
+    RUN_TEST(test_recognizer_recovers_between_traces);
+    RUN_TEST(test_fling_distance_and_stop);
+    RUN_TEST(test_distance_independent_of_frame_rate);
+    RUN_TEST(test_speed_is_clamped_and_slow_flings_ignored);
+    return UNITY_END();
+}
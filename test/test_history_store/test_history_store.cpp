@@ -0,0 +1,187 @@
+// Host tests for HistoryStore::append: window bounds for open and unopened
+// channels, records kept on flash when the message pool is exhausted, files
+// compacted while running, and the fall back to RAM only after a failed write.
+#include <unity.h>
+#include <LittleFS.h>
+#include <string>
+#include "HistoryStore/HistoryStore.h"
+#include "SearchIndex/SearchIndex.h"
+
+static Channel* quiet;
+static Channel* busy;
+static Channel* flood;
+static unsigned long next_id = 0;
+
+static bool post(Channel* ch, Message*& resident) {
+    char id[16], body[32];
+    snprintf(id, sizeof(id), "m%lu", next_id);
+    snprintf(body, sizeof(body), "message %lu", next_id);
+    next_id++;
+    return HistoryStore::append(ch, IdString(id), IdString("peer"), String(body), String("12:00:00"), resident);
+}
+
+static void post(Channel* ch, size_t count) {
+    Message* resident;
+    for (size_t i = 0; i < count; ++i) TEST_ASSERT_TRUE(post(ch, resident));
+}
+
+static bool windowAtTail(const Channel* ch) {
+    return ch->history_first + ch->channel_messages.size() == ch->history_count;
+}
+
+// Flash records of a channel, in order
+static std::vector<std::string> stored;
+
+static void collect(Channel*, uint32_t index, const HistoryRecord& r) {
+    TEST_ASSERT_EQUAL(stored.size(), index);
+    stored.push_back(r.text);
+}
+
+// Every resident message sits at its record's index
+static void assertWindowMatchesFlash(Channel* ch) {
+    stored.clear();
+    HistoryStore::scan(ch, 0, collect);
+    TEST_ASSERT_EQUAL(ch->history_count, stored.size());
+    TEST_ASSERT_LESS_OR_EQUAL(ch->history_count, ch->history_first + ch->channel_messages.size());
+    for (size_t i = 0; i < ch->channel_messages.size(); ++i) {
+        TEST_ASSERT_EQUAL_STRING(stored[ch->history_first + i].c_str(),
+                                 ch->channel_messages[i]->message.c_str());
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+// A channel nobody reads keeps RESIDENT messages; the rest stay on flash
+static void test_unopened_window_stays_resident() {
+    post(busy, 50);
+    TEST_ASSERT_EQUAL(50, busy->history_count);
+    TEST_ASSERT_EQUAL(HistoryStore::RESIDENT, busy->channel_messages.size());
+    TEST_ASSERT_TRUE(windowAtTail(busy));
+
+    HistoryRecord r;
+    TEST_ASSERT_TRUE(HistoryStore::readRecord(busy, 0, r));
+    TEST_ASSERT_EQUAL_STRING("message 0", r.text);
+}
+
+// The open channel may grow to MAX_WINDOW; trim() brings it back on leaving
+static void test_open_window_grows_to_max() {
+    HistoryStore::setOpen(quiet);
+    post(quiet, 100);
+    TEST_ASSERT_EQUAL(HistoryStore::MAX_WINDOW, quiet->channel_messages.size());
+    HistoryStore::setOpen(nullptr);
+    HistoryStore::trim(quiet);
+    TEST_ASSERT_EQUAL(HistoryStore::RESIDENT, quiet->channel_messages.size());
+    TEST_ASSERT_TRUE(windowAtTail(quiet));
+}
+
+// With every message slot taken the record still reaches flash
+static void test_exhausted_pool_keeps_record_on_flash() {
+    // Take every free slot; the first post still gets one back from the
+    // busy channel's window (reclaim), the next finds nothing to reclaim
+    std::vector<Message*> hog;
+    Message* resident;
+    do {
+        while (Message* m = createMessage(IdString("0"), IdString("hog"), IdString("hog"), String("x"))) {
+            hog.push_back(m);
+        }
+        TEST_ASSERT_TRUE(post(quiet, resident));
+    } while (resident);
+
+    uint32_t stored = quiet->history_count;
+    TEST_ASSERT_FALSE(windowAtTail(quiet));
+    HistoryRecord r;
+    TEST_ASSERT_TRUE(HistoryStore::readRecord(quiet, stored - 1, r));
+    char expect[32];
+    snprintf(expect, sizeof(expect), "message %lu", next_id - 1);
+    TEST_ASSERT_EQUAL_STRING(expect, r.text);
+
+    for (Message* m : hog) destroyMessage(m);
+    HistoryStore::trim(quiet);
+    TEST_ASSERT_TRUE(windowAtTail(quiet));
+    TEST_ASSERT_EQUAL_STRING(expect, quiet->channel_messages.back()->message.c_str());
+}
+
+// A busy channel's file stays bounded while running, not only at boot, and
+// windows keep pointing at their records
+static void test_busy_file_compacts_while_running() {
+    size_t base = hostFs().used();
+    HistoryStore::beginBatch();
+    post(flood, 3 * HistoryStore::MAX_RECORDS);
+    HistoryStore::endBatch();
+
+    TEST_ASSERT_LESS_OR_EQUAL(HistoryStore::MAX_RECORDS, flood->history_count);
+    TEST_ASSERT_TRUE(flood->history_count > HistoryStore::MAX_RECORDS / 2);
+    TEST_ASSERT_LESS_OR_EQUAL(HistoryStore::MAX_RECORDS * HistoryStore::RECORD_SIZE, hostFs().used() - base);
+    TEST_ASSERT_TRUE(windowAtTail(flood));
+    assertWindowMatchesFlash(flood);
+    char expect[32];
+    snprintf(expect, sizeof(expect), "message %lu", next_id - 1);
+    TEST_ASSERT_EQUAL_STRING(expect, flood->channel_messages.back()->message.c_str());
+
+    // An open window scrolled back past the cut loses the dropped records only
+    HistoryStore::setOpen(flood);
+    HistoryStore::loadAround(flood, 2);
+    TEST_ASSERT_EQUAL(0, flood->history_first);
+    post(flood, HistoryStore::MAX_RECORDS + 1 - flood->history_count);
+    TEST_ASSERT_EQUAL(HistoryStore::MAX_RECORDS / 2 + 1, flood->history_count);
+    assertWindowMatchesFlash(flood);
+
+    // Scrolled back, but inside the part that is kept
+    post(flood, 150);
+    HistoryStore::loadAround(flood, 300);
+    TEST_ASSERT_TRUE(flood->history_first > HistoryStore::MAX_RECORDS / 2);
+    uint32_t first = flood->history_first;
+    std::string front = flood->channel_messages.front()->message.c_str();
+    post(flood, HistoryStore::MAX_RECORDS + 1 - flood->history_count);
+    TEST_ASSERT_EQUAL(first - HistoryStore::MAX_RECORDS / 2, flood->history_first);
+    TEST_ASSERT_EQUAL_STRING(front.c_str(), flood->channel_messages.front()->message.c_str());
+    assertWindowMatchesFlash(flood);
+
+    HistoryStore::setOpen(nullptr);
+    HistoryStore::trim(flood);
+    TEST_ASSERT_TRUE(windowAtTail(flood));
+}
+
+// A short write unmounts: windows become their channels' whole history and
+// later messages live in RAM, still bounded
+static void test_failed_append_falls_back_to_ram() {
+    hostFs().capacity = hostFs().used() + HistoryStore::RECORD_SIZE / 2;
+
+    Message* resident;
+    TEST_ASSERT_TRUE(post(busy, resident));
+    TEST_ASSERT_NOT_NULL(resident);
+    TEST_ASSERT_EQUAL_PTR(resident, busy->channel_messages.back());
+    TEST_ASSERT_TRUE(windowAtTail(busy));
+    TEST_ASSERT_TRUE(windowAtTail(quiet));
+
+    // The partial record is never read back
+    HistoryRecord r;
+    TEST_ASSERT_FALSE(HistoryStore::readRecord(busy, busy->history_first - 1, r));
+
+    size_t used = hostFs().used();
+    post(busy, 40);
+    TEST_ASSERT_EQUAL(used, hostFs().used());
+    TEST_ASSERT_EQUAL(HistoryStore::RESIDENT, busy->channel_messages.size());
+    TEST_ASSERT_TRUE(windowAtTail(busy));
+    hostFs().capacity = SIZE_MAX;
+}
+
+int main() {
+    quiet = createChannel(CHAT_GROUP, NameString("Quiet"), IdString("111111"));
+    busy = createChannel(CHAT_GROUP, NameString("Busy"), IdString("222222"));
+    registerChannel(quiet);
+    flood = createChannel(CHAT_GROUP, NameString("Flood"), IdString("333333"));
+    registerChannel(busy);
+    registerChannel(flood);
+    HistoryStore::begin();
+    SearchIndex::begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_unopened_window_stays_resident);
+    RUN_TEST(test_open_window_grows_to_max);
+    RUN_TEST(test_exhausted_pool_keeps_record_on_flash);
+    RUN_TEST(test_busy_file_compacts_while_running);
+    RUN_TEST(test_failed_append_falls_back_to_ram);
+    return UNITY_END();
+}
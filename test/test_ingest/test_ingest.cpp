@@ -0,0 +1,146 @@
+// Host tests for SerialIngest: a LoRa MCU backlog that overlaps what is
+// already stored, before and after a reboot, adds each message once (one
+// record, one search doc, one unread), and the time to drain 500 queued
+// packets through listen().
+#include <unity.h>
+#include <chrono>
+#include <set>
+#include <string>
+#include "SerialIngest/SerialIngest.h"
+#include "KeypadHandler/KeypadHandler.h"
+#include "TFTHandler/TFTHandler.h"
+#include "HistoryStore/HistoryStore.h"
+#include "SearchIndex/SearchIndex.h"
+
+static TFTHandler display;
+static KeypadHandler pad(&display);
+
+static const char* CHANNEL = "616161";
+
+// Queue packets [first, last) for this channel on the RX line
+static void queue(const char* channel, int first, int last) {
+    char line[96];
+    for (int i = first; i < last; ++i) {
+        snprintf(line, sizeof(line), "%s||b%05d||peer%d||backlog message %d||12:%02d:%02d\n",
+                 channel, i, i % 3, i, (i / 60) % 60, i % 60);
+        Serial.inject(line);
+    }
+}
+
+// Loop passes until the RX buffer is empty; one pass per loop() on the device
+static int drain() {
+    int passes = 0;
+    while (Serial.available()) {
+        SerialIngest::listen();
+        HostClock::advanceMs(1);
+        passes++;
+    }
+    return passes;
+}
+
+static Channel* join(const char* id) {
+    Channel* ch = createChannel(CHAT_GROUP, NameString("Backlog"), IdString(id));
+    TEST_ASSERT_NOT_NULL(ch);
+    registerChannel(ch);
+    return ch;
+}
+
+// Message IDs on flash, each once
+static std::set<std::string> ids;
+static uint32_t repeats;
+
+static void collect(Channel*, uint32_t, const HistoryRecord& r) {
+    if (!ids.insert(r.message_id).second) repeats++;
+}
+
+static void assertStoredOnce(Channel* ch, uint32_t count) {
+    ids.clear();
+    repeats = 0;
+    HistoryStore::scan(ch, 0, collect);
+    TEST_ASSERT_EQUAL(0, repeats);
+    TEST_ASSERT_EQUAL(count, ch->history_count);
+    TEST_ASSERT_EQUAL(count, ids.size());
+}
+
+void setUp() {}
+void tearDown() {}
+
+// The second flush repeats the last 100 of the first, far more than the
+// resident window holds
+static void test_overlapping_backlog() {
+    Channel* ch = findChannelById(IdString(CHANNEL));
+    uint32_t docs = SearchIndex::docsIndexed();
+
+    queue(CHANNEL, 0, 300);
+    drain();
+    queue(CHANNEL, 200, 500);
+    drain();
+
+    assertStoredOnce(ch, 500);
+    TEST_ASSERT_LESS_THAN(500, ch->channel_messages.size());
+    TEST_ASSERT_EQUAL(docs + 500, SearchIndex::docsIndexed());
+    TEST_ASSERT_EQUAL(500, ch->unread_count);
+}
+
+// After a reboot only flash remembers: the hashes are rebuilt from it and
+// the whole backlog is recognised
+static void test_replay_after_reboot() {
+    clearChannels();
+    Channel* ch = join(CHANNEL);
+    HistoryStore::begin();
+    TEST_ASSERT_EQUAL(500, ch->history_count);
+    TEST_ASSERT_EQUAL(500, ch->key_count);
+    uint32_t docs = SearchIndex::docsIndexed();
+
+    queue(CHANNEL, 0, 500);
+    drain();
+
+    assertStoredOnce(ch, 500);
+    TEST_ASSERT_EQUAL(docs, SearchIndex::docsIndexed());
+    TEST_ASSERT_EQUAL(0, ch->unread_count);
+
+    // New messages after the replay still get in
+    queue(CHANNEL, 500, 510);
+    drain();
+    assertStoredOnce(ch, 510);
+    TEST_ASSERT_EQUAL(10, ch->unread_count);
+}
+
+// 500 packets already queued, drained the way loop() drains them. The
+// UART buffer holds ~60 of them on the device; here they are all waiting
+static void test_drain_500_queued() {
+    Channel* ch = join("626262");
+    queue("626262", 0, 500);
+
+    auto start = std::chrono::steady_clock::now();
+    int passes = drain();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    printf("Ingest: 500 queued packets in %.1f ms over %d listen() passes, %.1f us/packet\n",
+           ms, passes, ms * 1000 / 500);
+    assertStoredOnce(ch, 500);
+
+    // Replayed in full, every packet is a duplicate
+    queue("626262", 0, 500);
+    start = std::chrono::steady_clock::now();
+    drain();
+    ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("Ingest: 500 duplicate packets in %.1f ms, %.1f us/packet\n", ms, ms * 1000 / 500);
+    assertStoredOnce(ch, 500);
+}
+
+int main() {
+    local_user = createUser(IdString("me"), NameString("Me"));
+    all_users.push_back(local_user);
+    join(CHANNEL);
+    HistoryStore::begin();
+    SearchIndex::begin();
+    pad.begin();
+    SerialIngest::begin(&display, &pad);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_overlapping_backlog);
+    RUN_TEST(test_replay_after_reboot);
+    RUN_TEST(test_drain_500_queued);
+    return UNITY_END();
+}
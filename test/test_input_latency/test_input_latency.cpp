@@ -0,0 +1,125 @@
+// Host tests for InputLatency: scripted keys replayed through the real
+// KeypadHandler and TFTHandler against the timing TFT shim, with the
+// handle / queue / draw / key-to-pixel histograms checked and printed.
+#include <unity.h>
+#include "KeypadHandler/KeypadHandler.h"
+#include "TFTHandler/TFTHandler.h"
+#include "InputLatency/InputLatency.h"
+
+static TFTHandler display;
+static KeypadHandler pad(&display);
+
+static const unsigned long KEY_GAP_MS = 60;  // KeypadHandler::REPLAY_GAP_MS
+
+// loop() passes every millisecond until the replay has run out and its last
+// frame is on the panel
+static void runReplay(const char* script) {
+    KeypadHandler::replay(script);
+    unsigned long until = millis() + (strlen(script) + 2) * KEY_GAP_MS;
+    while (millis() < until || display.renderPending()) {
+        HostClock::advanceMs(1);
+        pad.update();
+        display.render();
+    }
+}
+
+// Histogram as the DIAG dump prints it, one bucket per power of two
+static void print(byte stage) {
+    const PerfStat& s = InputLatency::stat(stage);
+    printf("%-9s n=%lu avg=%lu p90<=%lu max=%lu us |", InputLatency::stageName(stage),
+           (unsigned long) s.count, (unsigned long) s.avg_us(),
+           (unsigned long) s.percentile_us(90), (unsigned long) s.max_us);
+    for (byte i = 0; i < PERF_BUCKETS; ++i) printf(" %lu", (unsigned long) s.buckets[i]);
+    printf("\n");
+}
+
+static void printAll(const char* title) {
+    printf("%s\n", title);
+    for (byte s = 0; s < LAT_STAGES; ++s) print(s);
+}
+
+// Every sample splits exactly into its stages
+static void assertStagesAddUp(uint32_t count) {
+    for (byte s = 0; s < LAT_STAGES; ++s) TEST_ASSERT_EQUAL(count, InputLatency::stat(s).count);
+    uint64_t parts = InputLatency::stat(LAT_HANDLE).total_us + InputLatency::stat(LAT_QUEUE).total_us +
+                     InputLatency::stat(LAT_DRAW).total_us;
+    TEST_ASSERT_TRUE(parts == InputLatency::stat(LAT_TOTAL).total_us);
+}
+
+static void home() {
+    runReplay("FFFF");
+    TEST_ASSERT_EQUAL(SCREEN_START, display.get_currentScreen());
+}
+
+void setUp() {
+    home();
+    InputLatency::reset();
+}
+
+void tearDown() {}
+
+// Typed characters wait at most the draft interval and draw only the draft bar
+static void test_typing_in_chat() {
+    Channel* ch = createChannel(CHAT_GROUP, NameString("Lat"), IdString("515151"));
+    TEST_ASSERT_NOT_NULL(ch);
+    registerChannel(ch);
+    char open[3] = {'1', (char) ('1' + all_channels.size() - 1), 0};
+    runReplay(open);
+    TEST_ASSERT_EQUAL(SCREEN_CHAT, display.get_currentScreen());
+
+    InputLatency::reset();
+    const char* script = "adgjmpsvy";
+    runReplay(script);
+    printAll("Typing (draft bar):");
+    TEST_ASSERT_EQUAL_STRING(script, text_draft.c_str());
+
+    // Keys are far enough apart that none coalesce
+    assertStagesAddUp(strlen(script));
+    const PerfStat& queue = InputLatency::stat(LAT_QUEUE);
+    const PerfStat& draw = InputLatency::stat(LAT_DRAW);
+    TEST_ASSERT_LESS_OR_EQUAL(TFTHandler::DRAFT_INTERVAL_MS * 1000, queue.max_us);
+    TEST_ASSERT_TRUE(draw.max_us < TFTHandler::FRAME_INTERVAL_MS * 1000 / 2);
+    TEST_ASSERT_TRUE(InputLatency::stat(LAT_TOTAL).max_us < 20000);
+}
+
+// Screen changes repaint the whole panel, so the draw stage dominates. Each
+// key is replayed on its own: a full repaint takes longer than the replay
+// gap, and back-to-back keys would coalesce into one sample
+static void test_menu_navigation() {
+    const char* script = "1F2F23FF1F";
+    for (const char* k = script; *k; ++k) {
+        char one[2] = {*k, 0};
+        runReplay(one);
+    }
+    printAll("Navigation (full repaints):");
+
+    assertStagesAddUp(strlen(script));
+    const PerfStat& queue = InputLatency::stat(LAT_QUEUE);
+    const PerfStat& draw = InputLatency::stat(LAT_DRAW);
+    TEST_ASSERT_TRUE(draw.avg_us() > queue.avg_us());
+    // The frame governor holds a key back by at most the last frame's cost
+    TEST_ASSERT_LESS_OR_EQUAL(draw.max_us, queue.max_us);
+    const PerfStat& total = InputLatency::stat(LAT_TOTAL);
+    TEST_ASSERT_TRUE(total.max_us < 2 * draw.max_us);
+
+    // Repaints overflow the histogram's top bucket; p90 must not under-report
+    TEST_ASSERT_GREATER_OR_EQUAL(65536, total.max_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(65536, total.percentile_us(90));
+    TEST_ASSERT_LESS_OR_EQUAL(total.max_us, total.percentile_us(90));
+}
+
+// Keys with nothing to repaint are not sampled
+static void test_keys_without_damage_are_not_sampled() {
+    runReplay("9");  // No such menu entry
+    TEST_ASSERT_EQUAL(SCREEN_START, display.get_currentScreen());
+    TEST_ASSERT_EQUAL(0, InputLatency::stat(LAT_TOTAL).count);
+}
+
+int main() {
+    pad.begin();
+    UNITY_BEGIN();
+    RUN_TEST(test_typing_in_chat);
+    RUN_TEST(test_menu_navigation);
+    RUN_TEST(test_keys_without_damage_are_not_sampled);
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+// Host tests for LinkStats: P2Quantile estimates against exact quantiles of
+// a seeded latency stream, and LinkAggregate's EWMA, extremes and delivery
+// ratio as LAT reports arrive.
+#include <unity.h>
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "LinkStats/LinkStats.h"
+
+// Long-tailed latencies as LoRa hops produce them: a floor plus an
+// exponential tail, in milliseconds
+static std::vector<float> latencyStream(uint32_t seed, size_t n) {
+    std::mt19937 gen(seed);
+    std::exponential_distribution<float> tail(1.0f / 400.0f);
+    std::vector<float> out;
+    for (size_t i = 0; i < n; ++i) out.push_back(150.0f + tail(gen));
+    return out;
+}
+
+// Fraction of the samples at or below v
+static float rankOf(const std::vector<float>& sorted, float v) {
+    return (float) (std::upper_bound(sorted.begin(), sorted.end(), v) - sorted.begin()) / sorted.size();
+}
+
+void setUp() {
+    LinkStats::reset();
+}
+
+void tearDown() {}
+
+// ================== P2Quantile ==================
+// Within a few percent of rank and value of the exact quantile, for several seeds
+static void test_quantiles_track_exact_values() {
+    const float targets[2] = {0.5f, 0.9f};
+    for (uint32_t seed = 1; seed <= 5; ++seed) {
+        std::vector<float> samples = latencyStream(seed, 5000);
+        P2Quantile est[2];
+        for (int t = 0; t < 2; ++t) est[t].init(targets[t]);
+        for (float x : samples) {
+            for (int t = 0; t < 2; ++t) est[t].add(x);
+        }
+
+        std::vector<float> sorted = samples;
+        std::sort(sorted.begin(), sorted.end());
+        for (int t = 0; t < 2; ++t) {
+            float exact = sorted[(size_t) (targets[t] * (sorted.size() - 1))];
+            float got = est[t].value();
+            printf("P2Quantile seed %u p%.0f: exact=%.1f estimate=%.1f\n",
+                   (unsigned) seed, targets[t] * 100, exact, got);
+            TEST_ASSERT_EQUAL(samples.size(), est[t].count);
+            TEST_ASSERT_TRUE(fabsf(rankOf(sorted, got) - targets[t]) < 0.02f);
+            TEST_ASSERT_TRUE(fabsf(got - exact) < 0.05f * exact);
+        }
+    }
+}
+
+// Fewer than five samples: the exact order statistic
+static void test_quantile_bootstrap() {
+    P2Quantile q;
+    q.init(0.5f);
+    TEST_ASSERT_EQUAL_FLOAT(0, q.value());
+    q.add(300);
+    TEST_ASSERT_EQUAL_FLOAT(300, q.value());
+    q.add(100);
+    q.add(200);
+    TEST_ASSERT_EQUAL_FLOAT(200, q.value());
+
+    q.init(0.9f);
+    const float xs[4] = {40, 10, 30, 20};
+    for (float x : xs) q.add(x);
+    TEST_ASSERT_EQUAL_FLOAT(40, q.value());
+}
+
+// ================== LinkAggregate ==================
+static void test_report_ewma_and_extremes() {
+    LinkAggregate a;
+    a.reset(IdString("sender01"));
+    const int rssi[6] = {-90, -80, -110, -95, -70, -100};
+    const int snr[6] = {5, 8, -3, 2, 11, 0};
+    const unsigned long lat[6] = {400, 250, 1800, 600, 180, 900};
+
+    double e_rssi = rssi[0], e_snr = snr[0], e_lat = lat[0];
+    for (int i = 0; i < 6; ++i) {
+        a.addReport(rssi[i], snr[i], lat[i]);
+        if (i) {
+            e_rssi += LinkStats::EWMA_ALPHA * (rssi[i] - e_rssi);
+            e_snr  += LinkStats::EWMA_ALPHA * (snr[i] - e_snr);
+            e_lat  += LinkStats::EWMA_ALPHA * ((double) lat[i] - e_lat);
+        }
+        TEST_ASSERT_TRUE(fabs(a.ewma_rssi - e_rssi) < 1e-3);
+        TEST_ASSERT_TRUE(fabs(a.ewma_snr - e_snr) < 1e-3);
+        TEST_ASSERT_TRUE(fabs(a.ewma_latency - e_lat) < 1e-2);
+    }
+
+    TEST_ASSERT_EQUAL(6, a.reports);
+    TEST_ASSERT_EQUAL(-110, a.min_rssi);
+    TEST_ASSERT_EQUAL(-70, a.max_rssi);
+    TEST_ASSERT_EQUAL(-3, a.min_snr);
+    TEST_ASSERT_EQUAL(11, a.max_snr);
+    TEST_ASSERT_EQUAL(180, a.min_latency);
+    TEST_ASSERT_EQUAL(1800, a.max_latency);
+
+    // The sparkline holds the RSSI samples in arrival order
+    for (int i = 0; i < 6; ++i) TEST_ASSERT_EQUAL(rssi[i], a.spark[i]);
+    TEST_ASSERT_EQUAL(6, a.spark_head);
+}
+
+// The first report seeds the averages instead of decaying from zero
+static void test_first_report_seeds_ewma() {
+    LinkAggregate a;
+    a.reset(IdString("sender02"));
+    a.addReport(-120, -7, 2500);
+    TEST_ASSERT_EQUAL_FLOAT(-120, a.ewma_rssi);
+    TEST_ASSERT_EQUAL_FLOAT(-7, a.ewma_snr);
+    TEST_ASSERT_EQUAL_FLOAT(2500, a.ewma_latency);
+    TEST_ASSERT_EQUAL(a.min_latency, a.max_latency);
+}
+
+// Messages count on both tables; reports are matched per sender and channel
+static void test_delivery_ratio() {
+    IdString chan("424242"), alice("alice"), bob("bob");
+    for (int i = 0; i < 10; ++i) LinkStats::onMessage(chan, alice);
+    for (int i = 0; i < 4; ++i) LinkStats::onMessage(chan, bob);
+    for (int i = 0; i < 7; ++i) LinkStats::onLatencyReport(chan, alice, -90, 5, 300);
+    LinkStats::onLatencyReport(chan, bob, -100, 1, 800);
+
+    const LinkAggregate* a = nullptr;
+    const LinkAggregate* b = nullptr;
+    for (byte i = 0; i < LinkStats::MAX_SENDERS; ++i) {
+        const LinkAggregate& e = LinkStats::sender(i);
+        if (!strcmp(e.id, "alice")) a = &e;
+        if (!strcmp(e.id, "bob")) b = &e;
+    }
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_FLOAT(0.7f, a->deliveryRatio());
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, b->deliveryRatio());
+
+    const LinkAggregate& c = LinkStats::channel(0);
+    TEST_ASSERT_EQUAL_STRING("424242", c.id);
+    TEST_ASSERT_EQUAL(14, c.messages);
+    TEST_ASSERT_EQUAL_FLOAT(8.0f / 14, c.deliveryRatio());
+
+    LinkAggregate empty;
+    empty.reset(IdString("nobody"));
+    TEST_ASSERT_EQUAL_FLOAT(0, empty.deliveryRatio());
+}
+
+// IDs longer than the display field are cut, not overrun
+static void test_long_id_is_truncated() {
+    LinkAggregate a;
+    a.reset(IdString("0123456789abcdefghij"));
+    TEST_ASSERT_EQUAL_STRING("0123456789abcde", a.id);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_quantiles_track_exact_values);
+    RUN_TEST(test_quantile_bootstrap);
+    RUN_TEST(test_report_ewma_and_extremes);
+    RUN_TEST(test_first_report_seeds_ewma);
+    RUN_TEST(test_delivery_ratio);
+    RUN_TEST(test_long_id_is_truncated);
+    return UNITY_END();
+}
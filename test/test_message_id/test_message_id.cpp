@@ -0,0 +1,121 @@
+// Host tests for MessageId: uniqueness across simulated nodes and bursts,
+// monotonic IDs when the clock steps back, the base32 text form, and the
+// cost of generating and formatting an ID.
+#include <unity.h>
+#include <stdlib.h>
+#include <chrono>
+#include <set>
+#include "MessageId/MessageId.h"
+
+static const uint32_t EPOCH = 1760000000;  // October 2025
+
+// ----- Allocation counter -----
+static unsigned long allocs = 0;
+
+void* operator new(size_t n) {
+    allocs++;
+    void* p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+void setUp() {}
+void tearDown() {}
+
+// Sixteen nodes from one vendor take turns sending, 20 ms apart; each
+// switch re-seeds the generator with that node's MAC and the shared clock
+static void test_unique_across_nodes() {
+    const int NODES = 16, MESSAGES = 2000;
+    std::set<uint64_t> seen;
+    std::set<uint16_t> nodes;
+
+    for (int m = 0; m < MESSAGES; ++m) {
+        for (int n = 0; n < NODES; ++n) {
+            ESP.mac = 0x24A160000000ULL | (uint64_t) (0x10000 * n + 0x0C0FFE);
+            MessageId::begin(EPOCH + millis() / 1000);
+            uint64_t id = MessageId::next();
+            TEST_ASSERT_TRUE_MESSAGE(seen.insert(id).second, "duplicate ID");
+            nodes.insert(MessageId::nodeOf(id));
+            HostClock::advanceMs(20);
+        }
+    }
+    TEST_ASSERT_EQUAL(NODES, nodes.size());
+    TEST_ASSERT_EQUAL(NODES * MESSAGES, seen.size());
+}
+
+// More than 65536 IDs in one second borrow the next second; stepping the
+// clock back never repeats or reorders IDs
+static void test_monotonic_through_bursts_and_clock_steps() {
+    MessageId::begin(EPOCH + 100000);
+    uint64_t last = MessageId::next();
+    for (long i = 0; i < 70000; ++i) {
+        uint64_t id = MessageId::next();
+        TEST_ASSERT_TRUE(id > last);
+        last = id;
+    }
+    TEST_ASSERT_TRUE(MessageId::epochOf(last) > EPOCH + 100000);
+
+    MessageId::begin(EPOCH);  // RTC set an hour and more back
+    for (int i = 0; i < 100; ++i) {
+        uint64_t id = MessageId::next();
+        TEST_ASSERT_TRUE(id > last);
+        last = id;
+        HostClock::advanceMs(10);
+    }
+}
+
+static void test_text_round_trip_and_legacy_keys() {
+    MessageId::begin(EPOCH);
+    char text[MessageId::TEXT_LEN + 1];
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t id = MessageId::next();
+        MessageId::format(id, text);
+        uint64_t back;
+        TEST_ASSERT_TRUE(MessageId::parse(text, strlen(text), back));
+        TEST_ASSERT_TRUE(back == id);
+        TEST_ASSERT_TRUE(MessageId::keyOf(IdString(text)) == id);
+    }
+
+    // Crockford aliases; too long, too short or out of range is not an ID
+    uint64_t a, b;
+    TEST_ASSERT_TRUE(MessageId::parse("0000000000001", 13, a));
+    TEST_ASSERT_TRUE(MessageId::parse("oooooooooooOl", 13, b));
+    TEST_ASSERT_TRUE(a == b);
+    TEST_ASSERT_FALSE(MessageId::parse("000000000000U", 13, a));
+    TEST_ASSERT_FALSE(MessageId::parse("G000000000000", 13, a));
+    TEST_ASSERT_FALSE(MessageId::parse("000000000001", 12, a));
+
+    // Legacy IDs hash to distinct keys
+    TEST_ASSERT_TRUE(MessageId::keyOf(IdString("msg_1")) != MessageId::keyOf(IdString("msg_2")));
+}
+
+// Generating and formatting never allocates and stays well under a microsecond
+static void test_generation_speed() {
+    const long COUNT = 1000000;
+    char text[MessageId::TEXT_LEN + 1];
+    uint64_t sum = 0;
+    unsigned long before = allocs;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < COUNT; ++i) {
+        uint64_t id = MessageId::next();
+        MessageId::format(id, text);
+        sum += (uint8_t) text[12];
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / COUNT;
+
+    printf("MessageId next+format: %.1f ns/ID (checksum %llu)\n", ns, (unsigned long long) sum);
+    TEST_ASSERT_EQUAL(0, allocs - before);
+    TEST_ASSERT_TRUE(ns < 1000);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_unique_across_nodes);
+    RUN_TEST(test_monotonic_through_bursts_and_clock_steps);
+    RUN_TEST(test_text_round_trip_and_legacy_keys);
+    RUN_TEST(test_generation_speed);
+    return UNITY_END();
+}
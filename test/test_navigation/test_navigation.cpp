@@ -0,0 +1,141 @@
+// Host tests for screen navigation: key scripts through the real
+// KeypadHandler transition table, and the frames and panel traffic
+// TFTHandler::render() produces for them.
+#include <unity.h>
+#include "KeypadHandler/KeypadHandler.h"
+#include "TFTHandler/TFTHandler.h"
+
+static TFTHandler display;
+static KeypadHandler pad(&display);
+
+// loop() passes every 5 ms until the pending frame is on the panel; a
+// costly frame stretches the interval before the next one (frame governor)
+static void frame() {
+    for (int pass = 0; pass < 100 && display.renderPending(); ++pass) {
+        HostClock::advanceMs(5);
+        pad.update();
+        display.render();
+    }
+}
+
+// A key as the keypad scan reports it: press, then release
+static void key(char k) {
+    pad.ltrpad.fire(k, PRESSED);
+    pad.ltrpad.fire(k, RELEASED);
+}
+
+static void keys(const char* script) {
+    for (const char* k = script; *k; ++k) {
+        key(*k);
+        frame();
+    }
+}
+
+static void home() {
+    while (display.get_currentScreen() != SCREEN_START) {
+        key('F');
+        frame();
+    }
+}
+
+void setUp() {
+    home();
+    display.tft.resetStats();
+}
+
+void tearDown() {}
+
+static void test_menu_script_visits_expected_screens() {
+    struct Step { char key; byte screen; };
+    const Step script[] = {
+        { '1', SCREEN_MESSAGES },    { 'F', SCREEN_START },
+        { '2', SCREEN_SETTINGS },    { '3', SCREEN_DIAGNOSTICS },
+        { '1', SCREEN_LINK_STATS },  { 'F', SCREEN_DIAGNOSTICS },
+        { 'F', SCREEN_SETTINGS },    { '1', SCREEN_EDIT_USER },
+        { 'F', SCREEN_SETTINGS },    { 'F', SCREEN_START },
+        { '1', SCREEN_MESSAGES },    { 'G', SCREEN_DISCOVER },
+        { 'F', SCREEN_MESSAGES },    { 'B', SCREEN_SEARCH },
+        { 'F', SCREEN_MESSAGES },    { 'A', SCREEN_CREATE },
+        { 'F', SCREEN_MESSAGES },    { '9', SCREEN_MESSAGES },  // No channel 9
+        { 'F', SCREEN_START },
+    };
+    for (const Step& s : script) {
+        key(s.key);
+        frame();
+        TEST_ASSERT_EQUAL(s.screen, display.get_currentScreen());
+    }
+}
+
+// Every transition costs exactly one frame, and layouts switch by damage
+// tracking instead of clearing the panel
+static void test_each_transition_draws_one_frame() {
+    const char* script = "23F1FF1GFBF";
+    unsigned long before = display.framesRendered();
+    keys(script);
+    TEST_ASSERT_EQUAL(strlen(script), display.framesRendered() - before);
+    TEST_ASSERT_EQUAL(0, display.tft.stats.clears);
+}
+
+// Keys arriving between frames coalesce into one repaint of the final screen
+static void test_keys_between_frames_coalesce() {
+    unsigned long requested = display.framesRequested();
+    unsigned long rendered = display.framesRendered();
+    key('2');
+    key('3');
+    key('1');
+    frame();
+    TEST_ASSERT_EQUAL(SCREEN_LINK_STATS, display.get_currentScreen());
+    TEST_ASSERT_EQUAL(3, display.framesRequested() - requested);
+    TEST_ASSERT_EQUAL(1, display.framesRendered() - rendered);
+}
+
+// Invalidations inside the frame interval wait for the next frame
+static void test_frame_budget_defers_repaints() {
+    frame();
+    display.invalidate(TFTHandler::DIRTY_BODY);
+    display.render();
+    unsigned long rendered = display.framesRendered();
+
+    display.invalidate(TFTHandler::DIRTY_BODY);
+    display.render();
+    TEST_ASSERT_TRUE(display.renderPending());
+    TEST_ASSERT_EQUAL(rendered, display.framesRendered());
+
+    frame();
+    TEST_ASSERT_FALSE(display.renderPending());
+    TEST_ASSERT_EQUAL(rendered + 1, display.framesRendered());
+}
+
+// Typing in a chat repaints only the draft bar
+static void test_chat_typing_repaints_draft_only() {
+    Channel* ch = createChannel(CHAT_GROUP, NameString("Nav"), IdString("424242"));
+    TEST_ASSERT_NOT_NULL(ch);
+    registerChannel(ch);
+
+    keys("1");
+    key('1' + (char) (all_channels.size() - 1));
+    frame();
+    TEST_ASSERT_EQUAL(SCREEN_CHAT, display.get_currentScreen());
+
+    display.tft.resetStats();
+    display.tft.recording = true;
+    unsigned long rendered = display.framesRendered();
+    keys("adg");
+    display.tft.recording = false;
+
+    TEST_ASSERT_EQUAL(3, display.framesRendered() - rendered);
+    TEST_ASSERT_EQUAL_STRING("adg", text_draft.c_str());
+    TEST_ASSERT_EQUAL(0, display.tft.stats.clears);
+    for (const TftOp& op : display.tft.ops) TEST_ASSERT_GREATER_OR_EQUAL(210, op.y);
+}
+
+int main() {
+    pad.begin();
+    UNITY_BEGIN();
+    RUN_TEST(test_menu_script_visits_expected_screens);
+    RUN_TEST(test_each_transition_draws_one_frame);
+    RUN_TEST(test_keys_between_frames_coalesce);
+    RUN_TEST(test_frame_budget_defers_repaints);
+    RUN_TEST(test_chat_typing_repaints_draft_only);
+    return UNITY_END();
+}
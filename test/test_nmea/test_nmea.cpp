@@ -0,0 +1,178 @@
+// Host tests for NmeaParser: a recorded NEO-6M log decoded into a fix and
+// UTC epoch, corrupted and runaway sentences rejected without touching the
+// fix, and parser throughput over the log.
+#include <unity.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include "GpsHandler/Nmea.h"
+
+// One second of NEO-6M output with a fix, then one after losing it
+static const char LOG[] =
+    "$GPRMC,092750.00,A,4807.03812,N,01131.00024,E,0.214,84.40,150925,,,A*55\r\n"
+    "$GPVTG,84.40,T,,M,0.214,N,0.396,K,A*0E\r\n"
+    "$GPGGA,092750.00,4807.03812,N,01131.00024,E,1,08,1.03,545.4,M,46.9,M,,*53\r\n"
+    "$GPGSA,A,3,10,07,05,02,29,04,08,13,,,,,1.72,1.03,1.38*0A\r\n"
+    "$GPGSV,3,1,11,10,63,137,17,07,61,098,15,05,59,290,20,08,54,157,30*70\r\n"
+    "$GPGSV,3,2,11,02,39,223,19,13,28,070,17,26,23,252,,04,14,186,14*79\r\n"
+    "$GPGSV,3,3,11,29,09,301,24,16,09,020,,36,,,*76\r\n"
+    "$GPGLL,4807.03812,N,01131.00024,E,092750.00,A,A*67\r\n"
+    "$GPRMC,092751.00,V,,,,,,,150925,,,N*7F\r\n"
+    "$GPGGA,092751.00,,,,,0,00,99.99,,,,,,*6E\r\n";
+
+static const uint32_t EPOCH = 1757928470;  // 2025-09-15 09:27:50 UTC
+
+// Feeds text and counts what completed
+static void feed(NmeaParser& p, const char* text, int& rmc, int& gga) {
+    for (const char* c = text; *c; ++c) {
+        uint8_t t = p.feed(*c);
+        if (t == NMEA_RMC) rmc++;
+        if (t == NMEA_GGA) gga++;
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_recorded_log_builds_fix() {
+    NmeaParser p;
+    int rmc = 0, gga = 0;
+    // Up to the first GGA only
+    const char* lost = strstr(LOG, "$GPRMC,092751");
+    for (const char* c = LOG; c < lost; ++c) {
+        uint8_t t = p.feed(*c);
+        if (t == NMEA_RMC) rmc++;
+        if (t == NMEA_GGA) gga++;
+    }
+    TEST_ASSERT_EQUAL(1, rmc);
+    TEST_ASSERT_EQUAL(1, gga);
+    TEST_ASSERT_EQUAL(2, p.sentences());
+
+    const GpsFix& f = p.fix();
+    TEST_ASSERT_TRUE(f.valid);
+    TEST_ASSERT_EQUAL(481173020, f.lat_e7);
+    TEST_ASSERT_EQUAL(115166706, f.lon_e7);
+    TEST_ASSERT_EQUAL(5454, f.alt_dm);
+    TEST_ASSERT_EQUAL(10, f.speed_cms);
+    TEST_ASSERT_EQUAL(8440, f.course_cdeg);
+    TEST_ASSERT_EQUAL(10, f.hdop_x10);
+    TEST_ASSERT_EQUAL(1, f.quality);
+    TEST_ASSERT_EQUAL(8, f.satellites);
+    TEST_ASSERT_EQUAL(EPOCH, f.epoch);
+    TEST_ASSERT_EQUAL(0, p.checksumErrors());
+    TEST_ASSERT_EQUAL(0, p.dropped());
+}
+
+// Losing the fix keeps the last position; the time is no longer trusted
+static void test_lost_fix_keeps_last_position() {
+    NmeaParser p;
+    int rmc = 0, gga = 0;
+    feed(p, LOG, rmc, gga);
+    TEST_ASSERT_EQUAL(2, rmc);
+    TEST_ASSERT_EQUAL(2, gga);
+
+    const GpsFix& f = p.fix();
+    TEST_ASSERT_FALSE(f.valid);
+    TEST_ASSERT_EQUAL(0, f.quality);
+    TEST_ASSERT_EQUAL(0, f.satellites);
+    TEST_ASSERT_EQUAL(481173020, f.lat_e7);
+    TEST_ASSERT_EQUAL(0, f.epoch);
+}
+
+// Each RMC stands alone: an empty status is not a fix, and a valid fix with
+// a garbled date carries no time, whatever the sentence before said
+static void test_rmc_does_not_inherit_status_or_time() {
+    NmeaParser p;
+    int rmc = 0, gga = 0;
+    const char* lost = strstr(LOG, "$GPRMC,092751");
+    std::string good(LOG, lost - LOG);
+    feed(p, good.c_str(), rmc, gga);
+    TEST_ASSERT_TRUE(p.fix().valid);
+    TEST_ASSERT_EQUAL(EPOCH, p.fix().epoch);
+
+    feed(p, "$GPRMC,092751.00,,,,,,,,150925,,,N*29\r\n", rmc, gga);
+    TEST_ASSERT_EQUAL(2, rmc);
+    TEST_ASSERT_FALSE(p.fix().valid);
+    TEST_ASSERT_EQUAL(0, p.fix().epoch);
+
+    feed(p, good.c_str(), rmc, gga);
+    TEST_ASSERT_EQUAL(EPOCH, p.fix().epoch);
+    feed(p, "$GPRMC,092752.00,A,4807.03812,N,01131.00024,E,0.214,84.40,320925,,,A*52\r\n", rmc, gga);
+    TEST_ASSERT_EQUAL(4, rmc);
+    TEST_ASSERT_TRUE(p.fix().valid);
+    TEST_ASSERT_EQUAL(0, p.fix().epoch);
+    TEST_ASSERT_EQUAL(0, p.checksumErrors());
+}
+
+// Southern / western hemispheres from a GN talker, and the calendar
+static void test_hemispheres_and_calendar() {
+    NmeaParser p;
+    int rmc = 0, gga = 0;
+    feed(p, "$GNRMC,235959.00,A,3351.82100,S,15112.71200,W,12.5,270.0,311299,,,A*71\r\n", rmc, gga);
+    TEST_ASSERT_EQUAL(1, rmc);
+    TEST_ASSERT_EQUAL(-338636833, p.fix().lat_e7);
+    TEST_ASSERT_EQUAL(-1512118666, p.fix().lon_e7);
+    TEST_ASSERT_EQUAL(4102444799u, p.fix().epoch);  // 2099-12-31 23:59:59
+
+    TEST_ASSERT_EQUAL(0, NmeaParser::daysFromCivil(1970, 1, 1));
+    TEST_ASSERT_EQUAL(11016, NmeaParser::daysFromCivil(2000, 2, 29));
+}
+
+// A flipped byte fails the checksum and leaves no half-applied fields behind
+static void test_corrupted_sentences_leave_fix_untouched() {
+    NmeaParser p;
+    int rmc = 0, gga = 0;
+    feed(p, LOG, rmc, gga);
+    GpsFix before = p.fix();
+
+    feed(p, "$GPGGA,092752.00,4807.03812,N,01131.00024,E,1,09,1.03,545.4,M,46.9,M,,*53\r\n", rmc, gga);
+    TEST_ASSERT_EQUAL(1, p.checksumErrors());
+    TEST_ASSERT_EQUAL(0, memcmp(&before, &p.fix(), sizeof(GpsFix)));
+
+    // Cut short by a new sentence, no checksum, a bad hex digit, a runaway line
+    feed(p, "$GPRMC,0927$GPGGA,1,2,3\r\n$GPGGA*Z3\r\n", rmc, gga);
+    char runaway[128];
+    memset(runaway, '1', sizeof(runaway));
+    runaway[0] = '$';
+    memcpy(runaway + 1, "GPGGA,", 6);
+    runaway[sizeof(runaway) - 1] = 0;
+    feed(p, runaway, rmc, gga);
+    TEST_ASSERT_EQUAL(4, p.dropped());
+    TEST_ASSERT_EQUAL(4, p.sentences());
+
+    // The parser resynchronises on the next sentence
+    feed(p, LOG, rmc, gga);
+    TEST_ASSERT_EQUAL(8, p.sentences());
+}
+
+// Replays the log; the NEO-6M's 9600 baud is under 1 KB/s
+static void test_throughput() {
+    const int ROUNDS = 50000;
+    const size_t len = sizeof(LOG) - 1;
+    NmeaParser p;
+    uint32_t completed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t i = 0; i < len; ++i) completed += p.feed(LOG[i]) != NMEA_NONE;
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double bytes = (double) len * ROUNDS;
+    printf("NmeaParser: %.1f MB/s, %.0f ns/byte, %.2f M sentences/s\n",
+           bytes / s / 1e6, s * 1e9 / bytes, completed / s / 1e6);
+    TEST_ASSERT_EQUAL(4u * ROUNDS, completed);
+    TEST_ASSERT_EQUAL(0, p.checksumErrors() + p.dropped());
+    TEST_ASSERT_TRUE(s * 1e9 / bytes < 100);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_recorded_log_builds_fix);
+    RUN_TEST(test_lost_fix_keeps_last_position);
+    RUN_TEST(test_rmc_does_not_inherit_status_or_time);
+    RUN_TEST(test_hemispheres_and_calendar);
+    RUN_TEST(test_corrupted_sentences_leave_fix_untouched);
+    RUN_TEST(test_throughput);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+// Host tests for ObjectPool: handles, exhaustion and bad frees, and 1,000
+// preference resets with pool counts and live heap bytes staying flat.
+#include <unity.h>
+#include <stdlib.h>
+#include "PreferencesHandler.h"
+
+// ----- Live heap bytes -----
+// Every allocation carries its size so frees can be subtracted
+static size_t heap_live = 0;
+
+void* operator new(size_t n) {
+    size_t* p = (size_t*) malloc(n + sizeof(max_align_t));
+    if (!p) throw std::bad_alloc();
+    *p = n;
+    heap_live += n;
+    return (uint8_t*) p + sizeof(max_align_t);
+}
+
+void operator delete(void* q) noexcept {
+    if (!q) return;
+    size_t* p = (size_t*) ((uint8_t*) q - sizeof(max_align_t));
+    heap_live -= *p;
+    free(p);
+}
+
+void operator delete(void* q, size_t) noexcept { operator delete(q); }
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete[](void* q) noexcept { operator delete(q); }
+void operator delete[](void* q, size_t) noexcept { operator delete(q); }
+
+void setUp() {}
+void tearDown() {}
+
+// ================== ObjectPool ==================
+struct Item {
+    int value;
+    explicit Item(int v) : value(v) {}
+};
+
+static void test_handles_expire_with_their_object() {
+    ObjectPool<Item, 4> pool;
+    Item* a = pool.create(1);
+    PoolHandle h = pool.handleOf(a);
+    TEST_ASSERT_EQUAL_PTR(a, pool.get(h));
+
+    pool.destroy(a);
+    TEST_ASSERT_NULL(pool.get(h));
+
+    // The slot is reused (LIFO) under a new generation
+    Item* b = pool.create(2);
+    TEST_ASSERT_EQUAL_PTR(a, b);
+    TEST_ASSERT_NULL(pool.get(h));
+    TEST_ASSERT_EQUAL_PTR(b, pool.get(pool.handleOf(b)));
+    TEST_ASSERT_TRUE(pool.get(PoolHandle()) == nullptr);
+}
+
+static void test_exhaustion_and_bad_frees_are_counted() {
+    ObjectPool<Item, 4> pool;
+    Item* items[4];
+    for (int i = 0; i < 4; ++i) items[i] = pool.create(i);
+    TEST_ASSERT_NULL(pool.create(9));
+    TEST_ASSERT_EQUAL(1, pool.stats().failures);
+    TEST_ASSERT_EQUAL(0, pool.available());
+
+    Item outside(0);
+    pool.destroy(&outside);
+    pool.destroy(items[0]);
+    pool.destroy(items[0]);
+    TEST_ASSERT_EQUAL(2, pool.stats().bad_frees);
+    TEST_ASSERT_EQUAL(3, pool.stats().live);
+    TEST_ASSERT_EQUAL(4, pool.stats().peak);
+}
+
+// ================== PREFERENCE RESETS ==================
+// Same steps as restorePersistentData() / resetPreferences() in main.cpp
+static void restore() {
+    PreferencesHandler::begin();
+    PreferencesHandler::loadUsers(all_users);
+    PreferencesHandler::loadChannels(all_channels);
+    rebuildChannelActivity();
+
+    String uname = PreferencesHandler::getUsername("Guest");
+    local_user = findUserById(uname);
+    if (!local_user) {
+        local_user = createUser(uname, uname);
+        all_users.push_back(local_user);
+    }
+}
+
+static void resetPreferences() {
+    PreferencesHandler::begin();
+    PreferencesHandler::clearAll();
+    PreferencesHandler::end();
+    PreferencesHandler::begin();
+    restore();
+}
+
+// Saved users and channels, restored and filled with messages, as between two resets
+static void populate() {
+    PreferencesHandler::begin();
+    PreferencesHandler::setString("users", "u1,Ann;u2,Bob;u3,Cy;");
+    PreferencesHandler::setString("channels", "123123,Broadcast,0;456456,Lobby,0;");
+    restore();
+    for (Channel* ch : all_channels) {
+        for (int i = 0; i < 8; ++i) {
+            Message* m = createMessage(ch->ID, IdString("m"), IdString("u1"), String("hello there"));
+            if (!m) continue;
+            ch->addMessage(m);
+            all_messages.push_back(m);
+        }
+    }
+}
+
+static void test_resets_keep_memory_flat() {
+    populate();
+    resetPreferences();
+    const PoolStats users = user_pool.stats();
+    const PoolStats channels = channel_pool.stats();
+    const PoolStats messages = message_pool.stats();
+    const size_t heap = heap_live;
+
+    for (int cycle = 0; cycle < 1000; ++cycle) {
+        populate();
+        TEST_ASSERT_EQUAL(4, user_pool.stats().live);
+        TEST_ASSERT_EQUAL(16, message_pool.stats().live);
+        resetPreferences();
+
+        TEST_ASSERT_EQUAL(users.live, user_pool.stats().live);
+        TEST_ASSERT_EQUAL(channels.live, channel_pool.stats().live);
+        TEST_ASSERT_EQUAL(messages.live, message_pool.stats().live);
+        TEST_ASSERT_EQUAL(heap, heap_live);
+    }
+    TEST_ASSERT_EQUAL(1, user_pool.stats().live);
+    TEST_ASSERT_EQUAL(0, channel_pool.stats().live);
+    TEST_ASSERT_EQUAL(0, message_pool.stats().live);
+    TEST_ASSERT_EQUAL(users.peak, user_pool.stats().peak);
+    TEST_ASSERT_EQUAL(0, user_pool.stats().failures + channel_pool.stats().failures +
+                         message_pool.stats().failures);
+    TEST_ASSERT_EQUAL(0, user_pool.stats().bad_frees + channel_pool.stats().bad_frees +
+                         message_pool.stats().bad_frees);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_handles_expire_with_their_object);
+    RUN_TEST(test_exhaustion_and_bad_frees_are_counted);
+    RUN_TEST(test_resets_keep_memory_flat);
+    return UNITY_END();
+}
@@ -0,0 +1,178 @@
+// Host tests for SearchIndex at 10,000 messages: the RAM budget, recall over
+// the range each query claims to have searched (index plus flash scan),
+// query latency, and hits verified against flash.
+#include <unity.h>
+#include <chrono>
+#include <algorithm>
+#include <vector>
+#include "HistoryStore/HistoryStore.h"
+#include "SearchIndex/SearchIndex.h"
+
+static const int MESSAGES = 10000;
+static const int CHANNELS = 4;
+static Channel* channels[CHANNELS];
+
+static const char* const WORDS[] = {
+    "hello", "there", "meet", "at", "the", "camp", "ridge", "north", "trail", "water",
+    "battery", "low", "signal", "strong", "weak", "moving", "back", "soon", "ok", "copy",
+    "river", "crossing", "summit", "weather", "storm", "clear", "tonight", "morning", "radio", "check",
+};
+
+// Body of message i: a few common words, plus a token only it contains
+static String bodyOf(int i) {
+    char buf[96];
+    int n = snprintf(buf, sizeof(buf), "%s %s %s", WORDS[random(30)], WORDS[random(30)], WORDS[random(30)]);
+    snprintf(buf + n, sizeof(buf) - n, " ref%05dq", i);
+    return String(buf);
+}
+
+static double queryUs(const char* query, byte& hits) {
+    auto start = std::chrono::steady_clock::now();
+    hits = SearchIndex::search(query);
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void setUp() {}
+void tearDown() {}
+
+// The index never grows past its fixed budget
+static void test_budget_holds_at_10k() {
+    TEST_ASSERT_EQUAL(MESSAGES, SearchIndex::docsIndexed());
+    TEST_ASSERT_LESS_OR_EQUAL(SearchIndex::bytesBudget(), SearchIndex::bytesUsed());
+    TEST_ASSERT_LESS_OR_EQUAL(SearchIndex::MAX_DOCS, SearchIndex::docsSearchable());
+    printf("SearchIndex: %u docs indexed, %u searchable, %u of %u bytes\n",
+           (unsigned) SearchIndex::docsIndexed(), (unsigned) SearchIndex::docsSearchable(),
+           (unsigned) SearchIndex::bytesUsed(), (unsigned) SearchIndex::bytesBudget());
+}
+
+// A token of a recent message finds exactly that message, case-folded
+static void test_recent_token_found_and_verified() {
+    char q[16];
+    snprintf(q, sizeof(q), "REF%05dQ", MESSAGES - 3);
+    TEST_ASSERT_EQUAL(1, SearchIndex::search(q));
+
+    const SearchHit& hit = SearchIndex::hit(0);
+    Channel* ch = channel_pool.get(hit.channel);
+    TEST_ASSERT_TRUE(ch == channels[(MESSAGES - 3) % CHANNELS]);
+    HistoryRecord r;
+    TEST_ASSERT_TRUE(HistoryStore::readRecord(ch, hit.record, r));
+    TEST_ASSERT_NOT_NULL(strstr(r.text, "ref09997q"));
+}
+
+// Recent messages stay findable: the arena must not churn faster than
+// messages arrive (blocks outnumber buckets), and what it forgets is read
+// back from flash
+static void test_recent_messages_recall() {
+    int found = 0;
+    for (int i = MESSAGES - 200; i < MESSAGES; ++i) {
+        char q[16];
+        snprintf(q, sizeof(q), "ref%05dq", i);
+        found += SearchIndex::search(q) == 1;
+    }
+    printf("SearchIndex recall: %d of last 200\n", found);
+    TEST_ASSERT_EQUAL(200, found);
+}
+
+// Every stored message is either found or outside the range the query
+// reports as searched, and the newest SCAN_RECORDS / CHANNELS of every
+// channel are always searched
+static void test_recall_over_claimed_range() {
+    const uint32_t always = SearchIndex::SCAN_RECORDS / CHANNELS;
+    uint32_t stored = 0, found = 0;
+    for (Channel* ch : channels) stored += ch->history_count;
+    for (int c = 0; c < CHANNELS; ++c) {
+        Channel* ch = channels[c];
+        for (uint32_t rec = 0; rec < ch->history_count; ++rec) {
+            HistoryRecord r;
+            TEST_ASSERT_TRUE(HistoryStore::readRecord(ch, rec, r));
+            const char* token = strstr(r.text, "ref");
+            TEST_ASSERT_NOT_NULL(token);
+            char q[16];
+            snprintf(q, sizeof(q), "%.9s", token);
+
+            byte hits = SearchIndex::search(q);
+            TEST_ASSERT_LESS_OR_EQUAL(1, hits);
+            TEST_ASSERT_EQUAL(stored, SearchIndex::lastQueryStored());
+            if (hits == 1) {
+                const SearchHit& hit = SearchIndex::hit(0);
+                TEST_ASSERT_TRUE(channel_pool.get(hit.channel) == ch);
+                TEST_ASSERT_EQUAL(rec, hit.record);
+                found++;
+            } else {
+                TEST_ASSERT_TRUE(SearchIndex::lastQueryCovered() < SearchIndex::lastQueryStored());
+                TEST_ASSERT_TRUE(ch->history_count - rec > always);
+            }
+        }
+    }
+    printf("SearchIndex: %u of %u stored messages found\n", (unsigned) found, (unsigned) stored);
+    TEST_ASSERT_GREATER_OR_EQUAL(SearchIndex::SCAN_RECORDS, found);
+}
+
+// Messages compacted off flash are gone, without false hits
+static void test_oldest_messages_forgotten() {
+    TEST_ASSERT_EQUAL(0, SearchIndex::search("ref00042q"));
+    TEST_ASSERT_EQUAL(0, SearchIndex::search("no such words"));
+}
+
+// Common words fill the hit list, newest first
+static void test_common_words_cap_at_max_results() {
+    TEST_ASSERT_EQUAL(SearchIndex::MAX_RESULTS, SearchIndex::search("battery"));
+    for (byte i = 1; i < SearchIndex::hitCount(); ++i) {
+        const SearchHit& a = SearchIndex::hit(i - 1);
+        const SearchHit& b = SearchIndex::hit(i);
+        TEST_ASSERT_TRUE(a.channel != b.channel || a.record > b.record);
+    }
+}
+
+// Latency over a mix of rare, common and missing queries
+static void test_query_latency() {
+    const char* const queries[] = {
+        "ref09990q", "ref09500q", "battery", "summit", "meet at the", "storm tonight",
+        "radio check", "xyzzy", "ref0999", "water crossing",
+    };
+    std::vector<double> us;
+    for (int round = 0; round < 50; ++round) {
+        for (const char* q : queries) {
+            byte hits;
+            us.push_back(queryUs(q, hits));
+        }
+    }
+    std::sort(us.begin(), us.end());
+    double p50 = us[us.size() / 2];
+    double p99 = us[us.size() * 99 / 100];
+    printf("SearchIndex query: p50 %.1f us, p99 %.1f us, max %.1f us over %u queries\n",
+           p50, p99, us.back(), (unsigned) us.size());
+    TEST_ASSERT_TRUE(p99 < 5000);
+}
+
+int main() {
+    for (int c = 0; c < CHANNELS; ++c) {
+        char id[8], name[8];
+        snprintf(id, sizeof(id), "%06d", 100000 + c);
+        snprintf(name, sizeof(name), "ch%d", c);
+        channels[c] = createChannel(CHAT_GROUP, NameString(name), IdString(id));
+        registerChannel(channels[c]);
+    }
+    HistoryStore::begin();
+    SearchIndex::begin();
+
+    HistoryStore::beginBatch();
+    for (int i = 0; i < MESSAGES; ++i) {
+        char id[16];
+        snprintf(id, sizeof(id), "s%d", i);
+        Message* resident;
+        HistoryStore::append(channels[i % CHANNELS], IdString(id), IdString("peer"), bodyOf(i),
+                             String("12:00:00"), resident);
+    }
+    HistoryStore::endBatch();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_budget_holds_at_10k);
+    RUN_TEST(test_recent_token_found_and_verified);
+    RUN_TEST(test_recent_messages_recall);
+    RUN_TEST(test_recall_over_claimed_range);
+    RUN_TEST(test_oldest_messages_forgotten);
+    RUN_TEST(test_common_words_cap_at_max_results);
+    RUN_TEST(test_query_latency);
+    return UNITY_END();
+}
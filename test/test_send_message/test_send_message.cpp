@@ -0,0 +1,151 @@
+// Host tests for the SEND key: packets keep their place in the TX ring
+// while logs flood it, a send that cannot be queued keeps the draft and
+// shows as failed, and keypress-to-return time with the ring empty and full.
+#include <unity.h>
+#include <chrono>
+#include <string>
+#include "KeypadHandler/KeypadHandler.h"
+#include "TFTHandler/TFTHandler.h"
+#include "HistoryStore/HistoryStore.h"
+#include "SerialTxHandler/SerialTxHandler.h"
+#include "DebugMacros.h"
+
+static TFTHandler display;
+static KeypadHandler pad(&display);
+static Channel* chat;
+
+static void frame() {
+    for (int pass = 0; pass < 100 && display.renderPending(); ++pass) {
+        HostClock::advanceMs(5);
+        pad.update();
+        display.render();
+    }
+}
+
+static void key(char k) {
+    pad.ltrpad.fire(k, PRESSED);
+    pad.ltrpad.fire(k, RELEASED);
+}
+
+// Lets the UART take everything queued
+static void drain() {
+    Serial.tx_room = 4096;
+    SerialTxHandler::pump();
+    Serial.tx.clear();
+}
+
+// Fill the ring with log lines until they are refused
+static void floodLogs() {
+    Serial.tx_room = 0;
+    uint32_t dropped = SerialTxHandler::droppedLines();
+    while (SerialTxHandler::droppedLines() == dropped) {
+        INFO("PERF loop_hz=1234 pkt_s=12 heap_free=123456 some more text to fill the ring");
+    }
+}
+
+void setUp() {
+    drain();
+}
+
+void tearDown() {}
+
+// Log lines stop short of the packet reserve, so the user's packet still fits
+static void test_packet_survives_log_flood() {
+    floodLogs();
+    TEST_ASSERT_TRUE(SerialTxHandler::RING_SIZE - SerialTxHandler::pending() >= SerialTxHandler::PACKET_RESERVE);
+
+    uint32_t stored = chat->history_count;
+    key('a');
+    KeypadHandler::injectKey('H');
+    TEST_ASSERT_EQUAL(stored + 1, chat->history_count);
+    TEST_ASSERT_EQUAL_STRING("", text_draft.c_str());
+    TEST_ASSERT_FALSE(display.sendFailed);
+
+    Serial.tx_room = 4096;
+    SerialTxHandler::pump();
+    TEST_ASSERT_TRUE(Serial.tx.find("515151||") != std::string::npos);
+    frame();
+}
+
+// With no room at all nothing is stored or shown as sent; the draft waits
+// for a retry, which goes through once the UART drains
+static void test_full_ring_keeps_draft() {
+    Serial.tx_room = 0;
+    while (SerialTxHandler::enqueuePacket("515151||x||y||z||12:00:00")) {}
+    uint32_t stored = chat->history_count;
+    uint32_t lost = SerialTxHandler::droppedPackets();
+
+    key('d');
+    KeypadHandler::injectKey('H');
+    TEST_ASSERT_EQUAL(stored, chat->history_count);
+    TEST_ASSERT_EQUAL_STRING("d", text_draft.c_str());
+    TEST_ASSERT_TRUE(display.sendFailed);
+    TEST_ASSERT_EQUAL(lost + 1, SerialTxHandler::droppedPackets());
+
+    display.tft.resetStats();
+    display.tft.recording = true;
+    frame();
+    display.tft.recording = false;
+    bool retry = false;
+    for (const TftOp& op : display.tft.ops) retry |= op.op == 'S' && op.text == "RETRY";
+    TEST_ASSERT_TRUE(retry);
+
+    drain();
+    KeypadHandler::injectKey('H');
+    TEST_ASSERT_EQUAL(stored + 1, chat->history_count);
+    TEST_ASSERT_EQUAL_STRING("", text_draft.c_str());
+    TEST_ASSERT_FALSE(display.sendFailed);
+    frame();
+}
+
+// Keypress to return of the SEND handler; a refused send must stay cheap
+static void test_send_handler_time() {
+    const int SENDS = 200;
+    double us[2];
+    for (int full = 0; full < 2; ++full) {
+        if (full) {
+            Serial.tx_room = 0;
+            while (SerialTxHandler::enqueuePacket("515151||x||y||z||12:00:00")) {}
+            key('a');  // Stays: every send is refused
+        }
+        double total = 0;
+        for (int i = 0; i < SENDS; ++i) {
+            if (!full) key("adgjmp"[i % 6]);
+            auto start = std::chrono::steady_clock::now();
+            KeypadHandler::injectKey('H');
+            total += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            if (!full) drain();
+            HostClock::advanceMs(1000);  // Let the multi-tap time out
+            pad.update();
+        }
+        us[full] = total / SENDS;
+    }
+    TEST_ASSERT_EQUAL_STRING("a", text_draft.c_str());
+    drain();
+
+    printf("SEND handler: %.1f us with the ring empty, %.1f us with it full\n", us[0], us[1]);
+    TEST_ASSERT_TRUE(us[0] < 1000);
+    TEST_ASSERT_TRUE(us[1] < 1000);
+    TEST_ASSERT_TRUE(KeypadHandler::send_handler_max_us >= KeypadHandler::send_handler_us);
+}
+
+int main() {
+    local_user = createUser(IdString("me"), NameString("Me"));
+    all_users.push_back(local_user);
+    chat = createChannel(CHAT_GROUP, NameString("Send"), IdString("515151"));
+    registerChannel(chat);
+    HistoryStore::begin();
+    pad.begin();
+
+    // Open the chat
+    key('1');
+    frame();
+    key((char) ('1' + all_channels.size() - 1));
+    frame();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_packet_survives_log_flood);
+    RUN_TEST(test_full_ring_keeps_draft);
+    RUN_TEST(test_send_handler_time);
+    return UNITY_END();
+}
@@ -0,0 +1,153 @@
+// Host tests for TextCodec: round trips, compression ratio and speed over
+// a chat corpus, exact CAP token parsing, and the per-channel wire form.
+#include <unity.h>
+#include <chrono>
+#include "TextCodec/TextCodec.h"
+#include "global_objects.h"
+
+static const char* const CORPUS[] = {
+    "hey are you there?",
+    "I'll be at the camp in about ten minutes",
+    "ok, see you soon",
+    "the battery is getting low, going to switch off the radio for a while",
+    "did anyone else hear that storm warning on the weather channel",
+    "meet at the north trailhead tomorrow morning at 7",
+    "Thanks for the help this afternoon, really appreciated it",
+    "where are you now? I can't see the signal on the map",
+    "we're moving to the river crossing, follow the ridge",
+    "copy that, heading back",
+    "what time do you want to start walking tomorrow",
+    "it's getting dark, we should set up the tents here",
+    "is everyone ok? please check in when you can",
+    "the summit was amazing, the view from there is incredible",
+    "sounds good to me, let's do it",
+    "Grüße aus München, wir sind gleich da",
+    "pipes | and\ttabs stay as they are",
+};
+
+void setUp() {}
+void tearDown() {}
+
+static void test_round_trip_and_safe_bytes() {
+    for (const char* text : CORPUS) {
+        String stored = TextCodec::pack(text);
+        size_t n;
+        const char* plain = TextCodec::view(stored, n);
+        TEST_ASSERT_EQUAL(strlen(text), n);
+        TEST_ASSERT_EQUAL_STRING(text, plain);
+
+        // Packing never introduces separators the line format relies on
+        bool pipe = strchr(text, '|') != nullptr;
+        TEST_ASSERT_TRUE(pipe || strchr(stored.c_str(), '|') == nullptr);
+        TEST_ASSERT_NULL(strchr(stored.c_str(), '\n'));
+        TEST_ASSERT_EQUAL(strlen(stored.c_str()), stored.length());
+    }
+}
+
+// Text that wouldn't shrink stays plain; packed input is not packed twice
+static void test_plain_when_no_gain() {
+    String s = TextCodec::pack("zq");
+    TEST_ASSERT_FALSE(TextCodec::isPacked(s.c_str(), s.length()));
+    TEST_ASSERT_EQUAL_STRING("zq", s.c_str());
+    size_t n;
+    TEST_ASSERT_EQUAL_PTR(s.c_str(), TextCodec::view(s, n));
+
+    String once = TextCodec::pack("the thing is that you and the other ones");
+    TEST_ASSERT_TRUE(TextCodec::isPacked(once.c_str(), once.length()));
+    TEST_ASSERT_EQUAL_STRING(once.c_str(), TextCodec::pack(once).c_str());
+}
+
+static void test_corpus_ratio() {
+    size_t plain = 0, packed = 0;
+    for (const char* text : CORPUS) {
+        plain += strlen(text);
+        packed += TextCodec::pack(text).length();
+    }
+    double ratio = (double) packed / plain;
+    printf("TextCodec: %u -> %u bytes (%.0f %%)\n", (unsigned) plain, (unsigned) packed, ratio * 100);
+    TEST_ASSERT_TRUE(ratio < 0.70);
+}
+
+static void test_encode_decode_speed() {
+    const int ROUNDS = 20000;
+    char packed[TextCodec::VIEW_SIZE], plain[TextCodec::VIEW_SIZE];
+    size_t bytes = 0, check = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (const char* text : CORPUS) {
+            size_t len = strlen(text);
+            size_t n = TextCodec::compress(text, len, packed, sizeof(packed));
+            check += TextCodec::expand(packed, n, plain, sizeof(plain));
+            bytes += len;
+        }
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("TextCodec: compress+expand %.1f MB/s\n", bytes / s / 1e6);
+    TEST_ASSERT_EQUAL(bytes, check);
+    TEST_ASSERT_TRUE(bytes / s > 5e6);
+}
+
+// ================== CAPABILITY ==================
+static void test_capability_token_is_exact() {
+    TEST_ASSERT_FALSE(TextCodec::onCapability("KEYS||abc"));
+
+    TEST_ASSERT_TRUE(TextCodec::onCapability("CAP||Z10"));
+    TEST_ASSERT_FALSE(TextCodec::linkSupports());
+    TEST_ASSERT_TRUE(TextCodec::onCapability("CAP||Z"));
+    TEST_ASSERT_FALSE(TextCodec::linkSupports());
+    TEST_ASSERT_TRUE(TextCodec::onCapability("CAP||Z1"));
+    TEST_ASSERT_TRUE(TextCodec::linkSupports());
+
+    User* peer = createUser(IdString("peer01"), NameString("Peer"));
+    all_users.push_back(peer);
+    TextCodec::onCapability("CAP||Z10||peer01");
+    TEST_ASSERT_FALSE(peer->packs);
+    TextCodec::onCapability("CAP||Z1||peer01");
+    TEST_ASSERT_TRUE(peer->packs);
+}
+
+// A channel gets packed bodies only once every other sender in its window reads them
+static void test_wire_form_per_channel() {
+    TextCodec::onCapability("CAP||Z1");
+    local_user = createUser(IdString("me"), NameString("Me"));
+    User* old = createUser(IdString("old01"), NameString("Old"));
+    all_users.push_back(local_user);
+    all_users.push_back(old);
+    Channel* ch = createChannel(CHAT_GROUP, NameString("Wire"), IdString("777777"));
+
+    String body = TextCodec::pack("see you at the camp tonight");
+    TEST_ASSERT_TRUE(TextCodec::isPacked(body.c_str(), body.length()));
+
+    // Nobody else has spoken: nobody known to read packed bodies
+    ch->addMessage(createMessage(ch->ID, IdString("a"), local_user->ID, body));
+    TEST_ASSERT_FALSE(TextCodec::channelSupports(ch));
+
+    ch->addMessage(createMessage(ch->ID, IdString("b"), IdString("peer01"), String("hi")));
+    TEST_ASSERT_TRUE(TextCodec::channelSupports(ch));
+    TEST_ASSERT_EQUAL_STRING(body.c_str(), TextCodec::forWire(ch, body).c_str());
+
+    // An older peer turns the channel back to plain text until it sends a packed body
+    ch->addMessage(createMessage(ch->ID, IdString("c"), old->ID, String("hello")));
+    TEST_ASSERT_FALSE(TextCodec::channelSupports(ch));
+    TEST_ASSERT_EQUAL_STRING("see you at the camp tonight", TextCodec::forWire(ch, body).c_str());
+
+    TextCodec::onReceived(old, TextCodec::pack("and the other thing"));
+    TEST_ASSERT_TRUE(TextCodec::channelSupports(ch));
+
+    // No link support: always plain
+    TextCodec::onCapability("CAP||NONE");
+    TEST_ASSERT_FALSE(TextCodec::channelSupports(ch));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_and_safe_bytes);
+    RUN_TEST(test_plain_when_no_gain);
+    RUN_TEST(test_corpus_ratio);
+    RUN_TEST(test_encode_decode_speed);
+    RUN_TEST(test_capability_token_is_exact);
+    RUN_TEST(test_wire_form_per_channel);
+    return UNITY_END();
+}
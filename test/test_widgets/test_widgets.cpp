@@ -0,0 +1,219 @@
+// Host tests for WidgetRenderer and VirtualList: widget bounds, damage
+// tracking between screens, and row repaints, checked against the primitives
+// the recording TFT shim saw.
+#include <unity.h>
+#include "UIWidgets/UIWidgets.h"
+#include "TFTHandler/Screens.h"
+
+static TFT_eSPI tft(320, 240);
+
+void setUp() {
+    Theme::select(0);
+    tft.resetStats();
+    tft.recording = true;
+}
+
+void tearDown() {}
+
+static size_t countType(const UIScreen& s, byte type) {
+    size_t n = 0;
+    for (byte i = 0; i < s.count; ++i) n += s.widgets[i].type == type;
+    return n;
+}
+
+// ================== BOUNDS ==================
+static void test_bounds_follow_shape_and_datum() {
+    UIRect c = WidgetRenderer::bounds(tft, uiCircle(50, 60, 10, PAL_TEXT));
+    TEST_ASSERT_EQUAL(40, c.x);
+    TEST_ASSERT_EQUAL(50, c.y);
+    TEST_ASSERT_EQUAL(21, c.w);
+    TEST_ASSERT_EQUAL(21, c.h);
+
+    UIRect a = WidgetRenderer::bounds(tft, uiArrow(10, 100, 20, 8, PAL_TEXT));
+    TEST_ASSERT_EQUAL(10, a.x);
+    TEST_ASSERT_EQUAL(92, a.y);
+    TEST_ASSERT_EQUAL(21, a.w);
+    TEST_ASSERT_EQUAL(17, a.h);
+
+    // "ab" in font 2 is 14 px wide and 16 px high; MC_DATUM centres it
+    UIRect l = WidgetRenderer::bounds(tft, uiLabel(100, 50, "ab", 2, MC_DATUM, PAL_TEXT, PAL_BAR));
+    TEST_ASSERT_EQUAL(93, l.x);
+    TEST_ASSERT_EQUAL(42, l.y);
+    TEST_ASSERT_EQUAL(14, l.w);
+    TEST_ASSERT_EQUAL(16, l.h);
+
+    UIRect t = WidgetRenderer::bounds(tft, uiText(5, 34, "ab", 1, TL_DATUM, PAL_MUTED));
+    TEST_ASSERT_EQUAL(5, t.x);
+    TEST_ASSERT_EQUAL(34, t.y);
+    TEST_ASSERT_EQUAL(12, t.w);
+    TEST_ASSERT_EQUAL(8, t.h);
+}
+
+// A label's bounds cover exactly what drawString puts on the panel
+static void test_label_bounds_match_drawn_text() {
+    for (byte datum = 0; datum < 9; ++datum) {
+        Widget w = uiLabel(160, 120, "Settings", 2, datum, PAL_TEXT, PAL_BAR);
+        tft.resetStats();
+        WidgetRenderer::paint(tft, w);
+        UIRect r = WidgetRenderer::bounds(tft, w);
+        TEST_ASSERT_EQUAL(1, tft.ops.size());
+        TEST_ASSERT_EQUAL(r.x, tft.ops[0].x);
+        TEST_ASSERT_EQUAL(r.y, tft.ops[0].y);
+        TEST_ASSERT_EQUAL(r.w, tft.ops[0].w);
+        TEST_ASSERT_EQUAL(r.h, tft.ops[0].h);
+    }
+}
+
+// ================== SCREEN SWITCHES ==================
+static void test_unknown_panel_repaints_everything() {
+    byte painted = WidgetRenderer::show(tft, nullptr, SETTINGS_SCREEN);
+    TEST_ASSERT_EQUAL(SETTINGS_SCREEN.count, painted);
+    TEST_ASSERT_EQUAL(1, tft.stats.clears);
+    TEST_ASSERT_EQUAL('F', tft.ops[0].op);
+    TEST_ASSERT_EQUAL(Theme::color(PAL_BACKGROUND), tft.ops[0].color);
+}
+
+// Showing the same screen again only clears its dynamic regions
+static void test_same_screen_repaints_only_regions() {
+    const UIScreen* screens[] = { &MESSAGES_SCREEN, &CHAT_SCREEN, &SEARCH_SCREEN, &SETTINGS_SCREEN };
+    for (const UIScreen* s : screens) {
+        tft.resetStats();
+        byte painted = WidgetRenderer::show(tft, s, *s);
+        TEST_ASSERT_EQUAL(0, tft.stats.clears);
+        TEST_ASSERT_EQUAL(0, tft.stats.strings);
+        TEST_ASSERT_EQUAL(0, tft.stats.pushes);
+        TEST_ASSERT_EQUAL(countType(*s, W_REGION), painted);
+        TEST_ASSERT_EQUAL(painted, tft.ops.size());
+    }
+}
+
+// Only the changed label and what sits under its old area are repainted
+static void test_changed_label_repaints_its_area() {
+    static const Widget A[] = {
+        uiRect(0, 0, 100, 20, PAL_BAR),
+        uiLabel(50, 10, "One", 2, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+        uiRect(0, 100, 50, 50, PAL_PANEL),
+        uiText(200, 200, "keep", 2, TL_DATUM, PAL_TEXT),
+    };
+    static const Widget B[] = {
+        uiRect(0, 0, 100, 20, PAL_BAR),
+        uiLabel(50, 10, "Two", 2, MC_DATUM, PAL_BAR_TEXT, PAL_BAR),
+        uiRect(0, 100, 50, 50, PAL_PANEL),
+        uiText(200, 200, "keep", 2, TL_DATUM, PAL_TEXT),
+    };
+    const UIScreen a = UI_SCREEN(A, PAL_BACKGROUND);
+    const UIScreen b = UI_SCREEN(B, PAL_BACKGROUND);
+
+    byte painted = WidgetRenderer::show(tft, &a, b);
+    TEST_ASSERT_EQUAL(2, painted);
+    TEST_ASSERT_EQUAL(3, tft.ops.size());
+
+    // Old label cleared to the background, then the bar under it, then the new label
+    UIRect old = WidgetRenderer::bounds(tft, A[1]);
+    TEST_ASSERT_EQUAL('F', tft.ops[0].op);
+    TEST_ASSERT_EQUAL(Theme::color(PAL_BACKGROUND), tft.ops[0].color);
+    TEST_ASSERT_EQUAL(old.x, tft.ops[0].x);
+    TEST_ASSERT_EQUAL(old.w, tft.ops[0].w);
+    TEST_ASSERT_EQUAL('F', tft.ops[1].op);
+    TEST_ASSERT_EQUAL(Theme::color(PAL_BAR), tft.ops[1].color);
+    TEST_ASSERT_EQUAL('S', tft.ops[2].op);
+    TEST_ASSERT_EQUAL_STRING("Two", tft.ops[2].text.c_str());
+}
+
+// A different background falls back to a full repaint
+static void test_background_change_repaints_everything() {
+    static const Widget A[] = { uiRect(0, 0, 100, 20, PAL_BAR) };
+    const UIScreen a = UI_SCREEN(A, PAL_BACKGROUND);
+    const UIScreen b = UI_SCREEN(A, PAL_PANEL);
+    TEST_ASSERT_EQUAL(1, WidgetRenderer::show(tft, &a, b));
+    TEST_ASSERT_EQUAL(1, tft.stats.clears);
+}
+
+// Every real transition: widgets that stay and touch no damage are skipped,
+// and every widget painted lies on the panel
+static void test_real_transitions_skip_unchanged_widgets() {
+    const UIScreen* screens[] = {
+        &START_SCREEN, &SETTINGS_SCREEN, &MESSAGES_SCREEN, &ADD_LOBBY_SCREEN, &EDIT_USER_SCREEN,
+        &CHAT_SCREEN, &DIAGNOSTICS_SCREEN, &LINK_STATS_SCREEN, &DISCOVER_SCREEN, &SEARCH_SCREEN,
+    };
+    for (const UIScreen* from : screens) {
+        for (const UIScreen* to : screens) {
+            tft.resetStats();
+            byte painted = WidgetRenderer::show(tft, from, *to);
+            TEST_ASSERT_LESS_OR_EQUAL(to->count, painted);
+            TEST_ASSERT_EQUAL(0, tft.stats.clears);
+            for (const TftOp& op : tft.ops) {
+                TEST_ASSERT_TRUE(op.x >= 0 && op.y >= 0);
+                TEST_ASSERT_TRUE(op.x + op.w <= 320 && op.y + op.h <= 240);
+            }
+        }
+    }
+
+    // Search -> Diagnostics keeps only the title bar, yet moves fewer pixels than a full repaint
+    tft.resetStats();
+    WidgetRenderer::show(tft, &SEARCH_SCREEN, DIAGNOSTICS_SCREEN);
+    uint64_t partial = tft.stats.pixels;
+    tft.resetStats();
+    WidgetRenderer::show(tft, nullptr, DIAGNOSTICS_SCREEN);
+    TEST_ASSERT_LESS_THAN(tft.stats.pixels, partial);
+}
+
+// ================== VirtualList ==================
+struct Row {
+    uint32_t version;
+};
+
+static Row rows[5];
+static size_t row_count = 5;
+static size_t rows_drawn = 0;
+
+static void* rowAt(size_t i) { return i < row_count ? &rows[i] : nullptr; }
+static void* rowNext(void* item) { return rowAt((Row*) item - rows + 1); }
+static uint32_t rowVersion(void* item) { return ((Row*) item)->version; }
+static void rowDraw(TFT_eSPI& t, void*, byte, int16_t x, int16_t y, int16_t w, int16_t h) {
+    t.fillRect(x, y, w, h, Theme::color(PAL_PANEL));
+    rows_drawn++;
+}
+
+static const ListSource ROWS = { rowAt, rowNext, rowVersion, rowDraw };
+
+static void test_virtual_list_repaints_changed_rows_only() {
+    for (Row& r : rows) r.version = 1;
+    row_count = 5;
+    rows_drawn = 0;
+    VirtualList list(0, 30, 320, 20, 4, PAL_BACKGROUND, ROWS);
+
+    TEST_ASSERT_EQUAL(4, list.draw(tft, 0));
+    TEST_ASSERT_EQUAL(4, rows_drawn);
+    TEST_ASSERT_EQUAL(0, list.draw(tft, 0));
+
+    rows[2].version++;
+    TEST_ASSERT_EQUAL(1, list.draw(tft, 0));
+    TEST_ASSERT_EQUAL(5, rows_drawn);
+
+    // Scrolling by one shifts every slot
+    TEST_ASSERT_EQUAL(4, list.draw(tft, 1));
+
+    // Rows past the end are cleared once, then left alone
+    row_count = 2;
+    tft.resetStats();
+    TEST_ASSERT_EQUAL(4, list.draw(tft, 0));
+    TEST_ASSERT_EQUAL(4, tft.stats.fills);
+    TEST_ASSERT_EQUAL(0, list.draw(tft, 0));
+
+    list.invalidate();
+    TEST_ASSERT_EQUAL(4, list.draw(tft, 0));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bounds_follow_shape_and_datum);
+    RUN_TEST(test_label_bounds_match_drawn_text);
+    RUN_TEST(test_unknown_panel_repaints_everything);
+    RUN_TEST(test_same_screen_repaints_only_regions);
+    RUN_TEST(test_changed_label_repaints_its_area);
+    RUN_TEST(test_background_change_repaints_everything);
+    RUN_TEST(test_real_transitions_skip_unchanged_widgets);
+    RUN_TEST(test_virtual_list_repaints_changed_rows_only);
+    return UNITY_END();
+}
@@ -0,0 +1,323 @@
+#!/usr/bin/env python3
+"""Rasterize the static UI artwork into RLE palette-role images.
+
+The shapes below are the ones the widget tables used to draw with TFT_eSPI
+primitives; they are rasterized here with the same integer algorithms, so
+the images are pixel-identical to the primitive output. Pixels are palette
+roles (PAL_* from src/Theme/Theme.h), not colours, so themes still apply:
+the device expands roles through the active palette while streaming.
+
+RLE stream (rows concatenated, runs may continue onto the next row):
+    byte = role << 4 | n      n = 1..15: run of n pixels
+                              n = 0: run of (next byte + 16) pixels
+
+The rasters themselves go to test/test_assets/AssetRaster.h, one hex digit
+(role) per pixel, so the native test can decode every image through the
+firmware's PaletteSprite::pushRuns and compare pixel by pixel.
+
+Usage:
+    python3 tools/gen_assets.py           regenerate src/Assets/AssetData.{h,cpp}
+                                          and test/test_assets/AssetRaster.h
+    python3 tools/gen_assets.py --check   verify round trip and that the files are current
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+THEME_H = os.path.join(ROOT, "src", "Theme", "Theme.h")
+OUT_H = os.path.join(ROOT, "src", "Assets", "AssetData.h")
+OUT_CPP = os.path.join(ROOT, "src", "Assets", "AssetData.cpp")
+OUT_RASTER = os.path.join(ROOT, "test", "test_assets", "AssetRaster.h")
+
+
+def load_roles():
+    roles = {}
+    with open(THEME_H) as f:
+        for m in re.finditer(r"const byte (PAL_\w+)\s*=\s*(\d+);", f.read()):
+            roles[m.group(1)] = int(m.group(2))
+    return roles
+
+
+ROLES = load_roles()
+
+
+def cdiv(a, b):
+    """C integer division (truncates toward zero)."""
+    q = abs(a) // abs(b)
+    return q if (a >= 0) == (b >= 0) else -q
+
+
+# ================== RASTERIZER ==================
+# Ports of the TFT_eSPI primitives, drawing into a clipped role canvas.
+class Canvas:
+    def __init__(self, x, y, w, h, background):
+        self.x, self.y, self.w, self.h = x, y, w, h
+        self.px = [[background] * w for _ in range(h)]
+
+    def pixel(self, x, y, c):
+        x -= self.x
+        y -= self.y
+        if 0 <= x < self.w and 0 <= y < self.h:
+            self.px[y][x] = c
+
+    def hline(self, x, y, w, c):
+        for i in range(w):
+            self.pixel(x + i, y, c)
+
+    def fill_rect(self, x, y, w, h, c):
+        for j in range(h):
+            self.hline(x, y + j, w, c)
+
+    def fill_circle(self, x0, y0, r, c):
+        x, dx, dy, p = 0, 1, r + r, -(r >> 1)
+        self.hline(x0 - r, y0, dy + 1, c)
+        while x < r:
+            if p >= 0:
+                self.hline(x0 - x, y0 + r, 2 * x + 1, c)
+                self.hline(x0 - x, y0 - r, 2 * x + 1, c)
+                dy -= 2
+                p -= dy
+                r -= 1
+            dx += 2
+            p += dx
+            x += 1
+            self.hline(x0 - r, y0 + x, 2 * r + 1, c)
+            self.hline(x0 - r, y0 - x, 2 * r + 1, c)
+
+    def fill_circle_helper(self, x0, y0, r, corner, delta, c):
+        f, ddf_x, ddf_y, y = 1 - r, 1, -r - r, 0
+        delta += 1
+        while y < r:
+            if f >= 0:
+                if corner & 1:
+                    self.hline(x0 - y, y0 + r, y + y + delta, c)
+                if corner & 2:
+                    self.hline(x0 - y, y0 - r, y + y + delta, c)
+                r -= 1
+                ddf_y += 2
+                f += ddf_y
+            y += 1
+            ddf_x += 2
+            f += ddf_x
+            if corner & 1:
+                self.hline(x0 - r, y0 + y, r + r + delta, c)
+            if corner & 2:
+                self.hline(x0 - r, y0 - y, r + r + delta, c)
+
+    def fill_round_rect(self, x, y, w, h, r, c):
+        self.fill_rect(x, y + r, w, h - r - r, c)
+        self.fill_circle_helper(x + r, y + h - r - 1, r, 1, w - r - r - 1, c)
+        self.fill_circle_helper(x + r, y + r, r, 2, w - r - r - 1, c)
+
+    def fill_triangle(self, x0, y0, x1, y1, x2, y2, c):
+        if y0 > y1:
+            x0, y0, x1, y1 = x1, y1, x0, y0
+        if y1 > y2:
+            x1, y1, x2, y2 = x2, y2, x1, y1
+        if y0 > y1:
+            x0, y0, x1, y1 = x1, y1, x0, y0
+        if y0 == y2:
+            a, b = min(x0, x1, x2), max(x0, x1, x2)
+            self.hline(a, y0, b - a + 1, c)
+            return
+        dx01, dy01 = x1 - x0, y1 - y0
+        dx02, dy02 = x2 - x0, y2 - y0
+        dx12, dy12 = x2 - x1, y2 - y1
+        sa = sb = 0
+        last = y1 if y1 == y2 else y1 - 1
+        y = y0
+        while y <= last:
+            a = x0 + cdiv(sa, dy01)
+            b = x0 + cdiv(sb, dy02)
+            sa += dx01
+            sb += dx02
+            if a > b:
+                a, b = b, a
+            self.hline(a, y, b - a + 1, c)
+            y += 1
+        sa = dx12 * (y - y1)
+        sb = dx02 * (y - y0)
+        while y <= y2:
+            a = x1 + cdiv(sa, dy12)
+            b = x0 + cdiv(sb, dy02)
+            sa += dx12
+            sb += dx02
+            if a > b:
+                a, b = b, a
+            self.hline(a, y, b - a + 1, c)
+            y += 1
+
+
+# ================== ASSETS ==================
+# name, (x, y, w, h) in screen coordinates, background role, shapes as in
+# Screens.h (uiArrow(x, y, w, h) is the triangle (x, y), (x+w, y-h), (x+w, y+h))
+def circle(x, y, r, role):
+    return lambda cv: cv.fill_circle(x, y, r, ROLES[role])
+
+
+def arrow(x, y, w, h, role):
+    return lambda cv: cv.fill_triangle(x, y, x + w, y - h, x + w, y + h, ROLES[role])
+
+
+def round_rect(x, y, w, h, r, role):
+    return lambda cv: cv.fill_round_rect(x, y, w, h, r, ROLES[role])
+
+
+ASSETS = [
+    ("LOGO", (120, 60, 141, 81), "PAL_BACKGROUND", [
+        circle(160, 100, 40, "PAL_GOOD"),
+        arrow(210, 100, 20, 20, "PAL_WARN"),
+        arrow(240, 100, 20, 30, "PAL_HIGHLIGHT"),
+    ]),
+    ("MENU_BUTTON", (40, 160, 240, 30), "PAL_BACKGROUND", [
+        round_rect(40, 160, 240, 30, 6, "PAL_ACCENT"),
+    ]),
+    ("SETTINGS_BUTTON", (40, 50, 240, 30), "PAL_BACKGROUND", [
+        round_rect(40, 50, 240, 30, 6, "PAL_PANEL"),
+    ]),
+    ("KEY_LEFT", (10, 190, 145, 24), "PAL_BACKGROUND", [
+        round_rect(10, 190, 145, 24, 6, "PAL_PANEL"),
+        round_rect(20, 192, 30, 20, 3, "PAL_WARN"),
+    ]),
+    ("KEY_RIGHT", (165, 190, 145, 24), "PAL_BACKGROUND", [
+        round_rect(165, 190, 145, 24, 12, "PAL_PANEL"),
+        round_rect(175, 192, 40, 20, 10, "PAL_BAD"),
+    ]),
+]
+
+
+# ================== CODEC ==================
+def encode(pixels):
+    flat = [p for row in pixels for p in row]
+    out = bytearray()
+    i = 0
+    while i < len(flat):
+        role = flat[i]
+        n = 1
+        while i + n < len(flat) and flat[i + n] == role and n < 271:
+            n += 1
+        if n < 16:
+            out.append(role << 4 | n)
+        else:
+            out += bytes([role << 4, n - 16])
+        i += n
+    return bytes(out)
+
+
+def decode(data, w, h):
+    flat = []
+    i = 0
+    while i < len(data):
+        role, n = data[i] >> 4, data[i] & 0x0F
+        i += 1
+        if n == 0:
+            n = data[i] + 16
+            i += 1
+        flat += [role] * n
+    if len(flat) != w * h:
+        raise ValueError("decoded %d pixels, expected %d" % (len(flat), w * h))
+    return [flat[r * w:(r + 1) * w] for r in range(h)]
+
+
+# ================== OUTPUT ==================
+def build():
+    images = []
+    for name, (x, y, w, h), bg, shapes in ASSETS:
+        cv = Canvas(x, y, w, h, ROLES[bg])
+        for draw in shapes:
+            draw(cv)
+        data = encode(cv.px)
+        if decode(data, w, h) != cv.px:
+            sys.exit("%s: RLE round trip is not pixel-exact" % name)
+        images.append((name, w, h, data, cv.px))
+    return images
+
+
+def render(images):
+    header = [
+        "// Generated by tools/gen_assets.py from the shapes listed there. Do not edit.",
+        "#pragma once",
+        "#ifndef ASSET_DATA_H",
+        "#define ASSET_DATA_H",
+        "",
+        '#include "../Theme/PaletteSprite.h"',
+        "",
+    ]
+    source = [
+        "// Generated by tools/gen_assets.py. Do not edit.",
+        '#include "AssetData.h"',
+    ]
+    for name, w, h, data, _ in images:
+        header.append("// %dx%d, %d bytes (%d at 4 bpp)" % (w, h, len(data), (w * h + 1) // 2))
+        header.append("extern const uint8_t ASSET_%s_RUNS[%d];" % (name, len(data)))
+        header.append("constexpr PaletteImage ASSET_%s = { %d, %d, ASSET_%s_RUNS, %d };"
+                      % (name, w, h, name, len(data)))
+        header.append("")
+
+        source.append("")
+        source.append("const uint8_t ASSET_%s_RUNS[%d] = {" % (name, len(data)))
+        for i in range(0, len(data), 16):
+            source.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+        source.append("};")
+    header.append("#endif // ASSET_DATA_H")
+    return "\n".join(header) + "\n", "\n".join(source) + "\n"
+
+
+def render_raster(images):
+    out = [
+        "// Generated by tools/gen_assets.py: the rasters the ASSET_* images encode,",
+        "// one string per row, one hex digit (palette role) per pixel. Do not edit.",
+        "#pragma once",
+        "#ifndef ASSET_RASTER_H",
+        "#define ASSET_RASTER_H",
+        "",
+        '#include "Assets/AssetData.h"',
+        "",
+        "struct AssetRaster {",
+        "    const char* name;",
+        "    const PaletteImage* image;",
+        "    const char* const* rows;",
+        "};",
+    ]
+    for name, w, h, data, px in images:
+        out.append("")
+        out.append("static const char* const %s_ROWS[%d] = {" % (name, h))
+        for row in px:
+            out.append('    "%s",' % "".join("%X" % p for p in row))
+        out.append("};")
+    out.append("")
+    out.append("static const AssetRaster ASSET_RASTERS[] = {")
+    for name, w, h, data, px in images:
+        out.append('    { "%s", &ASSET_%s, %s_ROWS },' % (name, name, name))
+    out.append("};")
+    out.append("")
+    out.append("#endif // ASSET_RASTER_H")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    images = build()
+    header, source = render(images)
+    raster = render_raster(images)
+    outputs = ((OUT_H, header), (OUT_CPP, source), (OUT_RASTER, raster))
+
+    if "--check" in sys.argv[1:]:
+        for path, text in outputs:
+            with open(path) as f:
+                if f.read() != text:
+                    sys.exit("%s is stale: run tools/gen_assets.py" % os.path.relpath(path, ROOT))
+        print("%d assets round-trip pixel-exact, generated files current" % len(images))
+        return
+
+    for path, text in outputs:
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        with open(path, "w") as f:
+            f.write(text)
+    for name, w, h, data, _ in images:
+        print("%-16s %3dx%-3d %5d bytes" % (name, w, h, len(data)))
+
+
+if __name__ == "__main__":
+    main()
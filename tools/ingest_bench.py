@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Check that the controller keeps up with a packet burst at wire speed.
+
+Writes COUNT chat packets back to back to the controller's serial port, the
+way the LoRa MCU flushes its backlog after a reconnect, then asks for a
+DIAG dump and prints the ingest line:
+
+    [INFO] PERF ingest batches=.. max_batch=.. backlog=<lines> lines in <ms>ms
+
+backlog is the largest run of batches that ended with an empty RX buffer
+since the counters were last reset (Diagnostics, key C), so reset them first
+for a clean number. This is not the time to drain COUNT queued packets: at
+115200 baud the wire needs about 5.8 ms per 67-byte packet, and the 4 KB RX
+buffer (SerialIngest::UART_RX_BUFFER) holds only about 60 of them, so the
+packets arrive as fast as the wire allows and the drain time follows the
+send time. A drain time close to the printed send time, with no RX
+overflow, means the device keeps up with the link; compare batches against
+backlog to see how many packets each loop() handled. The drain time for a
+fully queued backlog comes from the native suite, which pre-loads the lines
+and runs SerialIngest::listen() on the host:
+
+    pio test -e native -f test_ingest
+
+The DIAG request needs firmware built with -DENABLE_TEST_HOOKS
+(platformio.ini); the burst itself works on any build.
+
+Usage:
+    python3 tools/ingest_bench.py --port /dev/ttyUSB0 [--count 500]
+    python3 tools/ingest_bench.py --dry-run > backlog.txt
+"""
+
+import argparse
+import sys
+import time
+
+BAUD = 115200
+
+
+def packets(count, channel, senders):
+    # channel||message_id||sender||text||time; legacy (non-base32) IDs are fine
+    for i in range(count):
+        yield "%s||bench%06d||bench%02d||Backlog message %d of %d||12:%02d:%02d\n" % (
+            channel, i, i % senders, i + 1, count, (i // 60) % 60, i % 60)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--port", help="controller serial port")
+    ap.add_argument("--count", type=int, default=500, help="packets in the burst (default 500)")
+    ap.add_argument("--channel", default="123123", help="subscribed channel ID (default Broadcast)")
+    ap.add_argument("--senders", type=int, default=8, help="distinct sender IDs (default 8)")
+    ap.add_argument("--dry-run", action="store_true", help="print the burst instead of sending it")
+    args = ap.parse_args()
+
+    burst = "".join(packets(args.count, args.channel, args.senders)).encode()
+    if args.dry_run:
+        sys.stdout.write(burst.decode())
+        return
+    if not args.port:
+        ap.error("--port is required unless --dry-run")
+
+    import serial  # pyserial; only needed when talking to a device
+
+    with serial.Serial(args.port, BAUD, timeout=0.5) as port:
+        port.reset_input_buffer()
+        start = time.monotonic()
+        port.write(burst)
+        port.flush()
+        wire = time.monotonic() - start
+        print("sent %d packets, %d bytes in %.0f ms" % (args.count, len(burst), wire * 1000))
+
+        time.sleep(1.0)  # Let the last batches drain before asking
+        port.write(b"DIAG\n")
+        deadline = time.monotonic() + 5
+        while time.monotonic() < deadline:
+            line = port.readline().decode(errors="replace").strip()
+            if "PERF ingest" in line or "PERF serial_rx" in line:
+                print(line)
+            if "PERF ingest" in line:
+                return
+    sys.exit("no PERF ingest line received (built with -DENABLE_TEST_HOOKS?)")
+
+
+if __name__ == "__main__":
+    main()
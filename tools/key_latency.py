@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Replay scripted key sequences on the controller and print input latency.
+
+Each script is sent as `KEYS||<keys>`; the controller plays it through the
+real KeypadHandler (one press/release every 60 ms) and times every key from
+its injection to the end of the frame that shows it. Afterwards a DIAG dump
+is requested and the per-stage histograms are printed:
+
+    [INFO] KEYLAT handle|queue|draw|key_pixel n= avg= p90<= max= hist=...
+
+hist is the log2 histogram: bucket i counts samples in [2^i, 2^(i+1)) us.
+Keys are keypad labels as in KeypadHandler.h: in the chat, letters type with
+multi-tap (`aa` is "b"), `#` toggles letters/digits, `C` deletes and `H`
+sends. Open a chat on the device first; reset the counters (Diagnostics,
+key C) for a clean run. Trailing spaces are trimmed by the serial reader.
+
+The firmware must be built with -DENABLE_TEST_HOOKS (platformio.ini);
+without it KEYS|| and DIAG lines are ignored.
+
+Usage:
+    python3 tools/key_latency.py --port /dev/ttyUSB0 [--script "adg jmp" ...]
+"""
+
+import argparse
+import sys
+import time
+
+BAUD = 115200
+GAP_S = 0.060          # KeypadHandler::REPLAY_GAP_MS
+MAX_KEYS = 64          # KeypadHandler::REPLAY_MAX
+
+DEFAULT_SCRIPTS = [
+    "adgjmpsvy",       # Nine new letters: one draft repaint each
+    "aaadddggg",       # Multi-tap on one key: the draft's last letter changes
+    "#123456789#",     # Digits typed in numeric mode
+    "CCCCCCCCC",       # Deletes
+]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--port", required=True, help="controller serial port")
+    ap.add_argument("--script", action="append",
+                    help="key sequence to replay (repeatable; default: a typing mix)")
+    args = ap.parse_args()
+    scripts = args.script or DEFAULT_SCRIPTS
+
+    import serial  # pyserial
+
+    with serial.Serial(args.port, BAUD, timeout=0.5) as port:
+        for keys in scripts:
+            if len(keys) > MAX_KEYS:
+                sys.exit("script longer than %d keys: %s" % (MAX_KEYS, keys))
+            port.write(("KEYS||%s\n" % keys).encode())
+            # Past the last key and the multi-tap timeout
+            time.sleep(len(keys) * GAP_S + 0.5)
+            print("replayed %r" % keys)
+
+        port.reset_input_buffer()
+        port.write(b"DIAG\n")
+        seen = 0
+        deadline = time.monotonic() + 5
+        while time.monotonic() < deadline and seen < 4:
+            line = port.readline().decode(errors="replace").strip()
+            if "KEYLAT" in line:
+                print(line)
+                seen += 1
+    if seen < 4:
+        sys.exit("KEYLAT lines missing from the DIAG dump (built with -DENABLE_TEST_HOOKS?)")
+
+
+if __name__ == "__main__":
+    main()